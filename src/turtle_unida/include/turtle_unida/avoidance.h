@@ -0,0 +1,188 @@
+#ifndef TURTLE_UNIDA_AVOIDANCE_H
+#define TURTLE_UNIDA_AVOIDANCE_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "turtle_unida/executor.h"
+#include "turtle_unida/pose.h"
+
+namespace turtle_unida
+{
+
+struct AvoidanceConfig
+{
+    AvoidanceConfig();
+
+    double radius;             // radio de cada tortuga (m)
+    double neighbor_distance;  // solo se evitan los vecinos a menos de esta distancia (m)
+    int max_neighbors;         // vecinos más cercanos que se tienen en cuenta
+    double time_horizon;       // las colisiones más lejanas en el tiempo se ignoran (s)
+    double max_linear;         // velocidad lineal máxima que puede elegir (m/s)
+    double max_angular;        // velocidad angular máxima al corregir el rumbo (rad/s)
+    double heading_gain;       // rad/s de corrección por radián de error de rumbo
+    double dt;                 // periodo de los comandos (s)
+    int threads;               // hilos para resolver las tortugas; 0 = uno por núcleo
+};
+
+// Estadísticas acumuladas; los tiempos son del último ciclo
+struct AvoidanceStats
+{
+    AvoidanceStats();
+
+    std::uint64_t ticks;
+    std::uint64_t agents;     // tortugas con pose conocida en el último ciclo
+    std::uint64_t moved;      // cambios de celda de la rejilla en total
+    std::uint64_t neighbors;  // vecinos considerados en total
+    std::uint64_t adjusted;   // comandos modificados en total
+    std::uint64_t fallback;   // casos sin velocidad segura (se elige la menos mala)
+    double update_time;       // actualización de la rejilla (s)
+    double solve_time;        // resolución de todas las tortugas (s)
+
+    std::string summary() const;
+};
+
+// Rejilla uniforme de celdas de lado `cell` guardada en una tabla hash, así
+// que el mundo no necesita límites. Cada agente recuerda su
+// cubeta y su posición dentro de ella: moverlo de celda es quitarlo con un
+// intercambio con el último y añadirlo a la nueva, O(1), y los agentes que no
+// cambian de celda no tocan la tabla.
+class SpatialHash
+{
+public:
+    SpatialHash(double cell, std::size_t buckets);
+
+    // Coloca el agente (los índices nuevos se añaden); devuelve true si ha
+    // cambiado de celda. La tabla dobla su tamaño cuando hay más agentes que cubetas.
+    bool update(std::size_t agent, double x, double y);
+
+    // Quita el agente de la rejilla
+    void remove(std::size_t agent);
+
+    // Llama a visit(agente) con cada agente de las celdas que tocan el
+    // cuadrado de lado 2 * range alrededor de (x, y); puede incluir agentes
+    // más lejanos que compartan cubeta
+    template <class Visit>
+    void query(double x, double y, double range, const Visit& visit) const
+    {
+        const std::int64_t x0 = cellOf(x - range);
+        const std::int64_t x1 = cellOf(x + range);
+        const std::int64_t y0 = cellOf(y - range);
+        const std::int64_t y1 = cellOf(y + range);
+        for (std::int64_t cy = y0; cy <= y1; ++cy)
+        {
+            for (std::int64_t cx = x0; cx <= x1; ++cx)
+            {
+                const std::vector<std::uint32_t>& bucket = buckets_[bucketOf(cx, cy)];
+                for (std::size_t k = 0; k < bucket.size(); ++k)
+                {
+                    visit(bucket[k]);
+                }
+            }
+        }
+    }
+
+    double cell() const { return cell_; }
+
+private:
+    static const std::uint32_t NONE = 0xffffffffu;
+
+    void insert(std::size_t agent);
+    void rehash(std::size_t buckets);
+
+    std::int64_t cellOf(double v) const { return static_cast<std::int64_t>(std::floor(v / cell_)); }
+    std::size_t bucketOf(std::int64_t cx, std::int64_t cy) const
+    {
+        const std::uint64_t h = static_cast<std::uint64_t>(cx) * 0x9e3779b97f4a7c15ull ^
+            static_cast<std::uint64_t>(cy) * 0xc2b2ae3d27d4eb4full;
+        return static_cast<std::size_t>((h ^ (h >> 29)) & mask_);
+    }
+
+    double cell_;
+    std::uint64_t mask_;
+    std::vector<std::vector<std::uint32_t> > buckets_;
+    std::size_t placed_;  // agentes en la tabla
+
+    // Por agente: celda actual, cubeta y posición dentro de ella
+    std::vector<std::int64_t> cell_x_;
+    std::vector<std::int64_t> cell_y_;
+    std::vector<std::uint32_t> bucket_;
+    std::vector<std::uint32_t> slot_;
+};
+
+// Evitación recíproca de colisiones (ORCA, "optimal reciprocal collision
+// avoidance") entre muchas tortugas. Cada tortuga convierte su comando
+// (linear, angular) en una velocidad preferida en el plano; cada vecino
+// cercano aporta un semiplano de velocidades que no chocan en time_horizon
+// suponiendo que los dos se apartan a medias, y un programa lineal en 2D
+// elige la velocidad más parecida a la preferida dentro de todos ellos. La
+// velocidad elegida se vuelve a convertir en un comando de uniciclo:
+// avance en la dirección actual y giro hacia la nueva.
+//
+// Los vecinos salen de una SpatialHash que se actualiza en cada ciclo solo
+// para las tortugas que cambian de celda. Cada tortuga se resuelve con la
+// foto de posiciones y velocidades del principio del ciclo, así que se
+// reparten entre hilos sin sincronización, en bloques de tortugas seguidas
+// que los hilos se roban entre sí (el coste depende de los vecinos). Los
+// hilos son de un ejecutor propio que se crea la primera vez que hay más de
+// un bloque y se reutiliza en los ciclos siguientes.
+class CollisionAvoidance
+{
+public:
+    // Lanza std::invalid_argument si la configuración no es válida
+    explicit CollisionAvoidance(const AvoidanceConfig& config = AvoidanceConfig());
+
+    // Añade una tortuga (sin pose todavía: no se mueve ni se evita) y devuelve su índice
+    std::size_t add();
+
+    // Última pose conocida de la tortuga (p. ej. de /turtleN/pose)
+    void setPose(std::size_t agent, const Pose& pose);
+
+    // Ajusta los comandos de todas las tortugas; linear y angular tienen size() elementos
+    void apply(double* linear, double* angular);
+
+    // Vecinos considerados para la tortuga, del más cercano al más lejano
+    void neighbors(std::size_t agent, std::vector<std::uint32_t>& result) const;
+
+    std::size_t size() const { return x_.size(); }
+    const AvoidanceConfig& config() const { return config_; }
+    const AvoidanceStats& stats() const { return stats_; }
+
+private:
+    void findNeighbors(std::size_t agent, std::vector<std::uint32_t>& result, std::vector<double>& distances) const;
+
+    // Totales de un bloque, cada uno en su propia línea de caché
+    struct BlockCounts
+    {
+        std::uint64_t neighbors;
+        std::uint64_t adjusted;
+        std::uint64_t fallback;
+        char padding[64 - 3 * sizeof(std::uint64_t)];
+    };
+
+    // Resuelve las tortugas [first, last) y devuelve sus totales
+    BlockCounts solve(std::size_t first, std::size_t last, double* linear, double* angular) const;
+
+    AvoidanceConfig config_;
+    SpatialHash grid_;
+    AvoidanceStats stats_;
+    std::unique_ptr<WorkStealingExecutor> executor_;
+    std::vector<BlockCounts> blocks_;  // del último ciclo
+
+    // Estado por tortuga, una columna por campo
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<double> theta_;
+    std::vector<double> vx_;  // velocidad actual en el plano
+    std::vector<double> vy_;
+    std::vector<std::uint8_t> known_;  // ha llegado al menos una pose
+    std::vector<std::uint8_t> dirty_;  // pose nueva desde el último ciclo
+};
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_AVOIDANCE_H
@@ -0,0 +1,160 @@
+#ifndef TURTLE_UNIDA_COMMAND_LOG_H
+#define TURTLE_UNIDA_COMMAND_LOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "turtle_unida/pose.h"
+#include "turtle_unida/transport.h"
+#include "turtle_unida/twist.h"
+
+namespace turtle_unida
+{
+
+struct LogHeader;
+
+// Tipo de cada registro del log
+enum LogKind
+{
+    LOG_TWIST = 1,  // comando publicado (linear xyz, angular xyz)
+    LOG_POSE = 2    // pose recibida (x, y, theta, lineal, angular)
+};
+
+// Registro de tamaño fijo (64 bytes, una línea de caché)
+struct LogRecord
+{
+    std::uint64_t time;     // ns desde el inicio de la grabación (reloj monotónico)
+    std::uint32_t kind;     // LogKind
+    std::uint32_t topic;    // índice en la tabla de topics del log
+    double values[6];
+};
+
+// Formato del fichero (little-endian, todo alineado a página):
+//
+//   cabecera (4 KiB) | tabla de topics (64 bytes por topic) | registros | índice
+//
+// Cada entrada de la tabla de topics es el nombre (63 bytes como mucho) y un
+// byte con un bit 1 << LogKind por cada tipo de registro grabado en el topic,
+// para saber qué topics llevan comandos sin recorrer los registros.
+//
+// Los registros van en orden de tiempo. El índice se escribe al cerrar: la
+// marca de tiempo de uno de cada INDEX_STRIDE registros, así que buscar un
+// instante es una búsqueda binaria en el índice y otra en un bloque. Si la
+// grabación se corta sin cerrar, la cabecera sigue contando los registros
+// completos y la búsqueda se hace directamente sobre ellos (también O(log n)).
+class CommandLogWriter
+{
+public:
+    static const std::uint32_t INDEX_STRIDE = 4096;
+
+    // Crea el fichero con espacio para max_topics topics. Lanza std::runtime_error.
+    explicit CommandLogWriter(const std::string& path, std::uint32_t max_topics = 1024);
+    ~CommandLogWriter();
+
+    // Registra un topic y devuelve su índice; lanza std::length_error si no caben más
+    std::uint32_t addTopic(const std::string& topic);
+
+    // Añade un registro: una copia en memoria mapeada, sin llamadas al
+    // sistema salvo cuando hay que ampliar el fichero (cada 64 MiB)
+    void append(LogKind kind, std::uint32_t topic, const Twist& twist);
+    void append(LogKind kind, std::uint32_t topic, const Pose& pose);
+
+    // Escribe el índice y ajusta el tamaño del fichero; el destructor lo llama
+    void close();
+
+    std::uint64_t records() const { return records_; }
+    const std::string& path() const { return path_; }
+
+private:
+    CommandLogWriter(const CommandLogWriter&);
+    CommandLogWriter& operator=(const CommandLogWriter&);
+
+    LogRecord* reserve();
+    void mapChunk(std::uint64_t record);
+    void markKind(std::uint32_t topic, LogKind kind);
+
+    std::string path_;
+    int fd_;
+    LogHeader* header_;         // primera página, mapeada todo el tiempo
+    char* topics_;              // tabla de topics, mapeada todo el tiempo
+    std::size_t prefix_bytes_;  // cabecera + tabla de topics
+    std::uint64_t start_;       // monotonicNanos() al crear el log
+    std::uint64_t records_;
+    std::vector<std::uint64_t> index_;  // se escribe al final del fichero en close()
+
+    // Ventana mapeada de registros [chunk_first_, chunk_first_ + chunk_records_)
+    LogRecord* chunk_;
+    std::uint64_t chunk_first_;
+    std::uint64_t chunk_records_;
+};
+
+// Lectura de un log completo mapeado en memoria: abrir no lee los registros
+// y seek() solo toca O(log n) páginas
+class CommandLogReader
+{
+public:
+    // Lanza std::runtime_error si el fichero no es un log válido
+    explicit CommandLogReader(const std::string& path);
+    ~CommandLogReader();
+
+    std::uint64_t size() const { return records_; }
+    const LogRecord& record(std::uint64_t index) const { return records_base_[index]; }
+
+    // Primer registro con time >= time (ns); size() si no hay ninguno
+    std::uint64_t seek(std::uint64_t time) const;
+
+    std::size_t topicCount() const { return topics_.size(); }
+    const std::string& topic(std::uint32_t index) const { return topics_[index]; }
+
+    // Tipos de registro de cada topic; los logs de la versión 1 no los
+    // guardan (topicKindsKnown() false) y topicHasKind() siempre es false
+    bool topicKindsKnown() const;
+    bool topicHasKind(std::uint32_t index, LogKind kind) const;
+
+    std::uint64_t startTime() const;      // ns del reloj monotónico al empezar a grabar
+    std::uint64_t startWallTime() const;  // ns desde 1970 al empezar a grabar
+    std::uint64_t duration() const { return records_ ? record(records_ - 1).time : 0; }
+    bool indexed() const { return index_ != nullptr; }
+
+private:
+    CommandLogReader(const CommandLogReader&);
+    CommandLogReader& operator=(const CommandLogReader&);
+
+    const char* data_;
+    std::size_t bytes_;
+    const LogHeader* header_;
+    const LogRecord* records_base_;
+    std::uint64_t records_;
+    const std::uint64_t* index_;  // marca de tiempo de cada INDEX_STRIDE registros
+    std::uint64_t index_entries_;
+    std::vector<std::string> topics_;
+    std::vector<unsigned char> topic_kinds_;  // bits 1 << LogKind de cada topic
+};
+
+// Conversión de los valores de un registro
+Twist twistFromLog(const LogRecord& record);
+Pose poseFromLog(const LogRecord& record);
+
+// Transporte que graba todo lo que pasa por otro: cada comando publicado y
+// cada pose recibida se añaden al log antes de seguir su camino
+class RecordingTransport : public Transport
+{
+public:
+    RecordingTransport(Transport& inner, CommandLogWriter& log);
+
+    Channel advertise(const std::string& topic) override;
+    void publish(Channel channel, const Twist& twist) override;
+    void flush() override;
+    void subscribe(const std::string& topic, const PoseCallback& callback) override;
+
+private:
+    Transport& inner_;
+    CommandLogWriter& log_;
+    std::vector<std::uint32_t> topics_;  // topic del log de cada canal
+};
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_COMMAND_LOG_H
@@ -0,0 +1,104 @@
+#ifndef TURTLE_UNIDA_COMMANDER_H
+#define TURTLE_UNIDA_COMMANDER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "turtle_unida/rcu.h"
+#include "turtle_unida/scheduler.h"
+#include "turtle_unida/trajectory.h"
+#include "turtle_unida/transport.h"
+#include "turtle_unida/twist.h"
+
+namespace turtle_unida
+{
+
+// Parámetros del commander; los valores por defecto son los de mover.py
+struct CommanderConfig
+{
+    CommanderConfig();
+
+    std::string topic;            // topic de salida
+    TrajectoryParams trajectory;  // por defecto el círculo de mover.py (2.0, 1.5)
+    bool stamp;                   // añade marcas de latencia a cada comando (latency.h)
+    bool pipeline;                // planifica en otro hilo y publica desde un LatestSlot
+};
+
+// Estadísticas de publicación; las del bucle están en PeriodicScheduler::stats()
+struct CommanderStats
+{
+    CommanderStats();
+
+    std::uint64_t ticks;       // comandos publicados
+
+    // Solo en modo pipeline
+    std::uint64_t planned;     // consignas calculadas por el planificador
+    std::uint64_t dropped;     // consignas sustituidas por otra más nueva antes de publicarse
+    std::uint64_t stale;       // ciclos de publicación sin consigna nueva (se repite la anterior)
+
+    std::string summary() const;
+};
+
+// Consigna que pasa del hilo que planifica al que publica
+struct Setpoint
+{
+    double time;  // instante para el que se calculó (s)
+    Twist twist;
+};
+
+// Genera y publica comandos de velocidad a frecuencia fija (1 kHz o más).
+// Con `pipeline` la generación pasa a un hilo propio con su planificador y
+// deja cada consigna en un LatestSlot; el bucle de publicación toma en cada
+// ciclo la más reciente, así que un paso de planificación lento no retrasa
+// ninguna publicación. Si el bucle de publicación se retrasa, cada consigna
+// nueva sustituye a la que no ha llegado a leer (gana la última) y el
+// planificador nunca espera.
+//
+// La trayectoria se puede cambiar en marcha con setTrajectory() desde otro
+// hilo: la tabla nueva se construye fuera del bucle y se publica en una
+// RcuCell, que el bucle lee sin cerrojos y libera en su estado de reposo
+// (después de cada comando).
+class Commander
+{
+public:
+    // Precalcula la tabla de la trayectoria; lanza std::invalid_argument si no es válida
+    Commander(Transport& transport, const CommanderConfig& config);
+
+    // Comando a enviar en el instante t (segundos desde el inicio). Desde el
+    // hilo del bucle, o desde cualquiera si no se usa setTrajectory()
+    Twist command(double t) const;
+
+    // Sustituye la trayectoria sin parar el bucle; se puede llamar desde
+    // cualquier hilo. Lanza std::invalid_argument si no es válida y entonces
+    // se sigue con la anterior.
+    void setTrajectory(const TrajectoryParams& params);
+
+    // Genera y publica el comando del instante t
+    void step(double t);
+
+    // Publica un comando en cada ciclo del planificador mientras ok() devuelva true
+    void run(PeriodicScheduler& scheduler, const std::function<bool()>& ok);
+
+    // config().trajectory es la trayectoria inicial
+    const CommanderConfig& config() const { return config_; }
+    const Trajectory& trajectory() const { return trajectory_.read(); }
+    const CommanderStats& stats() const { return stats_; }
+
+    // Trayectorias sustituidas con setTrajectory()
+    std::uint64_t reloads() const { return trajectory_.version(); }
+
+private:
+    void runPipeline(PeriodicScheduler& scheduler, const std::function<bool()>& ok);
+
+    Transport& transport_;
+    CommanderConfig config_;
+    RcuCell<Trajectory> trajectory_;
+    Transport::Channel channel_;
+    CommanderStats stats_;
+};
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_COMMANDER_H
@@ -0,0 +1,44 @@
+#ifndef TURTLE_UNIDA_CONFIG_FILE_H
+#define TURTLE_UNIDA_CONFIG_FILE_H
+
+#include <cstdint>
+#include <string>
+
+#include "turtle_unida/trajectory.h"
+
+namespace turtle_unida
+{
+
+// Lee la trayectoria de un fichero "clave: valor" con los mismos nombres
+// que los parámetros del nodo (trajectory, linear_x, angular_z, size,
+// period, growth, duration, points, segments, table_dt): el subconjunto de
+// YAML que escribe `rosparam dump` para escalares y listas ([1, 2, 3]). Las
+// claves que no aparecen conservan su valor. Lanza std::runtime_error si no
+// se puede leer, hay una clave desconocida o un valor no es válido.
+void readTrajectoryFile(const std::string& path, TrajectoryParams& params);
+
+// Detecta cambios en un fichero por su fecha de modificación, tamaño e
+// inodo (los editores que guardan con un fichero nuevo y un rename cambian
+// el inodo aunque la fecha coincida). Solo hace un stat() por consulta.
+class FileWatcher
+{
+public:
+    explicit FileWatcher(const std::string& path);
+
+    // true si el fichero existe y ha cambiado desde la última llamada (la
+    // primera vez, si existe)
+    bool changed();
+
+    const std::string& path() const { return path_; }
+
+private:
+    std::string path_;
+    bool seen_;
+    std::int64_t mtime_;  // ns
+    std::int64_t size_;
+    std::uint64_t inode_;
+};
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_CONFIG_FILE_H
@@ -0,0 +1,219 @@
+#ifndef TURTLE_UNIDA_CONTROLLER_H
+#define TURTLE_UNIDA_CONTROLLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "turtle_unida/executor.h"
+#include "turtle_unida/path_index.h"
+#include "turtle_unida/pose.h"
+#include "turtle_unida/scheduler.h"
+#include "turtle_unida/transport.h"
+#include "turtle_unida/twist.h"
+
+namespace turtle_unida
+{
+
+// Ganancias y límites comunes a los controladores
+struct ControllerGains
+{
+    ControllerGains();
+
+    double k_linear;     // ganancia de distancia
+    double k_angular;    // ganancia de error de orientación
+    double max_linear;   // velocidad lineal máxima
+    double max_angular;  // velocidad angular máxima
+    double tolerance;    // distancia a la que se considera alcanzado el objetivo (m)
+};
+
+// Controlador en lazo cerrado: calcula un Twist correctivo a partir de la pose
+class Controller
+{
+public:
+    virtual ~Controller() {}
+
+    virtual Twist update(const Pose& pose) = 0;
+
+    // true cuando el objetivo se ha alcanzado
+    virtual bool done() const { return false; }
+};
+
+// Va hasta un punto: gira hacia el objetivo y avanza más despacio cuanto
+// peor alineada está la tortuga
+class GoToGoalController : public Controller
+{
+public:
+    GoToGoalController(double goal_x, double goal_y, const ControllerGains& gains);
+
+    Twist update(const Pose& pose) override;
+    bool done() const override { return done_; }
+
+private:
+    double goal_x_;
+    double goal_y_;
+    ControllerGains gains_;
+    bool done_;
+};
+
+// Mantiene una orientación fija a velocidad constante
+class HeadingHoldController : public Controller
+{
+public:
+    HeadingHoldController(double heading, double speed, const ControllerGains& gains);
+
+    Twist update(const Pose& pose) override;
+
+private:
+    double heading_;
+    double speed_;
+    ControllerGains gains_;
+};
+
+// Persecución pura sobre una polilínea de puntos (x0, y0, x1, y1, ...). Las
+// consultas van al índice espacial del camino, así que cada ciclo cuesta lo
+// mismo con diez puntos que con millones. El avance por el camino se recuerda
+// entre ciclos y el punto más cercano solo se busca en una ventana alrededor.
+class PurePursuitController : public Controller
+{
+public:
+    // Longitud de la ventana de búsqueda por delante del avance, en distancias de anticipación
+    static const int SEARCH_WINDOW = 8;
+
+    PurePursuitController(const std::vector<double>& points, double lookahead, double speed,
+        const ControllerGains& gains);
+
+    Twist update(const Pose& pose) override;
+    bool done() const override { return done_; }
+
+    // Vuelve a empezar el camino desde el principio
+    void reset() { progress_ = 0.0; done_ = false; }
+
+    const PathIndex& path() const { return path_; }
+    double progress() const { return progress_; }
+
+private:
+    PathIndex path_;
+    double lookahead_;
+    double speed_;
+    ControllerGains gains_;
+    double progress_;  // longitud de arco del último punto más cercano (m)
+    bool done_;
+};
+
+// Descripción de un controlador, tal como llega de los parámetros del nodo
+struct ControllerParams
+{
+    ControllerParams();
+
+    std::string type;           // go_to_goal, heading_hold o pure_pursuit
+    double goal_x;              // objetivo de go_to_goal
+    double goal_y;
+    double heading;             // orientación de heading_hold (rad)
+    double speed;               // velocidad lineal de heading_hold y pure_pursuit
+    double lookahead;           // distancia de anticipación de pure_pursuit (m)
+    std::vector<double> points; // camino de pure_pursuit
+    std::string path_file;      // o fichero con el camino (ver loadPath)
+    ControllerGains gains;
+};
+
+// Construye el controlador; lanza std::invalid_argument si la descripción no es válida
+// y std::runtime_error si no se puede leer path_file
+std::unique_ptr<Controller> makeController(const ControllerParams& params);
+
+// Estadísticas del lazo de realimentación
+struct FeedbackStats
+{
+    FeedbackStats();
+
+    std::uint64_t updates;      // poses procesadas
+    std::uint64_t over_budget;  // poses cuyo comando salió fuera del presupuesto
+    double sum_latency;         // suma de latencias pose -> publicación (s)
+    double max_latency;         // latencia máxima (s)
+
+    double meanLatency() const { return updates ? sum_latency / updates : 0.0; }
+};
+
+// Lazo dirigido por eventos: cada pose recibida se convierte en un comando
+// que se publica dentro del mismo callback, sin esperar a un periodo fijo.
+// La latencia entre la llegada de la pose y la publicación se mide y se
+// compara con el presupuesto configurado. Los callbacks deben llegar desde
+// un único hilo.
+class FeedbackLoop
+{
+public:
+    FeedbackLoop(Transport& transport, Controller& controller, const std::string& pose_topic,
+        const std::string& cmd_topic, double latency_budget);
+
+    // received: llegada de la pose en ns de monotonicNanos()
+    void onPose(const Pose& pose, std::uint64_t received);
+
+    const FeedbackStats& stats() const { return stats_; }
+
+private:
+    Transport& transport_;
+    Controller& controller_;
+    Transport::Channel channel_;
+    double latency_budget_;
+    FeedbackStats stats_;
+};
+
+// Estadísticas de un grupo de controladores
+struct ControllerGroupStats
+{
+    ControllerGroupStats();
+
+    std::uint64_t ticks;      // ciclos ejecutados
+    std::uint64_t updates;    // llamadas a Controller::update en total
+    std::uint64_t published;  // comandos publicados en total
+    double max_tick_time;     // duración máxima de un ciclo completo (s)
+};
+
+// Un controlador por tortuga en un solo proceso, actualizados por ciclos.
+// Las poses se guardan al llegar; en cada tick() los controladores con pose
+// nueva se actualizan en paralelo en el ejecutor (el coste varía mucho de
+// una tortuga a otra, de ahí el robo de trabajo) y, tras la barrera, los
+// comandos se publican en orden desde el hilo que llama, porque los
+// transportes no son seguros entre hilos. Las tortugas sin pose todavía no
+// publican nada.
+class ControllerGroup
+{
+public:
+    ControllerGroup(Transport& transport, WorkStealingExecutor& executor);
+
+    // Añade una tortuga y devuelve su índice
+    std::size_t add(std::unique_ptr<Controller> controller, const std::string& pose_topic,
+        const std::string& cmd_topic);
+
+    // Actualiza los controladores con pose nueva y publica todos los comandos
+    void tick();
+
+    // Ejecuta tick() en cada ciclo del planificador mientras ok() devuelva true
+    void run(PeriodicScheduler& scheduler, const std::function<bool()>& ok);
+
+    std::size_t size() const { return controllers_.size(); }
+    const Twist& command(std::size_t turtle) const { return twists_[turtle]; }
+    const Controller& controller(std::size_t turtle) const { return *controllers_[turtle]; }
+    const ControllerGroupStats& stats() const { return stats_; }
+
+private:
+    Transport& transport_;
+    WorkStealingExecutor& executor_;
+    ControllerGroupStats stats_;
+
+    // Estado por tortuga, una columna por campo
+    std::vector<std::unique_ptr<Controller> > controllers_;
+    std::vector<Transport::Channel> channels_;
+    std::vector<Pose> poses_;
+    std::vector<Twist> twists_;
+    std::vector<std::uint8_t> fresh_;   // pose nueva desde el último ciclo
+    std::vector<std::uint8_t> active_;  // ha llegado al menos una pose
+    std::vector<std::uint32_t> pending_;  // tortugas a actualizar en este ciclo
+};
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_CONTROLLER_H
@@ -0,0 +1,143 @@
+#ifndef TURTLE_UNIDA_DRAWING_H
+#define TURTLE_UNIDA_DRAWING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "turtle_unida/simulator.h"
+#include "turtle_unida/twist.h"
+
+namespace turtle_unida
+{
+
+// Imagen en escala de grises, fila a fila desde arriba (0 = negro)
+struct Bitmap
+{
+    Bitmap();
+
+    int width;
+    int height;
+    std::vector<std::uint8_t> pixels;
+
+    std::uint8_t at(int x, int y) const { return pixels[static_cast<std::size_t>(y) * width + x]; }
+};
+
+// Lee una imagen PBM o PGM (P1, P2, P4, P5); lanza std::runtime_error si no puede
+Bitmap loadBitmap(const std::string& path);
+
+// Trazo continuo con el lápiz bajado, como polilínea (x0, y0, x1, y1, ...).
+// En un trazo cerrado el último punto vuelve al primero sin repetirlo.
+struct Stroke
+{
+    Stroke();
+
+    std::vector<double> points;
+    bool closed;
+
+    std::size_t size() const { return points.size() / 2; }
+};
+
+struct DrawingConfig
+{
+    DrawingConfig();
+
+    int threshold;       // los píxeles más oscuros que este valor son tinta (0-255)
+    double tolerance;    // error máximo al simplificar los contornos (píxeles)
+    double min_length;   // se descartan los contornos más cortos (píxeles)
+    int tiles;           // bandas de la imagen procesadas en paralelo; 0 = una por núcleo
+    int two_opt_window;  // trazos que se prueban a invertir tras cada uno al ordenar
+    double world_size;   // lado del mundo de turtlesim (m)
+    double margin;       // margen entre el dibujo y las paredes (m)
+    double max_linear;   // velocidad lineal máxima al dibujar (m/s)
+    double max_angular;  // velocidad angular máxima al girar (rad/s)
+    double dt;           // periodo de los comandos, el paso de turtlesim (s)
+};
+
+// Una orden para la tortuga: subir o bajar el lápiz (set_pen), saltar a un
+// punto (teleport_absolute) o publicar el mismo Twist durante `steps` periodos
+struct DrawCommand
+{
+    enum Kind
+    {
+        PEN,
+        TELEPORT,
+        TWIST
+    };
+
+    DrawCommand();
+
+    Kind kind;
+    bool pen_down;        // PEN
+    double x;             // TELEPORT: destino; TWIST: posición prevista al terminar (m)
+    double y;
+    double theta;         // TELEPORT
+    Twist twist;          // TWIST
+    std::uint32_t steps;  // TWIST: número de periodos dt
+};
+
+// Tiempos de cada fase en segundos, distancias en metros del mundo
+struct DrawingStats
+{
+    DrawingStats();
+
+    std::uint64_t contours;    // contornos encontrados en la imagen
+    std::uint64_t strokes;     // trazos tras descartar los cortos
+    std::uint64_t points_in;   // puntos antes de simplificar
+    std::uint64_t points_out;  // puntos después de simplificar
+    double travel_before;      // recorrido con el lápiz subido en el orden de la imagen
+    double travel_after;       // recorrido con el lápiz subido tras ordenar
+    double drawn;              // recorrido con el lápiz bajado
+    double draw_time;          // duración de los comandos (s)
+    int tiles;
+    double contour_time;
+    double simplify_time;
+    double order_time;
+    double emit_time;
+
+    std::string summary() const;
+};
+
+struct DrawingPlan
+{
+    std::vector<Stroke> strokes;  // en coordenadas del mundo y en el orden de dibujo
+    std::vector<DrawCommand> commands;
+    DrawingStats stats;
+};
+
+// Contornos cerrados de las zonas de tinta (marching squares sobre la imagen
+// umbralizada), en píxeles. La imagen se parte en `tiles` bandas que se
+// procesan en paralelo; los tramos que cruzan de una banda a otra se unen al final.
+std::vector<Stroke> extractContours(const Bitmap& bitmap, int threshold, int tiles);
+
+// Ramer-Douglas-Peucker: quita los puntos a menos de tolerance de la línea simplificada
+Stroke simplifyStroke(const Stroke& stroke, double tolerance);
+
+// Ordena los trazos para acortar el recorrido con el lápiz subido: vecino
+// más próximo (con una rejilla sobre los puntos) y después 2-opt sobre
+// ventanas de `window` trazos. Un trazo cerrado puede empezar en cualquier
+// punto y uno abierto por cualquiera de sus extremos. Devuelve el recorrido.
+double orderStrokes(std::vector<Stroke>& strokes, int window);
+
+// Recorrido con el lápiz subido entre trazos consecutivos
+double penUpTravel(const std::vector<Stroke>& strokes);
+
+// Órdenes para dibujar los trazos (ya en el mundo): saltos con el lápiz
+// subido y, en cada tramo, un giro y un avance a la velocidad máxima. Cada
+// movimiento dura un número entero de periodos dt con la velocidad ajustada
+// para acabar exactamente en el punto, como integra turtlesim.
+std::vector<DrawCommand> strokeCommands(const std::vector<Stroke>& strokes, const DrawingConfig& config);
+
+// Toda la cadena: contornos, simplificación (en paralelo), orden, escala al
+// mundo y órdenes. Lanza std::invalid_argument si la configuración no es válida.
+DrawingPlan planDrawing(const Bitmap& bitmap, const DrawingConfig& config);
+
+// Ejecuta las órdenes sobre una tortuga del simulador, un paso por periodo, y
+// devuelve la mayor distancia entre la tortuga y el punto previsto al final
+// de cada avance (m)
+double drawInSimulator(const std::vector<DrawCommand>& commands, Simulator& simulator, std::size_t turtle);
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_DRAWING_H
@@ -0,0 +1,114 @@
+#ifndef TURTLE_UNIDA_EXECUTOR_H
+#define TURTLE_UNIDA_EXECUTOR_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace turtle_unida
+{
+
+struct ExecutorConfig
+{
+    ExecutorConfig();
+
+    int threads;         // hilos, contando el que llama a run(); 0 = uno por núcleo
+    std::size_t grain;   // índices que toma un hilo de su tramo cada vez
+    bool deterministic;  // sin robos: cada índice lo procesa siempre el mismo hilo, en orden
+};
+
+// Estadísticas acumuladas de un hilo del ejecutor
+struct WorkerStats
+{
+    WorkerStats();
+
+    std::uint64_t tasks;        // índices procesados
+    std::uint64_t chunks;       // bloques de `grain` índices procesados
+    std::uint64_t steals;       // robos con éxito
+    std::uint64_t failed;       // intentos de robo sin trabajo disponible
+    double busy_time;           // tiempo dentro del trabajo (s)
+    double wait_time;           // tiempo parado en la barrera hasta que acaba el último hilo (s)
+
+    std::string summary() const;
+};
+
+// Ejecutor por ciclos con robo de trabajo. run(count, body) reparte los
+// índices [0, count) en un tramo seguido por hilo y no vuelve hasta que
+// todos están hechos (barrera del ciclo). Cada tramo es una sola palabra
+// atómica (inicio, fin): el dueño toma bloques del principio y, cuando el
+// suyo se acaba, un hilo roba la mitad final del tramo de otro con un CAS
+// sobre la misma palabra, así que no hay colas ni cerrojos en el camino del
+// trabajo. Los hilos duermen entre ciclos en una variable de condición.
+//
+// En modo determinista no hay robos: el reparto de los índices entre hilos
+// y su orden dentro de cada hilo son siempre los mismos, para las pruebas.
+class WorkStealingExecutor
+{
+public:
+    // Procesa los índices [first, last)
+    typedef std::function<void(std::size_t, std::size_t)> Body;
+
+    explicit WorkStealingExecutor(const ExecutorConfig& config = ExecutorConfig());
+    ~WorkStealingExecutor();
+
+    WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+    WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+    // Ejecuta body sobre [0, count) y espera a que acabe; si body lanza una
+    // excepción, se relanza aquí la primera después de la barrera
+    void run(std::size_t count, const Body& body);
+
+    int threads() const { return static_cast<int>(workers_.size()); }
+    const ExecutorConfig& config() const { return config_; }
+    std::uint64_t ticks() const { return ticks_; }
+    WorkerStats stats(int worker) const { return workers_[worker]->stats; }
+
+    // Totales y reparto entre hilos en una línea
+    std::string summary() const;
+
+private:
+    // Tramo y estadísticas de un hilo. Cada uno se reserva por separado y el
+    // relleno final evita que comparta línea de caché con el siguiente.
+    struct Worker
+    {
+        Worker();
+
+        std::atomic<std::uint64_t> range;  // inicio en los 32 bits altos, fin en los bajos
+        std::uint32_t seed;                // para elegir víctimas
+        std::chrono::steady_clock::time_point done;  // cuándo acabó su parte del ciclo
+        WorkerStats stats;
+        char padding[64];
+    };
+
+    void loop(int index);
+    void work(int index);
+    bool take(Worker& worker, std::size_t& first, std::size_t& last);
+    bool steal(int thief);
+
+    ExecutorConfig config_;
+    std::vector<std::unique_ptr<Worker> > workers_;  // el 0 es el hilo que llama a run()
+    std::vector<std::thread> threads_;
+    std::uint64_t ticks_;
+
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable finished_;
+    std::uint64_t generation_;
+    int pending_;  // hilos auxiliares que no han terminado el ciclo
+    bool stop_;
+    const Body* body_;
+    std::exception_ptr error_;
+};
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_EXECUTOR_H
@@ -0,0 +1,86 @@
+#ifndef TURTLE_UNIDA_FLEET_H
+#define TURTLE_UNIDA_FLEET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "turtle_unida/avoidance.h"
+#include "turtle_unida/scheduler.h"
+#include "turtle_unida/trajectory.h"
+#include "turtle_unida/transport.h"
+
+namespace turtle_unida
+{
+
+// Estadísticas de la flota; las del bucle están en PeriodicScheduler::stats()
+struct FleetStats
+{
+    FleetStats();
+
+    std::uint64_t ticks;      // ciclos ejecutados
+    std::uint64_t published;  // comandos publicados en total
+    double max_tick_time;     // duración máxima de un ciclo completo (s)
+};
+
+// Mueve muchas tortugas desde un solo proceso. El estado de cada tortuga se
+// guarda en columnas (structure of arrays) para que el ciclo recorra memoria
+// contigua: primero se evalúan todas las trayectorias y después se publican
+// todos los comandos en un único lote.
+class Fleet
+{
+public:
+    explicit Fleet(Transport& transport);
+
+    // Registra una trayectoria compartida por varias tortugas y devuelve su índice
+    std::size_t addTrajectory(const Trajectory& trajectory);
+
+    // Añade una tortuga que sigue la trayectoria indicada con un desfase en segundos
+    std::size_t addTurtle(const std::string& topic, std::size_t trajectory, double offset);
+
+    // Evalúa y publica los comandos de todas las tortugas en el instante t
+    void tick(double t);
+
+    // Activa la evitación de colisiones entre las tortugas de la flota: se
+    // suscribe a la pose de cada una ("/<nombre>/pose" junto a su cmd_vel) y
+    // en cada ciclo ajusta los comandos antes de publicarlos
+    void enableAvoidance(const AvoidanceConfig& config);
+
+    // Añade marcas de latencia a los comandos (una marca de generación por lote)
+    void setStamping(bool stamp) { stamp_ = stamp; }
+
+    // Ejecuta tick() en cada ciclo del planificador mientras ok() devuelva true
+    void run(PeriodicScheduler& scheduler, const std::function<bool()>& ok);
+
+    std::size_t size() const { return channel_.size(); }
+    double linear(std::size_t turtle) const { return linear_[turtle]; }
+    double angular(std::size_t turtle) const { return angular_[turtle]; }
+    const FleetStats& stats() const { return stats_; }
+
+    // nullptr si la evitación de colisiones no está activa
+    const CollisionAvoidance* avoidance() const { return avoidance_.get(); }
+
+private:
+    void watchPose(std::size_t turtle);
+
+    Transport& transport_;
+    std::vector<Trajectory> trajectories_;
+    FleetStats stats_;
+    bool stamp_;
+    std::unique_ptr<CollisionAvoidance> avoidance_;
+
+    // Estado por tortuga, una columna por campo
+    std::vector<std::uint32_t> trajectory_;
+    std::vector<double> offset_;
+    std::vector<Transport::Channel> channel_;
+    std::vector<std::string> topic_;
+    std::vector<double> linear_;
+    std::vector<double> angular_;
+};
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_FLEET_H
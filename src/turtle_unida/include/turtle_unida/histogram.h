@@ -0,0 +1,56 @@
+#ifndef TURTLE_UNIDA_HISTOGRAM_H
+#define TURTLE_UNIDA_HISTOGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace turtle_unida
+{
+
+// Histograma de duraciones en nanosegundos al estilo HDR: cada potencia de
+// dos se divide en 32 sub-cubos, así que el error relativo es como mucho un
+// 3 % en todo el rango. La memoria es fija y record() es O(1) y no reserva.
+class Histogram
+{
+public:
+    static const int SUB_BUCKET_BITS = 5;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const int MAX_VALUE_BITS = 40;  // hasta ~18 minutos en ns
+    static const int BUCKETS = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    Histogram();
+
+    void record(std::uint64_t value);
+
+    // Registra una duración en segundos (los valores negativos cuentan como 0)
+    void recordSeconds(double seconds);
+
+    void merge(const Histogram& other);
+    void reset();
+
+    std::uint64_t count() const { return count_; }
+    std::uint64_t min() const { return count_ ? min_ : 0; }
+    std::uint64_t max() const { return max_; }
+    double mean() const { return count_ ? static_cast<double>(sum_) / count_ : 0.0; }
+
+    // Valor por debajo del cual queda la fracción q (0..1) de las muestras
+    std::uint64_t percentile(double q) const;
+
+    // Resumen compacto en microsegundos: "n=.. p50=.. p99=.. p99.9=.. max=.."
+    std::string summary() const;
+
+private:
+    static std::size_t bucketOf(std::uint64_t value);
+    static std::uint64_t upperBound(std::size_t bucket);
+
+    std::uint64_t counts_[BUCKETS];
+    std::uint64_t count_;
+    std::uint64_t sum_;
+    std::uint64_t min_;
+    std::uint64_t max_;
+};
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_HISTOGRAM_H
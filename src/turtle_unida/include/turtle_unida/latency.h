@@ -0,0 +1,81 @@
+#ifndef TURTLE_UNIDA_LATENCY_H
+#define TURTLE_UNIDA_LATENCY_H
+
+#include <cstdint>
+#include <string>
+
+#include "turtle_unida/histogram.h"
+#include "turtle_unida/twist.h"
+
+namespace turtle_unida
+{
+
+// Nanosegundos del reloj monotónico del sistema (CLOCK_MONOTONIC en Linux).
+// Es el mismo para todos los procesos de la máquina, así que las marcas de
+// un emisor y de un receptor locales se pueden restar directamente.
+std::uint64_t monotonicNanos();
+
+// Marcas de un comando en ns de monotonicNanos(). Viajan dentro del propio
+// Twist en campos que turtlesim ignora (linear.z, angular.x, angular.y), así
+// que el mensaje no cambia de tipo ni de tamaño. Un double guarda los ns
+// exactos hasta 2^53 (unos 104 días desde el arranque de la máquina).
+struct CommandStamp
+{
+    CommandStamp();
+
+    std::uint64_t generated;  // el commander ha calculado el comando
+    std::uint64_t enqueued;   // entra en la cola hacia el transporte (el buzón del modo
+                              // pipeline o, si no hay, la entrada a Transport::publish)
+    std::uint64_t sent;       // el transporte lo entrega ya serializado a roscpp (o al receptor)
+};
+
+// Escriben cada marca con la hora actual
+void stampGenerated(Twist& twist);
+void stampEnqueued(Twist& twist);
+void stampSent(Twist& twist);
+
+// El comando lleva marcas si tiene al menos la de generación
+inline bool isStamped(const Twist& twist) { return twist.linear.z > 0.0; }
+
+// El comando ya tiene la marca de entrada en la cola
+inline bool isEnqueued(const Twist& twist) { return twist.angular.x > 0.0; }
+
+// Lee las marcas del Twist; devuelve false si el comando no lleva marcas
+bool readStamp(const Twist& twist, CommandStamp& stamp);
+
+// Histogramas de latencia del lado receptor. record() es O(1) y no reserva,
+// así que se puede llamar desde el callback de cada comando.
+class LatencyStats
+{
+public:
+    LatencyStats();
+
+    // Registra un comando con marcas recibido en el instante received
+    void record(const CommandStamp& stamp, std::uint64_t received);
+
+    // Cuenta un comando sin marcas
+    void recordUnstamped() { ++unstamped_; }
+
+    void reset();
+
+    const Histogram& endToEnd() const { return end_to_end_; }
+    const Histogram& queue() const { return queue_; }
+    const Histogram& send() const { return send_; }
+    const Histogram& wire() const { return wire_; }
+    std::uint64_t unstamped() const { return unstamped_; }
+
+    // Resumen de una línea con p50/p99/p99.9/max de cada tramo en microsegundos:
+    // "n=.. unstamped=.. e2e_us=../../../.. queue_us=.. send_us=.. wire_us=.."
+    std::string summary() const;
+
+private:
+    Histogram end_to_end_;  // generado -> recibido
+    Histogram queue_;       // generado -> aceptado por el transporte
+    Histogram send_;        // aceptado -> enviado
+    Histogram wire_;        // enviado -> recibido
+    std::uint64_t unstamped_;
+};
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_LATENCY_H
@@ -0,0 +1,70 @@
+#ifndef TURTLE_UNIDA_LATEST_SLOT_H
+#define TURTLE_UNIDA_LATEST_SLOT_H
+
+#include <atomic>
+
+namespace turtle_unida
+{
+
+// Buzón sin cerrojos de un solo valor entre exactamente un hilo productor y
+// un hilo consumidor, en el que siempre gana el último valor escrito (triple
+// buffer). El productor escribe en su hueco y lo intercambia con el del
+// medio; el consumidor intercambia el suyo con el del medio solo si hay un
+// valor nuevo. Ninguno de los dos espera al otro ni lee un hueco que el
+// otro esté escribiendo, y un valor sin leer se sustituye por el siguiente
+// en lugar de hacer esperar al productor.
+template <class T>
+class LatestSlot
+{
+public:
+    LatestSlot()
+        : back_(2), middle_(1), front_(0)
+    {
+    }
+
+    LatestSlot(const LatestSlot&) = delete;
+    LatestSlot& operator=(const LatestSlot&) = delete;
+
+    // Productor: true si el valor anterior no se había leído y se ha descartado
+    bool publish(const T& value)
+    {
+        slots_[back_] = value;
+        const unsigned previous = middle_.exchange(back_ | FRESH, std::memory_order_acq_rel);
+        back_ = previous & INDEX;
+        return (previous & FRESH) != 0;
+    }
+
+    // Consumidor: false si no hay un valor nuevo desde la última lectura
+    bool take(T& value)
+    {
+        if ((middle_.load(std::memory_order_relaxed) & FRESH) == 0)
+        {
+            return false;
+        }
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & INDEX;
+        value = slots_[front_];
+        return true;
+    }
+
+private:
+    static const unsigned INDEX = 3;
+    static const unsigned FRESH = 4;  // el hueco del medio tiene un valor sin leer
+
+    T slots_[3];
+    char padding0_[64];
+
+    // Solo lo escribe el productor
+    unsigned back_;
+    char padding1_[64];
+
+    std::atomic<unsigned> middle_;
+    char padding2_[64];
+
+    // Solo lo escribe el consumidor
+    unsigned front_;
+    char padding3_[64];
+};
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_LATEST_SLOT_H
@@ -0,0 +1,80 @@
+#ifndef TURTLE_UNIDA_LAUNCH_CACHE_H
+#define TURTLE_UNIDA_LAUNCH_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace turtle_unida
+{
+
+struct LaunchCacheStats
+{
+    LaunchCacheStats();
+
+    long hits;           // resueltos con un stat() del script, sin abrirlo
+    long misses;         // sin entrada o con el script cambiado: se lee el shebang
+    long invalidated;    // entradas descartadas porque su intérprete ya no arranca
+    long loaded;         // entradas leídas del fichero de la caché
+
+    std::string summary() const;
+};
+
+// Caché de la resolución del intérprete de cada script (getPythonExecutable),
+// indexada por la ruta del script y validada con su fecha de modificación,
+// tamaño e inodo. Con una entrada válida el arranque hace un solo stat() del
+// script: no lo abre, no lee el shebang ni comprueba el intérprete. Si se le
+// da un fichero, las entradas se cargan al construirla y se guardan con save()
+// para que las compartan los lanzadores de procesos distintos.
+//
+// No es segura entre hilos: cada lanzador tiene la suya.
+class LaunchCache
+{
+public:
+    // file vacío: solo en memoria
+    explicit LaunchCache(const std::string& file = std::string());
+
+    // Intérprete y argumentos del shebang de script, de la caché si el script
+    // no ha cambiado. cached dice si se ha resuelto sin leerlo. Las rutas
+    // relativas se guardan como absolutas.
+    std::vector<std::string> interpreter(const std::string& script, bool& cached);
+
+    // Olvida el script, p. ej. porque el intérprete guardado ya no existe
+    void invalidate(const std::string& script);
+
+    // Escribe el fichero (un rename atómico) si hay entradas nuevas. Devuelve
+    // false si no se ha podido; la caché sigue sirviendo en memoria.
+    bool save();
+
+    std::size_t size() const { return entries_.size(); }
+    const std::string& file() const { return file_; }
+    const LaunchCacheStats& stats() const { return stats_; }
+
+    // Fichero por defecto: $TURTLE_UNIDA_LAUNCH_CACHE_FILE si está definida,
+    // $XDG_CACHE_HOME/turtle_unida/launcher o ~/.cache/turtle_unida/launcher.
+    // Vacío si no hay ninguno.
+    static std::string defaultFile();
+
+private:
+    struct Entry
+    {
+        std::int64_t mtime;  // ns
+        std::int64_t size;
+        std::uint64_t inode;
+        std::vector<std::string> command;
+    };
+
+    void load();
+
+    std::string file_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::unordered_set<std::string> forgotten_;  // invalidadas: no se recuperan del fichero
+    bool dirty_;
+    LaunchCacheStats stats_;
+};
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_LAUNCH_CACHE_H
@@ -0,0 +1,115 @@
+#ifndef TURTLE_UNIDA_LAUNCHER_H
+#define TURTLE_UNIDA_LAUNCHER_H
+
+#include <csignal>
+#include <string>
+#include <vector>
+
+namespace turtle_unida
+{
+
+class LaunchCache;
+
+// Lanzador nativo de los nodos en Python para POSIX, el equivalente del
+// python_win32_wrapper.cpp que catkin genera en Windows (mover.cpp,
+// _setup_util.cpp): busca el script junto al ejecutable, saca el intérprete
+// de su shebang y lo arranca con posix_spawn, midiendo cada fase.
+
+// Tiempos de cada fase del arranque (s) y resultado del hijo
+struct LaunchTiming
+{
+    LaunchTiming();
+
+    double executable;   // ruta del propio lanzador
+    double script;       // ruta del script
+    double interpreter;  // lectura del shebang y comprobación del intérprete
+    double spawn;        // posix_spawn: hasta que el hijo ha hecho exec del intérprete
+    double run;          // desde el exec hasta que el hijo termina
+    int pid;
+    int exit_code;       // código de salida; 128 + señal si lo mató una señal
+    bool cached;         // intérprete sacado de la caché, sin leer el script
+    bool zygote;         // hijo del zigoto: spawn es hasta que el zigoto ha hecho fork
+    bool exec;           // el lanzador se sustituye por el intérprete: no hay spawn ni run
+
+    // Una línea JSON con el nombre del script y los tiempos en microsegundos
+    std::string json(const std::string& name) const;
+};
+
+// Ruta del ejecutable que se está ejecutando (GetCurrentModuleName). Si
+// argv0 lleva una barra se usa tal cual, sin resolver el último enlace
+// simbólico, para que un enlace "mover" junto a mover.py encuentre su
+// script; si no, /proc/self/exe. Lanza std::runtime_error si no se puede saber.
+std::string currentExecutable(const std::string& argv0);
+
+// Script que corresponde a un lanzador (FindPythonScript): el mismo nombre
+// con .py en el mismo directorio, /ruta/mover -> /ruta/mover.py
+std::string findPythonScript(const std::string& executable);
+
+// Intérprete y argumentos del shebang del script (GetPythonExecutable):
+// "#!/usr/bin/env python" -> {"/usr/bin/env", "python"}. Si no hay shebang
+// o el intérprete no existe o no es ejecutable se usa "python3" del PATH.
+std::vector<std::string> getPythonExecutable(const std::string& script);
+
+// Arranca argv[0] (buscándolo en el PATH si no lleva barra) con las
+// señales por defecto y devuelve su pid. Lanza std::runtime_error si no se
+// puede arrancar, incluido un exec fallido.
+int spawnProcess(const std::vector<std::string>& argv);
+
+// Sustituye el proceso por argv[0] (buscándolo en el PATH si no lleva barra)
+// con las señales por defecto. Solo vuelve, lanzando std::runtime_error, si
+// el exec falla.
+void execProcess(const std::vector<std::string>& argv);
+
+// Mientras existe reenvía a pid SIGINT, SIGTERM, SIGHUP y SIGQUIT recibidas
+// por el lanzador. Con only_sent solo las enviadas con kill() (p. ej. por
+// roslaunch), para un hijo del mismo grupo de procesos al que las del
+// terminal ya le llegan; sin él todas, para uno que no lo es. Solo puede
+// haber uno a la vez.
+class SignalForwarder
+{
+public:
+    SignalForwarder(int pid, bool only_sent);
+    ~SignalForwarder();
+
+private:
+    SignalForwarder(const SignalForwarder&);
+    SignalForwarder& operator=(const SignalForwarder&);
+
+    static const int SIGNALS = 4;
+    struct sigaction previous_[SIGNALS];
+};
+
+// Espera a que termine el hijo y devuelve su código de salida (128 + señal
+// si lo mató una señal), reenviándole mientras tanto las señales enviadas al
+// lanzador con kill().
+int waitProcess(int pid);
+
+// Ruta del script que se va a lanzar: script si no está vacío y, si no, el
+// que corresponde al propio lanzador (currentExecutable + findPythonScript).
+// Anota en timing el tiempo de cada paso.
+std::string scriptPath(const std::string& argv0, const std::string& script, LaunchTiming& timing);
+
+// Arranca el script path con el intérprete de su shebang (de la caché si la
+// hay; si el intérprete guardado ya no arranca se olvida y se vuelve a leer
+// el shebang) y devuelve el pid sin esperar. Anota interpreter y spawn.
+int spawnScript(const std::string& path, const std::vector<std::string>& args, LaunchTiming& timing,
+    LaunchCache* cache = nullptr);
+
+// Lanza script con sus argumentos y espera a que termine, midiendo cada fase.
+// Con cache el intérprete se resuelve con ella, como en spawnScript, y se
+// guarda mientras arranca el hijo.
+int launchScript(const std::string& argv0, const std::string& script, const std::vector<std::string>& args,
+    LaunchTiming& timing, LaunchCache* cache = nullptr);
+
+// Como launchScript, pero el lanzador se sustituye por el intérprete en vez
+// de esperar a un hijo: un proceso menos por nodo, y quien lo lanzó ve el pid
+// del script, le manda las señales directamente y recibe su código de salida.
+// Con print_timing escribe en stderr la línea JSON de los tiempos (sin spawn
+// ni run) justo antes del exec. Solo vuelve, lanzando std::runtime_error, si
+// no se puede hacer el exec.
+void execScript(const std::string& argv0, const std::string& script, const std::vector<std::string>& args,
+    LaunchTiming& timing, LaunchCache* cache, bool print_timing);
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_LAUNCHER_H
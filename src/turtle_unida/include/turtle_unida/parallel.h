@@ -0,0 +1,38 @@
+#ifndef TURTLE_UNIDA_PARALLEL_H
+#define TURTLE_UNIDA_PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace turtle_unida
+{
+
+// Hilos a usar: los pedidos, o uno por núcleo si se pide 0 o menos
+inline int threadCount(int requested)
+{
+    return requested > 0 ? requested : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+// Reparte [0, count) en `threads` tramos seguidos y llama a body(begin, end)
+// en cada uno; el último tramo corre en el hilo que llama
+template <class Body>
+void parallelFor(std::size_t count, int threads, const Body& body)
+{
+    const std::size_t parts = std::max<std::size_t>(1, std::min<std::size_t>(std::max(threads, 1), count));
+    std::vector<std::thread> workers;
+    for (std::size_t k = 0; k + 1 < parts; ++k)
+    {
+        workers.push_back(std::thread(body, count * k / parts, count * (k + 1) / parts));
+    }
+    body(count * (parts - 1) / parts, count);
+    for (std::size_t k = 0; k < workers.size(); ++k)
+    {
+        workers[k].join();
+    }
+}
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_PARALLEL_H
@@ -0,0 +1,76 @@
+#ifndef TURTLE_UNIDA_PATH_INDEX_H
+#define TURTLE_UNIDA_PATH_INDEX_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace turtle_unida
+{
+
+// Punto de un camino: segmento, fracción dentro de él y distancia recorrida
+struct PathPoint
+{
+    std::size_t segment;
+    double u;         // 0 = inicio del segmento, 1 = final
+    double s;         // longitud de arco desde el inicio del camino (m)
+    double x;
+    double y;
+    double distance;  // distancia al punto consultado (solo en nearest)
+};
+
+// Índice espacial sobre los segmentos de una polilínea (x0, y0, x1, y1, ...).
+// Los segmentos se reparten en una rejilla uniforme con tantas celdas como
+// segmentos aproximadamente, guardada en dos vectores (inicio de cada celda y
+// segmentos de todas las celdas seguidos). El punto más cercano se busca por
+// anillos de celdas alrededor de la consulta y termina en cuanto el anillo
+// queda más lejos que el mejor candidato, así que el coste depende de la
+// densidad local del camino y no de su número de puntos. El punto a una
+// longitud de arco dada es una búsqueda binaria en las longitudes acumuladas.
+class PathIndex
+{
+public:
+    // Lanza std::invalid_argument si no hay al menos dos puntos
+    explicit PathIndex(const std::vector<double>& points);
+
+    // Punto del camino más cercano a (x, y) entre los que tienen longitud de
+    // arco en [s_min, s_max]; si no hay ninguno, el más cercano de todo el camino
+    PathPoint nearest(double x, double y, double s_min = 0.0, double s_max = INFINITY) const;
+
+    // Punto a una longitud de arco (se satura al principio y al final)
+    PathPoint at(double s) const;
+
+    std::size_t segments() const { return lengths_.size() - 1; }
+    double length() const { return lengths_.back(); }
+    double x(std::size_t vertex) const { return points_[2 * vertex]; }
+    double y(std::size_t vertex) const { return points_[2 * vertex + 1]; }
+
+private:
+    // Busca en la rejilla; false si ningún segmento cumple el filtro
+    bool search(double x, double y, double s_min, double s_max, PathPoint& best) const;
+    PathPoint project(std::size_t segment, double x, double y, double s_min, double s_max) const;
+
+    std::vector<double> points_;
+    std::vector<double> lengths_;  // longitud de arco de cada vértice
+
+    // Rejilla: celda (i, j) -> segmentos cell_segments_[cell_start_[c], cell_start_[c + 1])
+    double min_x_;
+    double min_y_;
+    double cell_;
+    std::size_t columns_;
+    std::size_t rows_;
+    std::vector<std::uint32_t> cell_start_;
+    std::vector<std::uint32_t> cell_segments_;
+};
+
+// Lee un camino de un fichero de texto con un punto "x y" por línea, o las
+// poses grabadas del primer topic de pose de un log de comandos (.log),
+// descartando los puntos a menos de min_spacing del anterior. Lanza
+// std::runtime_error si el fichero no se puede leer.
+std::vector<double> loadPath(const std::string& path, double min_spacing = 0.01);
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_PATH_INDEX_H
@@ -0,0 +1,27 @@
+#ifndef TURTLE_UNIDA_POSE_H
+#define TURTLE_UNIDA_POSE_H
+
+#include <cmath>
+
+namespace turtle_unida
+{
+
+// Equivalente sin ROS de turtlesim/Pose
+struct Pose
+{
+    double x;
+    double y;
+    double theta;
+    double linear_velocity;
+    double angular_velocity;
+};
+
+// Lleva un ángulo al intervalo (-pi, pi]
+inline double normalizeAngle(double angle)
+{
+    return std::atan2(std::sin(angle), std::cos(angle));
+}
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_POSE_H
@@ -0,0 +1,75 @@
+#ifndef TURTLE_UNIDA_PUBLISH_POLICY_H
+#define TURTLE_UNIDA_PUBLISH_POLICY_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "turtle_unida/transport.h"
+
+namespace turtle_unida
+{
+
+// Cuándo merece la pena publicar un comando
+struct PublishPolicy
+{
+    PublishPolicy();
+
+    double linear_deadband;   // cambios de linear.x / linear.y por debajo de esto no se publican (m/s)
+    double angular_deadband;  // ídem para angular.z (rad/s)
+    double keep_alive;        // se publica al menos cada este tiempo aunque no cambie nada (s)
+};
+
+struct PublishStats
+{
+    PublishStats();
+
+    std::uint64_t sent;         // comandos que han llegado al transporte
+    std::uint64_t suppressed;   // comandos descartados por la banda muerta
+    std::uint64_t keep_alives;  // enviados solo para no agotar el tiempo del receptor
+
+    std::string summary() const;
+};
+
+// Transporte que solo deja pasar los comandos que cambian. Un Twist se
+// descarta si linear.x, linear.y y angular.z difieren del último publicado
+// en ese canal menos que la banda muerta; como se compara con el último
+// publicado y no con el último recibido, los cambios lentos se acumulan y
+// acaban saliendo. Aun así se repite el comando actual cada keep_alive
+// segundos: turtlesim para la tortuga tras un segundo sin mensajes. Pasar a
+// cero desde algo distinto de cero se publica siempre. Las marcas de latencia
+// (latency.h) no cuentan como cambio.
+class DeadbandTransport : public Transport
+{
+public:
+    // Segundos de un reloj monotónico; por defecto monotonicNanos()
+    typedef std::function<double()> Clock;
+
+    DeadbandTransport(Transport& inner, const PublishPolicy& policy, const Clock& clock = Clock());
+
+    Channel advertise(const std::string& topic) override;
+    void publish(Channel channel, const Twist& twist) override;
+    void flush() override;
+    void subscribe(const std::string& topic, const PoseCallback& callback) override;
+
+    const PublishPolicy& policy() const { return policy_; }
+    const PublishStats& stats() const { return stats_; }
+    const PublishStats& stats(Channel channel) const { return channel_stats_[channel]; }
+
+private:
+    Transport& inner_;
+    PublishPolicy policy_;
+    Clock clock_;
+    PublishStats stats_;
+
+    // Por canal: último comando publicado y cuándo
+    std::vector<Twist> last_;
+    std::vector<double> last_time_;
+    std::vector<std::uint8_t> published_;
+    std::vector<PublishStats> channel_stats_;
+};
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_PUBLISH_POLICY_H
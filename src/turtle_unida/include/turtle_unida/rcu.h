@@ -0,0 +1,103 @@
+#ifndef TURTLE_UNIDA_RCU_H
+#define TURTLE_UNIDA_RCU_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace turtle_unida
+{
+
+// Objeto de configuración que se sustituye entero mientras un bucle lo lee
+// (RCU con estados de reposo). El lector, un solo hilo, obtiene el objeto
+// actual con una carga atómica y llama a quiescent() cuando ya no guarda
+// ninguna referencia, p. ej. al final de cada ciclo: nunca toma un cerrojo
+// ni espera. Los escritores construyen el objeto nuevo fuera del bucle y lo
+// publican con un intercambio atómico; el anterior solo se libera en una
+// publicación posterior (o al destruir la celda) cuando el lector ya ha
+// pasado por quiescent() después de dejar de verlo.
+template <class T>
+class RcuCell
+{
+public:
+    explicit RcuCell(std::unique_ptr<T> initial)
+        : current_(initial.release()), epoch_(1), reader_epoch_(0)
+    {
+    }
+
+    ~RcuCell()
+    {
+        delete current_.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < retired_.size(); ++i)
+        {
+            delete retired_[i].second;
+        }
+    }
+
+    RcuCell(const RcuCell&) = delete;
+    RcuCell& operator=(const RcuCell&) = delete;
+
+    // Lector: objeto vigente; la referencia es válida hasta el siguiente quiescent()
+    const T& read() const { return *current_.load(std::memory_order_acquire); }
+
+    // Lector: ya no usa ninguna referencia obtenida con read()
+    void quiescent()
+    {
+        reader_epoch_.store(epoch_.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    // Escritor (cualquier hilo): sustituye el objeto; el lector lo ve en su siguiente read()
+    void publish(std::unique_ptr<T> next)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        T* previous = current_.exchange(next.release(), std::memory_order_acq_rel);
+
+        // El lector puede seguir usando `previous` hasta que pase por
+        // quiescent() con una época posterior a esta
+        const std::uint64_t epoch = epoch_.fetch_add(1, std::memory_order_acq_rel) + 1;
+        retired_.push_back(std::make_pair(epoch, previous));
+        reclaim();
+    }
+
+    // Publicaciones hechas desde que se creó la celda
+    std::uint64_t version() const { return epoch_.load(std::memory_order_acquire) - 1; }
+
+    // Objetos sustituidos que el lector aún podría estar usando
+    std::size_t retired() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return retired_.size();
+    }
+
+private:
+    void reclaim()
+    {
+        const std::uint64_t seen = reader_epoch_.load(std::memory_order_acquire);
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < retired_.size(); ++i)
+        {
+            if (retired_[i].first <= seen)
+            {
+                delete retired_[i].second;
+            }
+            else
+            {
+                retired_[kept++] = retired_[i];
+            }
+        }
+        retired_.resize(kept);
+    }
+
+    std::atomic<T*> current_;
+    std::atomic<std::uint64_t> epoch_;         // sube con cada publicación
+    std::atomic<std::uint64_t> reader_epoch_;  // época vista por el lector en su último quiescent()
+    mutable std::mutex mutex_;                 // solo entre escritores
+    std::vector<std::pair<std::uint64_t, T*> > retired_;
+};
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_RCU_H
@@ -0,0 +1,97 @@
+#ifndef TURTLE_UNIDA_REPLAY_H
+#define TURTLE_UNIDA_REPLAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "turtle_unida/command_log.h"
+#include "turtle_unida/histogram.h"
+#include "turtle_unida/simulator.h"
+#include "turtle_unida/transport.h"
+
+namespace turtle_unida
+{
+
+// Parámetros de una reproducción
+struct ReplayConfig
+{
+    ReplayConfig();
+
+    double speed;  // 1 = tiempo real, N = N veces más rápido, 0 = tan rápido como sea posible
+    double start;  // segundos desde el inicio de la grabación
+    double end;    // segundos desde el inicio de la grabación; 0 = hasta el final
+};
+
+struct ReplayStats
+{
+    ReplayStats();
+
+    std::uint64_t commands;  // Twists republicados
+    std::uint64_t poses;     // poses grabadas comparadas con la simulación
+    double log_time;         // segundos de grabación reproducidos
+    double wall_time;        // segundos reales que ha durado la reproducción
+    double max_pose_error;   // mayor distancia entre la pose grabada y la simulada (m)
+    Histogram lateness;      // retraso de cada registro respecto a su instante (ns), con speed > 0
+
+    std::string summary() const;
+};
+
+// Vuelve a publicar los comandos de un log en sus topics originales. El
+// tiempo de la grabación se escala con config.speed: cada registro sale en
+// start + t / speed, o sin esperar con speed = 0. Todos los topics con
+// comandos se anuncian al construirlo, antes de reproducir nada, para que
+// los suscriptores tengan tiempo de conectarse y no se pierdan los primeros
+// mensajes. Las marcas de latencia grabadas se borran para no mezclarlas con
+// las de la reproducción.
+class Replayer
+{
+public:
+    // Se llama con el instante de cada registro (s desde config.start) antes
+    // de procesarlo; un simulador lo usa para avanzar hasta ese instante
+    typedef std::function<void(double)> AdvanceCallback;
+
+    // Recibe cada pose grabada con el índice de su topic en el log
+    typedef std::function<void(std::uint32_t, const Pose&)> PoseCallback;
+
+    Replayer(const CommandLogReader& log, Transport& transport, const ReplayConfig& config);
+
+    void setAdvance(const AdvanceCallback& advance) { advance_ = advance; }
+    void setPoseCallback(const PoseCallback& callback) { pose_callback_ = callback; }
+
+    // Reproduce el intervalo configurado mientras ok() devuelva true; se
+    // puede llamar otra vez para repetirlo (las estadísticas se acumulan)
+    const ReplayStats& run(const std::function<bool()>& ok);
+
+    const ReplayStats& stats() const { return stats_; }
+    ReplayStats& stats() { return stats_; }
+
+    // Canales anunciados, uno por topic con comandos
+    const std::vector<Transport::Channel>& advertised() const { return advertised_channels_; }
+
+private:
+
+    const CommandLogReader& log_;
+    Transport& transport_;
+    ReplayConfig config_;
+    AdvanceCallback advance_;
+    PoseCallback pose_callback_;
+    std::vector<Transport::Channel> channels_;  // canal de cada topic del log
+    std::vector<Transport::Channel> advertised_channels_;
+    ReplayStats stats_;
+};
+
+// Reproduce un log sobre un simulador sin ventana en este hilo. Crea una
+// tortuga por cada "/<nombre>/cmd_vel" del log, en la primera pose grabada
+// de "/<nombre>/pose" (o en el centro si no hay), y el tiempo simulado sigue
+// al de la grabación aunque se reproduzca más rápido. Cada pose grabada se
+// compara con la simulada, así que max_pose_error sirve de prueba de regresión.
+// Lanza std::runtime_error si el log no se puede abrir.
+ReplayStats replayInSimulator(const std::string& path, const ReplayConfig& config,
+    const SimulatorConfig& simulator = SimulatorConfig());
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_REPLAY_H
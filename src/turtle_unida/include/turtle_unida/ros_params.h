@@ -0,0 +1,38 @@
+#ifndef TURTLE_UNIDA_ROS_PARAMS_H
+#define TURTLE_UNIDA_ROS_PARAMS_H
+
+#include <ros/ros.h>
+
+#include "turtle_unida/avoidance.h"
+#include "turtle_unida/controller.h"
+#include "turtle_unida/executor.h"
+#include "turtle_unida/publish_policy.h"
+#include "turtle_unida/scheduler.h"
+#include "turtle_unida/trajectory.h"
+
+namespace turtle_unida
+{
+
+// Lee la trayectoria de los parámetros privados (~trajectory, ~linear_x, ...)
+void readTrajectoryParams(const ros::NodeHandle& pnh, TrajectoryParams& params);
+
+// Lee el planificador de los parámetros privados (~rate, ~spin_margin, ~overrun);
+// lanza std::invalid_argument si no es válido
+void readSchedulerParams(const ros::NodeHandle& pnh, SchedulerConfig& config);
+
+// Lee el controlador de los parámetros privados (~controller, ~goal_x, ...)
+void readControllerParams(const ros::NodeHandle& pnh, ControllerParams& params);
+
+// Lee la evitación de colisiones de los parámetros privados (~avoid_radius, ...)
+void readAvoidanceParams(const ros::NodeHandle& pnh, AvoidanceConfig& config);
+
+// Lee el ejecutor de los parámetros privados (~threads, ~grain, ~deterministic)
+void readExecutorParams(const ros::NodeHandle& pnh, ExecutorConfig& config);
+
+// Lee la política de publicación de los parámetros privados (~deadband_linear,
+// ~deadband_angular, ~keep_alive); devuelve ~deadband (si se activa)
+bool readPublishPolicyParams(const ros::NodeHandle& pnh, PublishPolicy& policy);
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_ROS_PARAMS_H
@@ -0,0 +1,69 @@
+#ifndef TURTLE_UNIDA_ROS_TRANSPORT_H
+#define TURTLE_UNIDA_ROS_TRANSPORT_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <geometry_msgs/Twist.h>
+#include <ros/ros.h>
+#include <turtlesim/Pose.h>
+
+#include "turtle_unida/shm_link.h"
+#include "turtle_unida/transport.h"
+#include "turtle_unida/twist_pool.h"
+
+namespace turtle_unida
+{
+
+// Transporte sobre roscpp: cada canal es un ros::Publisher de geometry_msgs/Twist
+// y las poses llegan como turtlesim/Pose. Los Twist se serializan en los
+// buffers reutilizables de un TwistPool por canal y roscpp recibe el buffer
+// sin copiarlo, así que publicar no reserva memoria en nuestro lado.
+//
+// Con shared_memory cada topic de salida escribe además en un anillo de
+// memoria compartida (shm_ring.h) y los suscriptores de la misma máquina lo
+// leen sin esperar a TCPROS; siguen suscritos por roscpp para recibir a los
+// demás publicadores del topic y descartan lo que llega de este nodo. Solo
+// se serializa por roscpp si hay algún suscriptor. Las poses por memoria
+// compartida se entregan en pollShared(), que debe llamarse desde el mismo
+// hilo que ros::spinOnce().
+class RosTransport : public Transport
+{
+public:
+    explicit RosTransport(const ros::NodeHandle& nh, unsigned int queue_size = 10, bool shared_memory = false);
+
+    Channel advertise(const std::string& topic) override;
+    void publish(Channel channel, const Twist& twist) override;
+    void subscribe(const std::string& topic, const PoseCallback& callback) override;
+
+    const TwistPool& pool(Channel channel) const { return pools_[channel]; }
+
+    // Suscriptores conectados por roscpp al canal
+    std::uint32_t subscribers(Channel channel) const { return publishers_[channel].getNumSubscribers(); }
+
+    // Entrega la última pose llegada por memoria compartida a cada suscriptor
+    std::size_t pollShared();
+
+    // Espera hasta timeout segundos a que llegue una pose por memoria compartida
+    void waitShared(double timeout);
+
+    // Algún topic de entrada llega ya por memoria compartida
+    bool sharedActive() const;
+
+private:
+    ros::NodeHandle nh_;
+    unsigned int queue_size_;
+    std::vector<ros::Publisher> publishers_;
+    std::vector<TwistPool> pools_;
+    std::vector<ros::Subscriber> subscribers_;
+
+    bool shared_memory_;
+    std::vector<std::unique_ptr<ShmRing> > rings_;  // por canal; nullptr sin memoria compartida
+    std::vector<std::unique_ptr<ShmLink> > links_;
+    std::vector<PoseCallback> link_callbacks_;
+};
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_ROS_TRANSPORT_H
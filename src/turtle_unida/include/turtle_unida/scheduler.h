@@ -0,0 +1,97 @@
+#ifndef TURTLE_UNIDA_SCHEDULER_H
+#define TURTLE_UNIDA_SCHEDULER_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "turtle_unida/histogram.h"
+
+namespace turtle_unida
+{
+
+// Qué hacer cuando un ciclo se despierta después de uno o más instantes previstos
+enum OverrunPolicy
+{
+    CATCH_UP,  // ejecuta los ciclos perdidos seguidos, sin dormir (simulación, reproducción)
+    SKIP       // descarta los ciclos perdidos y se alinea con el siguiente instante (comandos)
+};
+
+struct SchedulerConfig
+{
+    SchedulerConfig();
+
+    double rate;           // frecuencia en Hz
+    double spin_margin;    // segundos finales de cada espera en espera activa
+    OverrunPolicy policy;
+};
+
+// Lanza std::invalid_argument si la frecuencia no es positiva (o su periodo no
+// llega a un tic del reloj) o el margen de espera activa es negativo
+void validateSchedulerConfig(const SchedulerConfig& config);
+
+// Estadísticas por bucle; los histogramas están en nanosegundos
+struct SchedulerStats
+{
+    SchedulerStats();
+
+    std::uint64_t ticks;    // ciclos ejecutados
+    std::uint64_t missed;   // instantes previstos que pasaron sin ejecutarse a tiempo
+    std::uint64_t skipped;  // ciclos descartados por la política SKIP
+    Histogram period;       // periodo real entre despertares consecutivos
+    Histogram jitter;       // |periodo real - periodo nominal|
+    Histogram lateness;     // retraso del despertar respecto al instante previsto
+
+    // Resumen de una línea para los logs
+    std::string summary() const;
+};
+
+// Datos del ciclo que acaba de empezar
+struct TickInfo
+{
+    double time;          // instante previsto, en segundos desde el inicio
+    double lateness;      // retraso del despertar (s)
+    std::uint64_t missed; // instantes previstos perdidos antes de este ciclo
+};
+
+// Planificador periódico que sustituye a rospy.Rate / ros::Rate. Los
+// instantes se calculan de forma absoluta (inicio + k * periodo) para que
+// el error no se acumule; la espera duerme hasta poco antes del instante y
+// termina en espera activa, lo que permite periodos por debajo del
+// milisegundo. Detecta los ciclos que llegan tarde y aplica la política de
+// recuperación configurada.
+class PeriodicScheduler
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    // Lanza std::invalid_argument si la configuración no es válida
+    explicit PeriodicScheduler(const SchedulerConfig& config);
+
+    // Espera al siguiente instante previsto. La primera llamada vuelve enseguida.
+    TickInfo wait();
+
+    // Instante previsto del ciclo actual, en segundos desde el inicio
+    double time() const;
+
+    // Vuelve a empezar desde ahora y borra las estadísticas
+    void reset();
+
+    const SchedulerConfig& config() const { return config_; }
+    const SchedulerStats& stats() const { return stats_; }
+
+private:
+    SchedulerConfig config_;
+    Clock::duration period_;
+    Clock::duration spin_;
+    Clock::time_point start_;
+    Clock::time_point current_;
+    Clock::time_point deadline_;
+    Clock::time_point last_wake_;
+    Clock::time_point counted_until_;  // último instante ya contado como perdido
+    SchedulerStats stats_;
+};
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_SCHEDULER_H
@@ -0,0 +1,77 @@
+#ifndef TURTLE_UNIDA_SHM_LINK_H
+#define TURTLE_UNIDA_SHM_LINK_H
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <ros/ros.h>
+
+#include "turtle_unida/pose.h"
+#include "turtle_unida/shm_ring.h"
+#include "turtle_unida/twist.h"
+
+namespace turtle_unida
+{
+
+// Nombre del segmento de memoria compartida de un topic. Incluye un hash del
+// ROS master para que dos sistemas en la misma máquina no se mezclen.
+std::string shmSegmentName(const std::string& topic);
+
+// Crea el anillo de escritura de un topic con el nombre del nodo como
+// dueño; nullptr (con un aviso) si no se puede
+std::unique_ptr<ShmRing> createShmWriter(const std::string& topic);
+
+// Conversión entre mensajes y registros del anillo
+void toRecord(const Twist& twist, ShmRing::Record& record);
+void toRecord(const Pose& pose, ShmRing::Record& record);
+Twist twistFromRecord(const ShmRing::Record& record);
+Pose poseFromRecord(const ShmRing::Record& record);
+
+// Lado receptor de un topic que puede llegar por memoria compartida y por
+// roscpp. La suscripción de roscpp se mantiene siempre, porque en el topic
+// puede haber otros publicadores (mover.py, teleop, replay, otra máquina);
+// si el segmento del topic existe, lo escrito por su dueño se lee del anillo
+// y los mensajes de roscpp de ese mismo nodo se descartan con duplicate().
+// Si el dueño muere se vuelve a aceptar todo por roscpp. Los registros se
+// entregan en poll(), en el hilo que lo llama, igual que ros::spinOnce().
+class ShmLink
+{
+public:
+    // Crea la suscripción de roscpp; su callback debe consultar duplicate()
+    typedef std::function<ros::Subscriber(const ShmLink&)> Subscribe;
+    typedef std::function<void(const ShmRing::Record&)> Callback;
+
+    ShmLink(const std::string& topic, const Subscribe& subscribe);
+
+    // Entrega los registros nuevos; una vez por segundo intenta conectarse al
+    // segmento o comprueba que el escritor siga vivo. Devuelve cuántos entregó.
+    std::size_t poll(const Callback& callback);
+
+    // Espera hasta timeout segundos a que llegue un registro; false si no hay anillo
+    bool wait(double timeout);
+
+    // El mensaje de roscpp de publisher ya llega por el anillo
+    bool duplicate(const std::string& publisher) const { return ring_ && publisher == owner_; }
+
+    bool shared() const { return ring_ != nullptr; }
+    const std::string& topic() const { return topic_; }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    void check();
+
+    std::string topic_;
+    std::string segment_;
+    ros::Subscriber subscriber_;
+    std::unique_ptr<ShmRing> ring_;
+    std::string owner_;  // nodo que escribe en el anillo
+    Clock::time_point next_check_;
+};
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_SHM_LINK_H
@@ -0,0 +1,84 @@
+#ifndef TURTLE_UNIDA_SHM_RING_H
+#define TURTLE_UNIDA_SHM_RING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace turtle_unida
+{
+
+struct ShmSegment;
+
+// Anillo de registros de tamaño fijo en un segmento de memoria compartida
+// (shm_open + mmap) con un escritor y cualquier número de lectores en otros
+// procesos de la misma máquina. Cada registro lleva su número de secuencia
+// (seqlock), así que escribir nunca bloquea: un lector que se queda atrás
+// pierde los registros más antiguos y lo cuenta en dropped(). Los lectores
+// esperan en un futex que el escritor solo despierta si hay alguien esperando.
+//
+// Solo está disponible en Linux; en el resto create() lanza una excepción y
+// open() devuelve nullptr, de modo que se sigue usando el transporte normal.
+class ShmRing
+{
+public:
+    // Valores double por registro: caben un Twist (6) o un Pose (5)
+    static const std::size_t VALUES = 7;
+
+    struct Record
+    {
+        double values[VALUES];
+    };
+
+    // Crea el segmento como escritor, sustituyendo uno anterior con el mismo
+    // nombre cuyo escritor haya terminado. owner identifica al escritor ante
+    // los lectores (p. ej. el nombre del nodo). Lanza std::runtime_error si no
+    // se puede crear o si el escritor del segmento anterior sigue vivo.
+    static std::unique_ptr<ShmRing> create(const std::string& name, std::uint32_t capacity = 256,
+        const std::string& owner = std::string());
+
+    // Se conecta como lector a un segmento cuyo escritor sigue vivo; nullptr
+    // si no existe. Solo se leen los registros escritos a partir de ahora.
+    static std::unique_ptr<ShmRing> open(const std::string& name);
+
+    // Nombre válido para shm_open a partir de un prefijo y un topic:
+    // ("/turtle_unida.1f2e", "/turtle1/cmd_vel") -> "/turtle_unida.1f2e.turtle1.cmd_vel"
+    static std::string segmentName(const std::string& prefix, const std::string& topic);
+
+    ~ShmRing();
+
+    // Escritor: publica un registro y despierta a los lectores que esperan
+    void write(const Record& record);
+
+    // Lector: copia el siguiente registro; false si no hay ninguno nuevo
+    bool next(Record& record);
+
+    // Lector: espera hasta timeout segundos a que haya un registro nuevo
+    bool wait(double timeout);
+
+    // Lector: el proceso escritor sigue vivo
+    bool writerAlive() const;
+
+    const std::string& name() const { return name_; }
+    std::string owner() const;
+    bool writer() const { return writer_; }
+    std::uint64_t dropped() const { return dropped_; }
+
+private:
+    ShmRing(const std::string& name, ShmSegment* segment, std::size_t bytes, bool writer);
+    ShmRing(const ShmRing&);
+    ShmRing& operator=(const ShmRing&);
+
+    std::string name_;
+    ShmSegment* segment_;
+    std::size_t bytes_;
+    bool writer_;
+    std::uint64_t inode_;    // segmento creado por este escritor
+    std::uint64_t cursor_;   // siguiente registro que leerá este lector
+    std::uint64_t dropped_;  // registros sobrescritos antes de leerlos
+};
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_SHM_RING_H
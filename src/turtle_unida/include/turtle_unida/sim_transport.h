@@ -0,0 +1,56 @@
+#ifndef TURTLE_UNIDA_SIM_TRANSPORT_H
+#define TURTLE_UNIDA_SIM_TRANSPORT_H
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "turtle_unida/latency.h"
+#include "turtle_unida/simulator.h"
+#include "turtle_unida/transport.h"
+
+namespace turtle_unida
+{
+
+// Conecta el simulador con cualquier componente que use Transport dentro del
+// mismo proceso: "/<nombre>/cmd_vel" aplica el comando a la tortuga y
+// "/<nombre>/pose" recibe su pose después de cada paso, como en turtlesim.
+class SimTransport : public Transport
+{
+public:
+    explicit SimTransport(Simulator& simulator);
+
+    // Crea una tortuga con nombre (turtle1, turtle2, ...) y devuelve su índice
+    std::size_t spawn(const std::string& name, double x, double y, double theta);
+
+    // Índice de la tortuga; lanza std::invalid_argument si no existe
+    std::size_t turtle(const std::string& name) const;
+
+    Channel advertise(const std::string& topic) override;
+    void publish(Channel channel, const Twist& twist) override;
+    void subscribe(const std::string& topic, const PoseCallback& callback) override;
+
+    // Integra un paso del simulador y entrega las poses a los suscriptores
+    void step();
+
+    Simulator& simulator() { return simulator_; }
+
+    // Latencia de los comandos recibidos con marcas; el envío y la recepción
+    // coinciden porque el comando se aplica dentro de publish()
+    LatencyStats& latency() { return latency_; }
+
+private:
+    std::size_t turtleFromTopic(const std::string& topic, const std::string& suffix) const;
+
+    Simulator& simulator_;
+    std::map<std::string, std::size_t> names_;
+    std::vector<std::size_t> channels_;
+    std::vector<std::pair<std::size_t, PoseCallback> > subscribers_;
+    LatencyStats latency_;
+};
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_SIM_TRANSPORT_H
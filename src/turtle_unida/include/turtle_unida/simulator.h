@@ -0,0 +1,96 @@
+#ifndef TURTLE_UNIDA_SIMULATOR_H
+#define TURTLE_UNIDA_SIMULATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "turtle_unida/pose.h"
+#include "turtle_unida/twist.h"
+
+namespace turtle_unida
+{
+
+// Parámetros del simulador; los valores por defecto son los de turtlesim
+struct SimulatorConfig
+{
+    SimulatorConfig();
+
+    double world_size;        // lado del mundo cuadrado (m)
+    double dt;                // paso de integración (s)
+    double command_timeout;   // sin comandos durante este tiempo la tortuga se para (s)
+    bool trails;              // guarda el rastro del lápiz
+    double trail_resolution;  // distancia mínima entre puntos del rastro (m)
+};
+
+// Punto del rastro del lápiz; un punto con pen_down == false corta el trazo
+struct TrailPoint
+{
+    float x;
+    float y;
+    bool pen_down;
+};
+
+// Simulador cinemático sin interfaz gráfica compatible con turtlesim
+// (modelo uniciclo, mundo de 11x11 m, choque con las paredes, lápiz y
+// parada tras un segundo sin comandos). Las tortugas se guardan en
+// columnas y la orientación como (cos, sin): al recibir un comando se
+// precalcula la rotación de un paso, de modo que step() solo hace
+// multiplicaciones, sumas y comparaciones sobre memoria contigua y el
+// compilador lo vectoriza. No duerme nunca: avanza tan rápido como se
+// llame a step().
+class Simulator
+{
+public:
+    explicit Simulator(const SimulatorConfig& config = SimulatorConfig());
+
+    // Crea una tortuga y devuelve su índice
+    std::size_t spawn(double x, double y, double theta);
+
+    // Aplica un comando de velocidad (como un mensaje en /turtleN/cmd_vel)
+    void command(std::size_t turtle, const Twist& twist);
+
+    // Mueve la tortuga sin integrar (teleport_absolute); dibuja si el lápiz está bajado
+    void teleport(std::size_t turtle, double x, double y, double theta);
+
+    // Sube o baja el lápiz (set_pen)
+    void setPen(std::size_t turtle, bool down);
+
+    // Integra un paso de config.dt segundos
+    void step();
+
+    // Integra los pasos necesarios para avanzar `duration` segundos
+    void advance(double duration);
+
+    Pose pose(std::size_t turtle) const;
+    std::size_t size() const { return x_.size(); }
+    double time() const { return time_; }
+    std::uint64_t wallHits() const { return wall_hits_; }
+    const std::vector<TrailPoint>& trail(std::size_t turtle) const { return trails_[turtle]; }
+    const SimulatorConfig& config() const { return config_; }
+
+private:
+    void recordTrails();
+
+    SimulatorConfig config_;
+    double time_;
+    std::uint64_t steps_;
+    std::uint64_t wall_hits_;
+
+    // Estado por tortuga, una columna por campo
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<double> cos_;       // orientación como vector unitario
+    std::vector<double> sin_;
+    std::vector<double> linear_;    // velocidad lineal comandada
+    std::vector<double> angular_;   // velocidad angular comandada
+    std::vector<double> rot_cos_;   // rotación de un paso: cos(angular * dt)
+    std::vector<double> rot_sin_;   //                      sin(angular * dt)
+    std::vector<double> deadline_;  // instante en que caduca el último comando
+    std::vector<std::uint8_t> pen_;
+    std::vector<std::vector<TrailPoint> > trails_;
+};
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_SIMULATOR_H
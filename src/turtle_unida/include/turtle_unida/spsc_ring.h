@@ -0,0 +1,104 @@
+#ifndef TURTLE_UNIDA_SPSC_RING_H
+#define TURTLE_UNIDA_SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace turtle_unida
+{
+
+// Cola circular acotada sin cerrojos entre exactamente un hilo productor y
+// un hilo consumidor. Cada lado solo escribe su propio índice (el productor
+// `head_`, el consumidor `tail_`) y guarda una copia del índice del otro que
+// solo relee cuando la copia dice que la cola está llena o vacía, así que en
+// el caso normal no hay tráfico de caché entre los dos núcleos. Los índices
+// de cada lado van separados por relleno para que no compartan línea de
+// caché (false sharing).
+template <class T>
+class SpscRing
+{
+public:
+    // La capacidad se redondea a la siguiente potencia de dos; lanza
+    // std::invalid_argument si es 0
+    explicit SpscRing(std::size_t capacity)
+        : head_(0), cached_tail_(0), tail_(0), cached_head_(0)
+    {
+        if (capacity == 0)
+        {
+            throw std::invalid_argument("la cola debe tener al menos un hueco");
+        }
+        std::size_t size = 1;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+        slots_.resize(size);
+        mask_ = size - 1;
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Productor: false si la cola está llena
+    bool tryPush(const T& value)
+    {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head - cached_tail_ > mask_)
+        {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head - cached_tail_ > mask_)
+            {
+                return false;
+            }
+        }
+        slots_[head & mask_] = value;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumidor: false si la cola está vacía
+    bool tryPop(T& value)
+    {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == cached_head_)
+        {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail == cached_head_)
+            {
+                return false;
+            }
+        }
+        value = slots_[tail & mask_];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Elementos en la cola; desde un tercer hilo es solo aproximado
+    std::size_t size() const
+    {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    std::size_t capacity() const { return mask_ + 1; }
+
+private:
+    std::vector<T> slots_;
+    std::size_t mask_;
+    char padding0_[64];
+
+    // Solo los escribe el productor
+    std::atomic<std::size_t> head_;
+    std::size_t cached_tail_;
+    char padding1_[64];
+
+    // Solo los escribe el consumidor
+    std::atomic<std::size_t> tail_;
+    std::size_t cached_head_;
+    char padding2_[64];
+};
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_SPSC_RING_H
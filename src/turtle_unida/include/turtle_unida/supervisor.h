@@ -0,0 +1,118 @@
+#ifndef TURTLE_UNIDA_SUPERVISOR_H
+#define TURTLE_UNIDA_SUPERVISOR_H
+
+#include <string>
+#include <vector>
+
+#include "turtle_unida/launch_cache.h"
+
+namespace turtle_unida
+{
+
+// Cuándo se vuelve a arrancar un nodo que termina
+enum RestartPolicy
+{
+    RESTART_NEVER,
+    RESTART_ON_FAILURE,  // código distinto de 0 o muerto por una señal
+    RESTART_ALWAYS
+};
+
+// Un nodo declarado en el fichero del supervisor
+struct NodeSpec
+{
+    NodeSpec();
+
+    std::string name;
+    std::vector<std::string> command;  // un .py se lanza con el intérprete de su shebang
+    std::vector<int> cpus;             // núcleos a los que se fija; vacío: sin fijar
+    RestartPolicy restart;
+    int max_restarts;                  // -1: sin límite
+};
+
+// Lee los nodos de un fichero con uno por línea:
+//
+//   nombre [cpus=0,2-3] [restart=never|on-failure|always] [retries=N] -- comando [argumentos...]
+//
+// Los campos van separados por espacios (sin comillas) y '#' empieza un
+// comentario. Por defecto restart=on-failure, sin límite de reinicios.
+// Lanza std::runtime_error si no se puede leer o una línea no es válida.
+std::vector<NodeSpec> readSupervisorFile(const std::string& path);
+
+struct SupervisorConfig
+{
+    SupervisorConfig();
+
+    double backoff;       // s hasta el primer reinicio; se duplica en cada fallo seguido
+    double backoff_max;   // s, tope de la espera
+    double stable_time;   // s: una ejecución más larga vuelve la espera a backoff
+    double stop_timeout;  // s entre SIGINT, SIGTERM y SIGKILL al parar
+    double duration;      // s hasta parar solo; 0: hasta SIGINT, SIGTERM o SIGHUP
+};
+
+// Lo medido de un nodo, acumulado entre reinicios
+struct NodeStats
+{
+    NodeStats();
+
+    int pid;             // del último arranque
+    int starts;
+    int failures;        // arranques fallidos (exec imposible) y salidas con error
+    int last_exit;       // 128 + señal si lo mató una señal; -1 si no ha terminado
+    double startup;      // s del último arranque hasta el exec del nodo
+    double startup_max;  // s
+    double cpu_user;     // s de CPU en modo usuario, todas las ejecuciones
+    double cpu_system;   // s de CPU en el núcleo
+    long max_rss_kb;     // pico de memoria residente de todas las ejecuciones
+    double uptime;       // s en ejecución, todas las ejecuciones
+
+    // Una línea JSON con el nombre del nodo
+    std::string json(const std::string& name) const;
+};
+
+// Arranca un conjunto de nodos a la vez (sin esperar a que ninguno esté
+// listo: los nodos de ROS ya esperan al master), reinicia con espera
+// exponencial los que terminan según su política, fija cada uno a sus
+// núcleos desde el exec (el supervisor cambia su propia afinidad para el
+// spawn, así que el nodo nunca corre en otro núcleo) y mide el arranque, la
+// CPU y la memoria de cada uno con wait4().
+//
+// Todo ocurre en el hilo que llama a run(), que bloquea SIGCHLD, SIGINT,
+// SIGTERM y SIGHUP y los atiende con sigtimedwait; los nodos arrancan con
+// todas las señales desbloqueadas.
+class Supervisor
+{
+public:
+    Supervisor(const std::vector<NodeSpec>& nodes, const SupervisorConfig& config);
+
+    // Vigila los nodos hasta que llega una de las señales, pasa duration o
+    // todos han terminado sin reinicio pendiente; entonces los para (SIGINT,
+    // luego SIGTERM y por último SIGKILL) y devuelve el número de nodos que
+    // han fallado alguna vez (las salidas al pararlos no cuentan).
+    int run();
+
+    const std::vector<NodeSpec>& nodes() const { return nodes_; }
+    const std::vector<NodeStats>& stats() const { return stats_; }
+
+private:
+    void start(std::size_t node, double now);
+    void reap(double now);
+    bool running() const;
+    void stop();
+
+    std::vector<NodeSpec> nodes_;
+    SupervisorConfig config_;
+    LaunchCache cache_;
+    bool stopping_;
+
+    // Estado de cada nodo, una columna por campo
+    std::vector<int> pids_;               // 0 si no está en ejecución
+    std::vector<double> started_at_;      // s, reloj monotónico
+    std::vector<double> restart_at_;      // s; negativo si no hay reinicio pendiente
+    std::vector<double> backoff_;         // s, próxima espera
+    std::vector<int> restarts_;
+    std::vector<NodeStats> stats_;
+};
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_SUPERVISOR_H
@@ -0,0 +1,168 @@
+#ifndef TURTLE_UNIDA_TIMER_WHEEL_H
+#define TURTLE_UNIDA_TIMER_WHEEL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace turtle_unida
+{
+
+// Identificador de un temporizador; 0 no es nunca válido. Lleva una
+// generación, así que cancelar uno ya vencido o cancelado no afecta al
+// temporizador que reutilice su hueco.
+typedef std::uint64_t TimerId;
+
+struct TimerStats
+{
+    TimerStats();
+
+    std::uint64_t scheduled;  // temporizadores añadidos
+    std::uint64_t cancelled;  // cancelados antes de vencer (los periódicos, en cualquier momento)
+    std::uint64_t expired;    // llamadas a los callbacks
+    std::uint64_t cascaded;   // recolocaciones de un nivel al inferior
+    std::uint64_t wakeups;    // despertares del hilo de TimerService
+
+    std::string summary() const;
+};
+
+// Rueda de temporizadores jerárquica. El tiempo avanza en pasos de
+// `resolution` segundos y hay cuatro niveles de 256 casillas: el nivel L
+// guarda los temporizadores cuyo vencimiento difiere del instante actual en
+// el dígito L (base 256), así que cubren 2^32 pasos (unos 50 días a 1 ms) y
+// lo que queda más lejos espera en una lista aparte. Cada casilla es una
+// lista doblemente enlazada sobre índices, de modo que añadir y cancelar son
+// O(1); al llegar al principio de una casilla de nivel superior sus
+// temporizadores bajan de nivel. Un mapa de bits por nivel permite saltar
+// directamente a la siguiente casilla ocupada, así que avanzar cuesta lo
+// mismo tras un paso que tras una hora sin temporizadores.
+//
+// No usa hilos ni reloj: el tiempo lo da quien llama a advance(), p. ej. un
+// bucle con PeriodicScheduler. Los callbacks pueden añadir y cancelar
+// temporizadores, también el suyo.
+class TimerWheel
+{
+public:
+    typedef std::function<void()> Callback;
+
+    static const int LEVELS = 4;
+    static const int SLOT_BITS = 8;
+    static const int SLOTS = 1 << SLOT_BITS;
+
+    // Lanza std::invalid_argument si resolution no es positiva
+    explicit TimerWheel(double resolution = 1e-3);
+
+    // Temporizador que vence en el instante `deadline` (s) y, si period > 0,
+    // después cada `period` segundos. Los vencimientos no adelantan nunca: se
+    // redondean al paso siguiente, y los ya pasados vencen en el próximo paso.
+    TimerId add(double deadline, double period, const Callback& callback);
+
+    // Devuelve false si el temporizador ya no existe
+    bool cancel(TimerId id);
+
+    // Ejecuta en orden de vencimiento los callbacks hasta el instante now (s)
+    void advance(double now);
+
+    // Primer vencimiento pendiente (s), o infinito si no hay ninguno
+    double nextExpiry() const;
+
+    double now() const { return current_ * resolution_; }
+    double resolution() const { return resolution_; }
+    std::size_t size() const { return size_; }
+    const TimerStats& stats() const { return stats_; }
+    TimerStats& stats() { return stats_; }
+
+private:
+    static const std::uint32_t NONE = 0xffffffffu;
+
+    // Listas además de las casillas de la rueda
+    static const std::uint32_t OVERFLOW_LIST = LEVELS * SLOTS;  // más allá del último nivel
+    static const std::uint32_t DUE_LIST = OVERFLOW_LIST + 1;    // vencidos en el paso actual
+    static const std::uint32_t LISTS = DUE_LIST + 1;
+
+    // Estados fuera de las listas mientras se ejecuta el callback
+    static const std::uint32_t FIRING = LISTS;         // se está ejecutando
+    static const std::uint32_t CANCELLED = LISTS + 1;  // y se ha cancelado desde dentro
+
+    std::uint32_t listOf(std::uint64_t deadline) const;
+    void link(std::uint32_t list, std::uint32_t timer);
+    void unlink(std::uint32_t timer);
+    void place(std::uint32_t timer);
+    void release(std::uint32_t timer);
+
+    // Siguiente paso en el que hay que hacer algo (vencer o bajar de nivel)
+    std::uint64_t nextEvent() const;
+    void processTick();
+    void fireDue();
+
+    double resolution_;
+    std::uint64_t current_;  // paso actual
+    std::size_t size_;
+    TimerStats stats_;
+
+    std::vector<std::uint32_t> heads_;  // primera entrada de cada lista
+    std::uint64_t occupied_[LEVELS][SLOTS / 64];
+    std::vector<std::uint32_t> free_;   // huecos libres
+
+    // Por temporizador, una columna por campo
+    std::vector<std::uint64_t> deadline_;  // en pasos
+    std::vector<std::uint64_t> period_;    // en pasos; 0 = una sola vez
+    std::vector<std::uint32_t> next_;
+    std::vector<std::uint32_t> prev_;
+    std::vector<std::uint32_t> list_;      // NONE si el hueco está libre
+    std::vector<std::uint32_t> generation_;
+    std::vector<Callback> callbacks_;
+};
+
+// Servicio de temporizadores con un único hilo de despacho sobre una
+// TimerWheel. El hilo duerme hasta el primer vencimiento pendiente y solo se
+// le despierta si se añade uno anterior, así que con millones de
+// temporizadores no hay un ciclo fijo que despierte sin nada que hacer. Los
+// callbacks se ejecutan en ese hilo con el servicio bloqueado: deben ser
+// cortos y no lanzar excepciones, pero pueden llamar a after(), every() y
+// cancel().
+class TimerService
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    explicit TimerService(double resolution = 1e-3);
+    ~TimerService();
+
+    TimerService(const TimerService&) = delete;
+    TimerService& operator=(const TimerService&) = delete;
+
+    // Una vez dentro de `delay` segundos
+    TimerId after(double delay, const TimerWheel::Callback& callback);
+
+    // Cada `period` segundos; el primero dentro de `delay` (por defecto, un periodo)
+    TimerId every(double period, const TimerWheel::Callback& callback, double delay = -1.0);
+
+    bool cancel(TimerId id);
+
+    std::size_t size() const;
+    TimerStats stats() const;
+
+private:
+    void loop();
+    double elapsed() const;
+    TimerId schedule(double delay, double period, const TimerWheel::Callback& callback);
+
+    TimerWheel wheel_;
+    Clock::time_point start_;
+    mutable std::recursive_mutex mutex_;  // los callbacks llegan con él tomado
+    std::condition_variable_any wake_;
+    double sleeping_until_;               // infinito si duerme sin vencimientos
+    bool stop_;
+    std::thread thread_;
+};
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_TIMER_WHEEL_H
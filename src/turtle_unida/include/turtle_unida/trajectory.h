@@ -0,0 +1,88 @@
+#ifndef TURTLE_UNIDA_TRAJECTORY_H
+#define TURTLE_UNIDA_TRAJECTORY_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "turtle_unida/twist.h"
+
+namespace turtle_unida
+{
+
+// Derivadas de una trayectoria plana (x(t), y(t)) en un instante
+struct PathDerivatives
+{
+    double dx;
+    double dy;
+    double ddx;
+    double ddy;
+};
+
+// Consignas de velocidad en función del tiempo. La tabla (lineal, angular)
+// se calcula una sola vez al cargar la trayectoria; en el bucle de control
+// sample() solo busca la muestra e interpola, sin trigonometría.
+class Trajectory
+{
+public:
+    typedef std::function<PathDerivatives(double)> PathFunction;
+
+    Trajectory();
+
+    // Velocidades constantes (el círculo de mover.py)
+    static Trajectory constant(double linear, double angular, double duration, double dt);
+
+    // Muestrea una curva plana: v = |p'|, w = (x'y'' - y'x'') / |p'|^2
+    static Trajectory fromPath(const PathFunction& path, double duration, double dt);
+
+    // Añade otra trayectoria al final (debe usar el mismo paso de tabla)
+    void append(const Trajectory& other);
+
+    // Consigna en el instante t. Las trayectorias periódicas se repiten y el
+    // resto devuelve velocidad cero al terminar.
+    Twist sample(double t) const;
+
+    void setPeriodic(bool periodic) { periodic_ = periodic; }
+    bool periodic() const { return periodic_; }
+    double duration() const { return duration_; }
+    double dt() const { return dt_; }
+    std::size_t size() const { return table_.size() / 2; }
+
+private:
+    void resize(double duration, double dt);
+
+    double dt_;
+    double inv_dt_;
+    double duration_;
+    bool periodic_;
+    std::vector<double> table_;  // pares (lineal, angular) intercalados
+};
+
+// Descripción de una trayectoria, tal como llega de los parámetros del nodo
+struct TrajectoryParams
+{
+    TrajectoryParams();
+
+    std::string type;              // circle, lemniscate, spiral, cubic, quintic o piecewise
+    double linear;                 // velocidad lineal (circle, spiral)
+    double angular;                // velocidad angular (circle)
+    double size;                   // amplitud de la lemniscata / radio inicial de la espiral
+    double period;                 // periodo de la lemniscata (s)
+    double growth;                 // crecimiento del radio de la espiral (m/s)
+    double duration;               // duración de la espiral o de cada tramo de spline (s)
+    std::vector<double> points;    // x0, y0, x1, y1, ... (splines)
+    std::vector<double> segments;  // duración, lineal, angular, ... (piecewise)
+    double table_dt;               // paso de la tabla precalculada (s)
+};
+
+bool operator==(const TrajectoryParams& a, const TrajectoryParams& b);
+bool operator!=(const TrajectoryParams& a, const TrajectoryParams& b);
+
+// Construye la tabla de la trayectoria; lanza std::invalid_argument si la
+// descripción no es válida
+Trajectory makeTrajectory(const TrajectoryParams& params);
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_TRAJECTORY_H
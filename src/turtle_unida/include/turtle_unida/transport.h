@@ -0,0 +1,84 @@
+#ifndef TURTLE_UNIDA_TRANSPORT_H
+#define TURTLE_UNIDA_TRANSPORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "turtle_unida/pose.h"
+#include "turtle_unida/twist.h"
+
+namespace turtle_unida
+{
+
+// Interfaz de transporte para los comandos de velocidad y las poses. El
+// commander no depende de ROS: el nodo usa RosTransport y las pruebas sin
+// roscore usan NullTransport o MemoryTransport.
+class Transport
+{
+public:
+    typedef std::size_t Channel;
+    typedef std::function<void(const Pose&)> PoseCallback;
+
+    virtual ~Transport() {}
+
+    // Registra un topic de salida (p. ej. "/turtle1/cmd_vel") y devuelve su canal
+    virtual Channel advertise(const std::string& topic) = 0;
+
+    // Publica un Twist en el canal indicado
+    virtual void publish(Channel channel, const Twist& twist) = 0;
+
+    // Envía los mensajes acumulados (solo para transportes que agrupan)
+    virtual void flush() {}
+
+    // Llama a callback con cada pose recibida en el topic (p. ej. "/turtle1/pose")
+    virtual void subscribe(const std::string& topic, const PoseCallback& callback) = 0;
+};
+
+// Descarta los mensajes y solo los cuenta
+class NullTransport : public Transport
+{
+public:
+    NullTransport();
+
+    Channel advertise(const std::string& topic) override;
+    void publish(Channel channel, const Twist& twist) override;
+    void subscribe(const std::string& topic, const PoseCallback& callback) override;
+
+    std::uint64_t published() const { return published_; }
+
+private:
+    std::size_t channels_;
+    std::uint64_t published_;
+};
+
+// Guarda el último Twist y el número de mensajes de cada canal; las poses
+// se inyectan con deliver()
+class MemoryTransport : public Transport
+{
+public:
+    Channel advertise(const std::string& topic) override;
+    void publish(Channel channel, const Twist& twist) override;
+    void subscribe(const std::string& topic, const PoseCallback& callback) override;
+
+    // Entrega una pose a los suscriptores del topic
+    void deliver(const std::string& topic, const Pose& pose) const;
+
+    std::size_t channels() const { return topics_.size(); }
+    const std::string& topic(Channel channel) const { return topics_[channel]; }
+    const Twist& last(Channel channel) const { return last_[channel]; }
+    std::uint64_t count(Channel channel) const { return counts_[channel]; }
+
+private:
+    std::vector<std::string> topics_;
+    std::vector<Twist> last_;
+    std::vector<std::uint64_t> counts_;
+    std::vector<std::pair<std::string, PoseCallback> > subscribers_;
+};
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_TRANSPORT_H
@@ -0,0 +1,33 @@
+#ifndef TURTLE_UNIDA_TWIST_H
+#define TURTLE_UNIDA_TWIST_H
+
+namespace turtle_unida
+{
+
+// Equivalente sin ROS de geometry_msgs/Vector3
+struct Vector3
+{
+    double x;
+    double y;
+    double z;
+};
+
+// Equivalente sin ROS de geometry_msgs/Twist (velocidad lineal y angular)
+struct Twist
+{
+    Vector3 linear;
+    Vector3 angular;
+};
+
+// Crea un Twist plano como el que publica mover.py (solo linear.x y angular.z)
+inline Twist makeTwist(double linear_x, double angular_z)
+{
+    Twist twist = Twist();
+    twist.linear.x = linear_x;
+    twist.angular.z = angular_z;
+    return twist;
+}
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_TWIST_H
@@ -0,0 +1,69 @@
+#ifndef TURTLE_UNIDA_TWIST_POOL_H
+#define TURTLE_UNIDA_TWIST_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <ros/serialization.h>
+
+#include "turtle_unida/twist.h"
+
+namespace turtle_unida
+{
+
+struct TwistPoolStats
+{
+    TwistPoolStats();
+
+    std::uint64_t written;  // mensajes escritos
+    std::uint64_t patched;  // campos reescritos (de 6 por mensaje)
+    std::uint64_t grown;    // buffers añadidos porque todos estaban en vuelo
+};
+
+// Buffers de geometry_msgs/Twist ya serializados para publicar sin reservar
+// memoria. Cada buffer se reserva una sola vez con su cabecera de longitud
+// y sus 6 float64; write() solo reescribe los campos que han cambiado
+// respecto a lo que ya contenía y devuelve un SerializedMessage que
+// comparte el buffer (solo incrementa el contador de referencias).
+//
+// Un buffer está en vuelo mientras roscpp guarde una referencia en su
+// cola de envío; write() usa el siguiente libre y solo reserva otro si
+// todos están en vuelo, así que en régimen estacionario no hay reservas.
+class TwistPool
+{
+public:
+    // Longitud serializada de geometry_msgs/Twist
+    static const std::uint32_t MESSAGE_SIZE = 6 * sizeof(double);
+
+    explicit TwistPool(std::size_t buffers = 8);
+
+    // Serializa twist en un buffer libre y devuelve el mensaje listo para publicar
+    const ros::SerializedMessage& write(const Twist& twist);
+
+    // Vuelve a escribir twist en el buffer del último write() (solo los campos
+    // que cambian), p. ej. con una marca tomada justo antes de publicarlo
+    void rewriteLast(const Twist& twist);
+
+    std::size_t size() const { return slots_.size(); }
+    const TwistPoolStats& stats() const { return stats_; }
+
+private:
+    struct Slot
+    {
+        ros::SerializedMessage message;
+        double fields[6];  // contenido actual del buffer
+    };
+
+    void addSlot();
+    void patch(Slot& slot, const Twist& twist);
+
+    std::vector<Slot> slots_;
+    std::size_t next_;
+    std::size_t last_;  // buffer del último write()
+    TwistPoolStats stats_;
+};
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_TWIST_POOL_H
@@ -0,0 +1,37 @@
+#ifndef TURTLE_UNIDA_ZYGOTE_H
+#define TURTLE_UNIDA_ZYGOTE_H
+
+#include <string>
+#include <vector>
+
+#include "turtle_unida/launcher.h"
+
+namespace turtle_unida
+{
+
+// Cliente del zigoto de los nodos en Python (src/zygote.py): un proceso
+// residente con el intérprete arrancado y rospy y geometry_msgs importados
+// que, por cada petición, hace fork y ejecuta el script en el hijo con los
+// argumentos, el entorno, el directorio y la entrada/salida del lanzador. El
+// protocolo está descrito en zygote.py.
+
+// Socket por defecto: $XDG_RUNTIME_DIR/turtle_unida-zygote o, si no está
+// definida, /tmp/turtle_unida-<uid>/zygote (directorio 0700 del usuario)
+std::string defaultZygoteSocket();
+
+// Conecta con el zigoto. Devuelve el descriptor, o -1 si no hay ninguno
+// escuchando en socket (para volver al lanzamiento normal). Lanza
+// std::runtime_error si el proceso que escucha es de otro usuario.
+int connectZygote(const std::string& socket);
+
+// Pide al zigoto de la conexión fd (que se cierra) que ejecute el script, le
+// reenvía todas las señales que recibe el lanzador (el hijo no está en su
+// grupo de procesos) y espera a que termine. Devuelve su código de salida.
+// Lanza std::runtime_error si el zigoto rechaza la petición o se cierra antes
+// de informar del final del hijo.
+int launchInZygote(int fd, const std::string& argv0, const std::string& script, const std::vector<std::string>& args,
+    LaunchTiming& timing);
+
+} // namespace turtle_unida
+
+#endif // TURTLE_UNIDA_ZYGOTE_H
@@ -0,0 +1,1249 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <geometry_msgs/Twist.h>
+#include <ros/serialization.h>
+
+#include "turtle_unida/command_log.h"
+#include "turtle_unida/avoidance.h"
+#include "turtle_unida/commander.h"
+#include "turtle_unida/controller.h"
+#include "turtle_unida/drawing.h"
+#include "turtle_unida/executor.h"
+#include "turtle_unida/fleet.h"
+#include "turtle_unida/histogram.h"
+#include "turtle_unida/launch_cache.h"
+#include "turtle_unida/launcher.h"
+#include "turtle_unida/parallel.h"
+#include "turtle_unida/publish_policy.h"
+#include "turtle_unida/shm_ring.h"
+#include "turtle_unida/sim_transport.h"
+#include "turtle_unida/spsc_ring.h"
+#include "turtle_unida/simulator.h"
+#include "turtle_unida/timer_wheel.h"
+#include "turtle_unida/trajectory.h"
+#include "turtle_unida/transport.h"
+#include "turtle_unida/twist_pool.h"
+#include "turtle_unida/zygote.h"
+
+using namespace turtle_unida;
+
+// Benchmarks del camino de los comandos. Cada resultado es una línea JSON
+// en la salida estándar para poder comparar ejecuciones entre commits:
+//
+//   rosrun turtle_unida bench --tag $(git rev-parse --short HEAD) > bench.jsonl
+//
+// No necesita roscore. Las semillas, los tiempos y el número de
+// repeticiones son fijos para que las ejecuciones sean comparables.
+
+typedef std::chrono::steady_clock Clock;
+
+struct Options
+{
+    Options() : repeats(15), sample_time(0.01), sim_seconds(60.0), roundtrips(20000) {}
+
+    std::string filter;   // solo los benchmarks cuyo nombre contiene este texto
+    std::string tag;      // se copia en cada resultado (p. ej. el commit)
+    int repeats;          // muestras por microbenchmark
+    double sample_time;   // duración mínima de cada muestra (s)
+    double sim_seconds;   // segundos simulados por macrobenchmark
+    int roundtrips;       // idas y vueltas por benchmark de transporte
+};
+
+// Destino de los resultados intermedios para que el compilador no elimine el trabajo
+static volatile double g_sink;
+
+static void keep(double value)
+{
+    g_sink = value;
+}
+
+static double secondsSince(Clock::time_point begin)
+{
+    return std::chrono::duration<double>(Clock::now() - begin).count();
+}
+
+static bool selected(const Options& options, const std::string& name)
+{
+    return options.filter.empty() || name.find(options.filter) != std::string::npos;
+}
+
+// El tag va dentro de una cadena JSON; se sustituyen los caracteres conflictivos
+static std::string jsonSafe(std::string text)
+{
+    for (std::size_t i = 0; i < text.size(); ++i)
+    {
+        if (text[i] == '"' || text[i] == '\\' || static_cast<unsigned char>(text[i]) < 0x20)
+        {
+            text[i] = '_';
+        }
+    }
+    return text;
+}
+
+// Ejecuta body(n) con n creciente hasta que una muestra dura sample_time
+// (sirve también de calentamiento) y después toma `repeats` muestras.
+// Se informa la mediana: es la medida más estable frente a interrupciones.
+template <class Body>
+static void runMicro(const Options& options, const std::string& name, Body body)
+{
+    if (!selected(options, name))
+    {
+        return;
+    }
+
+    std::uint64_t iterations = 1;
+    for (;;)
+    {
+        const Clock::time_point begin = Clock::now();
+        body(iterations);
+        if (secondsSince(begin) >= options.sample_time || iterations >= (1ull << 32))
+        {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    std::vector<double> per_op;
+    for (int r = 0; r < options.repeats; ++r)
+    {
+        const Clock::time_point begin = Clock::now();
+        body(iterations);
+        per_op.push_back(secondsSince(begin) * 1e9 / iterations);
+    }
+    std::sort(per_op.begin(), per_op.end());
+
+    printf("{\"bench\":\"%s\",\"kind\":\"micro\",\"tag\":\"%s\",\"iterations\":%llu,\"repeats\":%d,"
+           "\"ns_per_op\":%.3f,\"ns_per_op_min\":%.3f,\"ns_per_op_max\":%.3f}\n",
+        name.c_str(), jsonSafe(options.tag).c_str(), static_cast<unsigned long long>(iterations),
+        options.repeats, per_op[per_op.size() / 2], per_op.front(), per_op.back());
+    fflush(stdout);
+}
+
+// Evaluación de la tabla precalculada de cada tipo de trayectoria
+static void benchTrajectories(const Options& options)
+{
+    const char* types[] = {"circle", "lemniscate", "spiral", "quintic"};
+    for (std::size_t k = 0; k < sizeof(types) / sizeof(types[0]); ++k)
+    {
+        TrajectoryParams params;
+        params.type = types[k];
+        if (params.type == "quintic")
+        {
+            const double points[] = {0.0, 0.0, 2.0, 1.0, 4.0, -1.0, 6.0, 0.0, 8.0, 2.0};
+            params.points.assign(points, points + sizeof(points) / sizeof(points[0]));
+        }
+        const Trajectory trajectory = makeTrajectory(params);
+
+        runMicro(options, std::string("trajectory.sample/") + types[k], [&trajectory](std::uint64_t n) {
+            double sum = 0.0;
+            for (std::uint64_t i = 0; i < n; ++i)
+            {
+                const Twist twist = trajectory.sample(static_cast<double>(i & 0xffff) * 1e-3);
+                sum += twist.linear.x + twist.angular.z;
+            }
+            keep(sum);
+        });
+    }
+}
+
+// Generación y publicación de un comando, como en cada ciclo del commander
+static void benchCommander(const Options& options)
+{
+    for (int stamped = 0; stamped < 2; ++stamped)
+    {
+        NullTransport transport;
+        CommanderConfig config;
+        config.stamp = stamped != 0;
+        Commander commander(transport, config);
+
+        runMicro(options, stamped ? "commander.step/stamped" : "commander.step", [&commander](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i)
+            {
+                commander.step(static_cast<double>(i & 0xffff) * 1e-3);
+            }
+        });
+    }
+}
+
+// Serialización de geometry_msgs/Twist: la que hace roscpp en cada publish()
+// (reserva un buffer nuevo), la escritura en un buffer ya reservado y el
+// TwistPool de RosTransport, que solo reescribe los campos que cambian
+static void benchSerialization(const Options& options)
+{
+    geometry_msgs::Twist msg;
+    msg.linear.x = 2.0;
+    msg.angular.z = 1.5;
+
+    runMicro(options, "twist.serialize/message", [&msg](std::uint64_t n) {
+        double sum = 0.0;
+        for (std::uint64_t i = 0; i < n; ++i)
+        {
+            msg.linear.x = static_cast<double>(i);
+            const ros::SerializedMessage serialized = ros::serialization::serializeMessage(msg);
+            sum += serialized.num_bytes;
+        }
+        keep(sum);
+    });
+
+    std::vector<std::uint8_t> buffer(ros::serialization::serializationLength(msg));
+    runMicro(options, "twist.serialize/buffer", [&msg, &buffer](std::uint64_t n) {
+        double sum = 0.0;
+        for (std::uint64_t i = 0; i < n; ++i)
+        {
+            msg.linear.x = static_cast<double>(i);
+            ros::serialization::OStream stream(buffer.data(), static_cast<std::uint32_t>(buffer.size()));
+            ros::serialization::serialize(stream, msg);
+            sum += buffer[0];
+        }
+        keep(sum);
+    });
+
+    TwistPool pool;
+    runMicro(options, "twist.serialize/pool", [&pool](std::uint64_t n) {
+        double sum = 0.0;
+        for (std::uint64_t i = 0; i < n; ++i)
+        {
+            const ros::SerializedMessage& message = pool.write(makeTwist(static_cast<double>(i), 1.5));
+            sum += message.num_bytes;
+        }
+        keep(sum);
+    });
+}
+
+// Paso de comandos del hilo que planifica al que publica a través de una cola
+// con mutex y variable de condición, como la cola de publicación de roscpp,
+// y a través de una SpscRing. Cada muestra termina cuando el consumidor ha
+// vaciado la cola.
+static void benchQueueHandoff(const Options& options)
+{
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<Twist> queue;
+    bool stop = false;
+    std::atomic<std::uint64_t> consumed(0);
+
+    std::thread consumer([&]() {
+        double sum = 0.0;
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;)
+        {
+            ready.wait(lock, [&]() { return stop || !queue.empty(); });
+            if (queue.empty())
+            {
+                break;
+            }
+            sum += queue.front().linear.x;
+            queue.pop_front();
+            consumed.fetch_add(1, std::memory_order_release);
+        }
+        keep(sum);
+    });
+
+    std::uint64_t produced = 0;
+    runMicro(options, "queue.handoff/mutex", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                queue.push_back(makeTwist(static_cast<double>(i), 1.5));
+            }
+            ready.notify_one();
+        }
+        produced += n;
+        while (consumed.load(std::memory_order_acquire) < produced)
+        {
+            std::this_thread::yield();
+        }
+    });
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    ready.notify_one();
+    consumer.join();
+
+    // Lo mismo con una SpscRing: sin cerrojos
+    // ni llamadas al sistema; si la cola se llena o se vacía se cede el núcleo
+    SpscRing<Twist> ring(64);
+    std::atomic<bool> done(false);
+    consumed.store(0);
+    std::thread spsc_consumer([&]() {
+        double sum = 0.0;
+        Twist twist;
+        for (;;)
+        {
+            if (ring.tryPop(twist))
+            {
+                sum += twist.linear.x;
+                consumed.fetch_add(1, std::memory_order_release);
+            }
+            else if (done.load(std::memory_order_acquire))
+            {
+                break;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+        keep(sum);
+    });
+
+    produced = 0;
+    runMicro(options, "queue.handoff/spsc", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i)
+        {
+            const Twist twist = makeTwist(static_cast<double>(i), 1.5);
+            while (!ring.tryPush(twist))
+            {
+                std::this_thread::yield();
+            }
+        }
+        produced += n;
+        while (consumed.load(std::memory_order_acquire) < produced)
+        {
+            std::this_thread::yield();
+        }
+    });
+
+    done.store(true, std::memory_order_release);
+    spsc_consumer.join();
+}
+
+// Un ciclo completo de la flota (evaluar y publicar) con 1000 tortugas
+static void benchFleetTick(const Options& options)
+{
+    NullTransport transport;
+    Fleet fleet(transport);
+    const std::size_t trajectory = fleet.addTrajectory(makeTrajectory(TrajectoryParams()));
+    for (int i = 0; i < 1000; ++i)
+    {
+        fleet.addTurtle("/turtle" + std::to_string(i + 1) + "/cmd_vel", trajectory, 0.1 * i);
+    }
+
+    runMicro(options, "fleet.tick/1000", [&fleet](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i)
+        {
+            fleet.tick(static_cast<double>(i & 0xffff) * 1e-2);
+        }
+    });
+}
+
+// Flota de 1000 tortugas a 100 Hz con banda muerta y keep-alive: mensajes
+// que llegan al transporte con una trayectoria constante (círculo) y con
+// una que cambia siempre (lemniscata), y coste por publish() del filtro
+static void benchDeadband(const Options& options)
+{
+    const char* types[] = {"circle", "lemniscate"};
+    for (std::size_t k = 0; k < sizeof(types) / sizeof(types[0]); ++k)
+    {
+        const std::string name = std::string("publish.deadband/") + types[k];
+        if (!selected(options, name))
+        {
+            continue;
+        }
+
+        // Reloj simulado: el keep-alive cuenta segundos de la flota, no de la prueba
+        double now = 0.0;
+        NullTransport sink;
+        PublishPolicy policy;
+        DeadbandTransport transport(sink, policy, [&now]() { return now; });
+        Fleet fleet(transport);
+        TrajectoryParams params;
+        params.type = types[k];
+        const std::size_t trajectory = fleet.addTrajectory(makeTrajectory(params));
+        for (int i = 0; i < 1000; ++i)
+        {
+            fleet.addTurtle("/turtle" + std::to_string(i + 1) + "/cmd_vel", trajectory, 0.1 * i);
+        }
+
+        const double dt = 0.01;
+        const std::uint64_t ticks = static_cast<std::uint64_t>(options.sim_seconds / dt);
+        const Clock::time_point begin = Clock::now();
+        for (std::uint64_t t = 0; t < ticks; ++t)
+        {
+            now = t * dt;
+            fleet.tick(now);
+        }
+        const double wall = secondsSince(begin);
+
+        const PublishStats& stats = transport.stats();
+        const std::uint64_t total = stats.sent + stats.suppressed;
+        printf("{\"bench\":\"%s\",\"kind\":\"macro\",\"tag\":\"%s\",\"turtles\":1000,\"ticks\":%llu,"
+               "\"sent\":%llu,\"suppressed\":%llu,\"keep_alives\":%llu,\"sent_pct\":%.2f,"
+               "\"ns_per_command\":%.1f,\"wall_s\":%.3f}\n",
+            name.c_str(), jsonSafe(options.tag).c_str(), static_cast<unsigned long long>(ticks),
+            static_cast<unsigned long long>(stats.sent), static_cast<unsigned long long>(stats.suppressed),
+            static_cast<unsigned long long>(stats.keep_alives), total ? 100.0 * stats.sent / total : 0.0,
+            total ? wall * 1e9 / total : 0.0, wall);
+        fflush(stdout);
+    }
+}
+
+// Rueda de temporizadores con un millón pendientes: añadir y cancelar uno,
+// y un segundo simulado en pasos de 1 ms con periodos de 10 ms a 1 s (unos
+// 4,6 millones de vencimientos)
+static void benchTimerWheel(const Options& options)
+{
+    const int pending = 1000000;
+    std::uint32_t seed = 12345;
+    const auto random = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return (seed >> 8) / 16777216.0;
+    };
+
+    TimerWheel wheel;
+    std::uint64_t fired = 0;
+    for (int i = 0; i < pending; ++i)
+    {
+        const double period = 0.01 + 0.99 * random();
+        wheel.add(period * random(), period, [&fired]() { ++fired; });
+    }
+
+    runMicro(options, "timers.add_cancel/1000000", [&wheel, &random](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i)
+        {
+            wheel.cancel(wheel.add(1.0 + 3600.0 * random(), 0.0, []() {}));
+        }
+    });
+
+    const std::string name = "timers.expire/1000000";
+    if (!selected(options, name))
+    {
+        return;
+    }
+    const double seconds = std::min(options.sim_seconds, 1.0);
+    Histogram step;
+    const Clock::time_point begin = Clock::now();
+    for (double now = 0.001; now <= seconds + 1e-9; now += 0.001)
+    {
+        const Clock::time_point tick = Clock::now();
+        wheel.advance(now);
+        step.record(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - tick).count()));
+    }
+    const double wall = secondsSince(begin);
+
+    printf("{\"bench\":\"%s\",\"kind\":\"macro\",\"tag\":\"%s\",\"pending\":%zu,\"sim_s\":%.3f,"
+           "\"expired\":%llu,\"cascaded\":%llu,\"ns_per_expiry\":%.1f,\"step_us_p50\":%.1f,"
+           "\"step_us_p99\":%.1f,\"wall_s\":%.3f}\n",
+        name.c_str(), jsonSafe(options.tag).c_str(), wheel.size(), seconds, static_cast<unsigned long long>(fired),
+        static_cast<unsigned long long>(wheel.stats().cascaded), fired ? wall * 1e9 / fired : 0.0,
+        step.percentile(0.5) * 1e-3, step.percentile(0.99) * 1e-3, wall);
+    fflush(stdout);
+}
+
+// TimerService con temporizadores de una vez repartidos en 1 s: el hilo de
+// despacho debe despertar una vez por vencimiento distinto y no más
+static void benchTimerService(const Options& options)
+{
+    const std::string name = "timers.service";
+    if (!selected(options, name))
+    {
+        return;
+    }
+
+    const int count = 1000;
+    const double span = 1.0;
+    Histogram lateness;
+    std::mutex mutex;
+    std::condition_variable done;
+    int remaining = count;
+    TimerService service;
+    const Clock::time_point begin = Clock::now();
+    for (int i = 0; i < count; ++i)
+    {
+        // Dos temporizadores por instante: 500 vencimientos distintos
+        const double delay = span * (i / 2) / (count / 2);
+        const Clock::time_point due =
+            begin + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(delay));
+        service.after(delay - secondsSince(begin), [&, due]() {
+            lateness.record(static_cast<std::uint64_t>(std::max<std::int64_t>(
+                0, std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - due).count())));
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--remaining == 0)
+            {
+                done.notify_one();
+            }
+        });
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&remaining]() { return remaining == 0; });
+    }
+    const TimerStats stats = service.stats();
+
+    printf("{\"bench\":\"%s\",\"kind\":\"macro\",\"tag\":\"%s\",\"timers\":%d,\"deadlines\":%d,"
+           "\"wakeups\":%llu,\"late_us_p50\":%.1f,\"late_us_p99\":%.1f,\"late_us_max\":%.1f}\n",
+        name.c_str(), jsonSafe(options.tag).c_str(), count, count / 2,
+        static_cast<unsigned long long>(stats.wakeups), lateness.percentile(0.5) * 1e-3,
+        lateness.percentile(0.99) * 1e-3, lateness.max() * 1e-3);
+    fflush(stdout);
+}
+
+// Un ciclo de persecución pura sobre un camino de `points` puntos que da
+// ocho vueltas a un círculo; la pose avanza por el camino con un desvío fijo
+static void benchPurePursuit(const Options& options, int points)
+{
+    const std::string name = "controller.pure_pursuit/" + std::to_string(points);
+    if (!selected(options, name))
+    {
+        return;
+    }
+
+    std::vector<double> path;
+    const double turns = 8.0;
+    for (int i = 0; i < points; ++i)
+    {
+        const double angle = 2.0 * M_PI * turns * i / (points - 1);
+        path.push_back(5.5 + 4.0 * std::cos(angle));
+        path.push_back(5.5 + 4.0 * std::sin(angle));
+    }
+    PurePursuitController controller(path, 0.5, 1.0, ControllerGains());
+    const double length = controller.path().length();
+
+    double s = 0.0;
+    runMicro(options, name, [&](std::uint64_t n) {
+        double sum = 0.0;
+        for (std::uint64_t i = 0; i < n; ++i)
+        {
+            // Unos 2 cm por ciclo, como a 1 m/s y 62.5 Hz
+            s += 0.016;
+            if (s > length - 1.0)
+            {
+                s = 0.0;
+                controller.reset();
+            }
+            const PathPoint point = controller.path().at(s);
+            Pose pose = Pose();
+            pose.x = point.x + 0.05;
+            pose.y = point.y;
+            const Twist twist = controller.update(pose);
+            sum += twist.linear.x + twist.angular.z;
+        }
+        keep(sum);
+    });
+}
+
+// Transporte del benchmark de controladores: entrega poses por índice de
+// suscripción sin buscar el topic y solo cuenta los comandos
+class PoseFeed : public Transport
+{
+public:
+    PoseFeed() : channels_(0), published_(0) {}
+
+    Channel advertise(const std::string&) override { return channels_++; }
+    void publish(Channel, const Twist& twist) override { published_ += twist.linear.x != 0.0; }
+    void subscribe(const std::string&, const PoseCallback& callback) override { callbacks_.push_back(callback); }
+
+    void deliver(std::size_t subscriber, const Pose& pose) const { callbacks_[subscriber](pose); }
+    std::uint64_t published() const { return published_; }
+
+private:
+    std::size_t channels_;
+    std::uint64_t published_;
+    std::vector<PoseCallback> callbacks_;
+};
+
+// Un ciclo de ControllerGroup con `count` tortugas de coste desigual: la
+// primera cuarta parte sigue un camino con persecución pura y el resto
+// mantiene un rumbo, así que el reparto estático deja un hilo con casi todo
+// el trabajo. Se compara un hilo, cuatro con robo y cuatro en modo determinista.
+static void benchControllerGroup(const Options& options, int count)
+{
+    const std::string name = "executor.controllers/" + std::to_string(count);
+    if (!selected(options, name))
+    {
+        return;
+    }
+
+    std::vector<double> path;
+    for (int i = 0; i < 10000; ++i)
+    {
+        const double angle = 2.0 * M_PI * 8.0 * i / 9999.0;
+        path.push_back(5.5 + 4.0 * std::cos(angle));
+        path.push_back(5.5 + 4.0 * std::sin(angle));
+    }
+
+    struct Variant
+    {
+        int threads;
+        bool deterministic;
+    };
+    const Variant variants[] = {{1, false}, {4, false}, {4, true}};
+    const std::uint64_t ticks = static_cast<std::uint64_t>(std::min(options.sim_seconds, 5.0) * 100.0);
+    for (std::size_t v = 0; v < sizeof(variants) / sizeof(variants[0]); ++v)
+    {
+        ExecutorConfig config;
+        config.threads = variants[v].threads;
+        config.deterministic = variants[v].deterministic;
+        WorkStealingExecutor executor(config);
+        PoseFeed feed;
+        ControllerGroup group(feed, executor);
+        for (int i = 0; i < count; ++i)
+        {
+            const std::string turtle = "/turtle" + std::to_string(i + 1) + "/";
+            std::unique_ptr<Controller> controller;
+            if (i < count / 4)
+            {
+                controller.reset(new PurePursuitController(path, 0.5, 1.0, ControllerGains()));
+            }
+            else
+            {
+                controller.reset(new HeadingHoldController(0.1 * i, 1.0, ControllerGains()));
+            }
+            group.add(std::move(controller), turtle + "pose", turtle + "cmd_vel");
+        }
+
+        Histogram tick;
+        for (std::uint64_t t = 0; t < ticks; ++t)
+        {
+            // Cada tortuga avanza unos 2 cm por ciclo a lo largo del círculo
+            for (int i = 0; i < count; ++i)
+            {
+                const double angle = 0.005 * static_cast<double>(t) + 0.001 * i;
+                Pose pose = Pose();
+                pose.x = 5.5 + 4.05 * std::cos(angle);
+                pose.y = 5.5 + 4.05 * std::sin(angle);
+                pose.theta = angle + M_PI / 2.0;
+                feed.deliver(static_cast<std::size_t>(i), pose);
+            }
+            const Clock::time_point begin = Clock::now();
+            group.tick();
+            tick.record(static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count()));
+        }
+        keep(static_cast<double>(feed.published()));
+
+        WorkerStats busiest;
+        for (int w = 0; w < executor.threads(); ++w)
+        {
+            if (executor.stats(w).busy_time > busiest.busy_time)
+            {
+                busiest = executor.stats(w);
+            }
+        }
+        double busy = 0.0;
+        std::uint64_t steals = 0;
+        for (int w = 0; w < executor.threads(); ++w)
+        {
+            busy += executor.stats(w).busy_time;
+            steals += executor.stats(w).steals;
+        }
+
+        printf("{\"bench\":\"%s\",\"kind\":\"macro\",\"tag\":\"%s\",\"threads\":%d,\"deterministic\":%s,"
+               "\"ticks\":%llu,\"tick_us_p50\":%.1f,\"tick_us_p99\":%.1f,\"tick_us_max\":%.1f,\"steals\":%llu,"
+               "\"balance\":%.3f}\n",
+            name.c_str(), jsonSafe(options.tag).c_str(), executor.threads(),
+            variants[v].deterministic ? "true" : "false", static_cast<unsigned long long>(ticks),
+            tick.percentile(0.5) * 1e-3, tick.percentile(0.99) * 1e-3, tick.max() * 1e-3,
+            static_cast<unsigned long long>(steals),
+            busiest.busy_time > 0.0 ? busy / (executor.threads() * busiest.busy_time) : 1.0);
+        fflush(stdout);
+    }
+}
+
+// La flota mueve `count` tortugas del simulador sin ventana, un comando por
+// tortuga y paso, tan rápido como sea posible. Mide el ciclo completo
+// comando + integración + entrega de poses.
+static void benchSimulation(const Options& options, int count)
+{
+    const std::string name = "sim.fleet/" + std::to_string(count);
+    if (!selected(options, name))
+    {
+        return;
+    }
+
+    SimulatorConfig config;
+    Simulator simulator(config);
+    SimTransport transport(simulator);
+    Fleet fleet(transport);
+    const std::size_t trajectory = fleet.addTrajectory(makeTrajectory(TrajectoryParams()));
+    const int side = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count))));
+    const double spacing = config.world_size / (side + 1);
+    double received = 0.0;
+    for (int i = 0; i < count; ++i)
+    {
+        const std::string turtle = "turtle" + std::to_string(i + 1);
+        transport.spawn(turtle, spacing * (1 + i % side), spacing * (1 + i / side), 0.0);
+        transport.subscribe("/" + turtle + "/pose", [&received](const Pose& pose) { received += pose.x; });
+        fleet.addTurtle("/" + turtle + "/cmd_vel", trajectory, 0.1 * i);
+    }
+
+    Histogram step;
+    const std::uint64_t steps = static_cast<std::uint64_t>(options.sim_seconds / config.dt);
+    const Clock::time_point begin = Clock::now();
+    for (std::uint64_t i = 0; i < steps; ++i)
+    {
+        const Clock::time_point tick = Clock::now();
+        fleet.tick(simulator.time());
+        transport.step();
+        step.record(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - tick).count()));
+    }
+    const double wall = secondsSince(begin);
+    keep(received);
+
+    printf("{\"bench\":\"%s\",\"kind\":\"macro\",\"tag\":\"%s\",\"turtles\":%d,\"steps\":%llu,\"sim_s\":%.3f,"
+           "\"wall_s\":%.6f,\"turtle_s_per_wall_s\":%.0f,\"step_ns_p50\":%llu,\"step_ns_p99\":%llu,"
+           "\"step_ns_p999\":%llu,\"step_ns_max\":%llu}\n",
+        name.c_str(), jsonSafe(options.tag).c_str(), count, static_cast<unsigned long long>(steps),
+        simulator.time(), wall, count * simulator.time() / wall,
+        static_cast<unsigned long long>(step.percentile(0.5)), static_cast<unsigned long long>(step.percentile(0.99)),
+        static_cast<unsigned long long>(step.percentile(0.999)), static_cast<unsigned long long>(step.max()));
+    fflush(stdout);
+}
+
+// `count` tortugas en una rejilla de 1 m con rumbos repartidos por el ángulo
+// áureo, todas avanzando a 1 m/s, en un mundo a su medida y a 100 Hz. Se
+// ejecuta con y sin evitación de colisiones: mide el coste de apply() por
+// ciclo y cuenta los pares que se solapan (a menos de dos radios) en cada ciclo.
+static void benchAvoidance(const Options& options, int count)
+{
+    const std::string name = "avoid.tick/" + std::to_string(count);
+    if (!selected(options, name))
+    {
+        return;
+    }
+
+    const int side = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count))));
+    AvoidanceConfig avoid_config;
+    avoid_config.dt = 0.01;
+    SimulatorConfig sim_config;
+    sim_config.world_size = side + 2.0;
+    sim_config.dt = avoid_config.dt;
+    sim_config.command_timeout = INFINITY;
+    const double contact = 2.0 * avoid_config.radius;
+    const std::uint64_t ticks = static_cast<std::uint64_t>(std::min(options.sim_seconds, 5.0) / sim_config.dt);
+
+    for (int enabled = 1; enabled >= 0; --enabled)
+    {
+        Simulator simulator(sim_config);
+        CollisionAvoidance avoidance(avoid_config);
+        SpatialHash overlaps(contact, static_cast<std::size_t>(count));
+        for (int i = 0; i < count; ++i)
+        {
+            simulator.spawn(1.5 + i % side, 1.5 + i / side, 2.399963 * i);
+            avoidance.add();
+        }
+
+        std::vector<double> linear(count);
+        std::vector<double> angular(count);
+        Histogram apply;
+        std::uint64_t overlapping = 0;
+        const Clock::time_point begin = Clock::now();
+        for (std::uint64_t t = 0; t < ticks; ++t)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                avoidance.setPose(i, simulator.pose(i));
+                linear[i] = 1.0;
+                angular[i] = i % 2 == 0 ? 0.2 : -0.2;
+            }
+            if (enabled)
+            {
+                const Clock::time_point tick = Clock::now();
+                avoidance.apply(linear.data(), angular.data());
+                apply.record(static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - tick).count()));
+            }
+            for (int i = 0; i < count; ++i)
+            {
+                simulator.command(i, makeTwist(linear[i], angular[i]));
+            }
+            simulator.step();
+
+            // Pares solapados tras el paso (cada par se cuenta una vez)
+            for (int i = 0; i < count; ++i)
+            {
+                const Pose pose = simulator.pose(i);
+                overlaps.update(i, pose.x, pose.y);
+            }
+            for (int i = 0; i < count; ++i)
+            {
+                const Pose a = simulator.pose(i);
+                overlaps.query(a.x, a.y, contact, [&](std::uint32_t j) {
+                    if (static_cast<int>(j) > i)
+                    {
+                        const Pose b = simulator.pose(j);
+                        overlapping += (a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y) < contact * contact;
+                    }
+                });
+            }
+        }
+        const double wall = secondsSince(begin);
+
+        printf("{\"bench\":\"%s\",\"kind\":\"macro\",\"tag\":\"%s\",\"avoid\":%s,\"turtles\":%d,"
+               "\"ticks\":%llu,\"threads\":%d,\"overlap_pairs_per_tick\":%.2f,\"apply_us_p50\":%.1f,"
+               "\"apply_us_p99\":%.1f,\"apply_us_max\":%.1f,\"neighbors_per_turtle\":%.2f,\"wall_s\":%.3f}\n",
+            name.c_str(), jsonSafe(options.tag).c_str(), enabled ? "true" : "false", count,
+            static_cast<unsigned long long>(ticks), threadCount(avoid_config.threads),
+            static_cast<double>(overlapping) / ticks, apply.percentile(0.5) * 1e-3, apply.percentile(0.99) * 1e-3,
+            apply.max() * 1e-3,
+            enabled ? static_cast<double>(avoidance.stats().neighbors) / (static_cast<double>(ticks) * count) : 0.0,
+            wall);
+        fflush(stdout);
+    }
+}
+
+// Imagen sintética de size x size con anillos y un tablero de cuadros
+// pequeños (muchos contornos cortos); se planifica con una banda, con 4 y
+// con una por núcleo para ver el paralelismo de cada fase
+static void benchDrawing(const Options& options, int size)
+{
+    const std::string name = "draw.pipeline/" + std::to_string(size);
+    if (!selected(options, name))
+    {
+        return;
+    }
+
+    Bitmap bitmap;
+    bitmap.width = size;
+    bitmap.height = size;
+    bitmap.pixels.assign(static_cast<std::size_t>(size) * size, 255);
+    const double center = 0.5 * size;
+    for (int y = 0; y < size; ++y)
+    {
+        for (int x = 0; x < size; ++x)
+        {
+            const double r = std::sqrt((x - center) * (x - center) + (y - center) * (y - center));
+            const bool ring = static_cast<int>(r / (size / 32.0)) % 2 == 1 && r < 0.45 * size;
+            const bool checker = x < size / 4 && y < size / 4 && ((x / 8 + y / 8) % 2 == 0);
+            if (ring || checker)
+            {
+                bitmap.pixels[static_cast<std::size_t>(y) * size + x] = 0;
+            }
+        }
+    }
+
+    const int tiles[] = {1, 4, 0};
+    for (std::size_t k = 0; k < sizeof(tiles) / sizeof(tiles[0]); ++k)
+    {
+        DrawingConfig config;
+        config.tiles = tiles[k];
+        const Clock::time_point begin = Clock::now();
+        const DrawingPlan plan = planDrawing(bitmap, config);
+        const double wall = secondsSince(begin);
+        const DrawingStats& stats = plan.stats;
+        keep(stats.travel_after);
+
+        printf("{\"bench\":\"%s\",\"kind\":\"macro\",\"tag\":\"%s\",\"tiles\":%d,\"contours\":%llu,"
+               "\"strokes\":%llu,\"points_in\":%llu,\"points_out\":%llu,\"travel_before_m\":%.1f,"
+               "\"travel_after_m\":%.1f,\"contour_ms\":%.3f,\"simplify_ms\":%.3f,\"order_ms\":%.3f,"
+               "\"emit_ms\":%.3f,\"wall_s\":%.6f}\n",
+            name.c_str(), jsonSafe(options.tag).c_str(), stats.tiles, static_cast<unsigned long long>(stats.contours),
+            static_cast<unsigned long long>(stats.strokes), static_cast<unsigned long long>(stats.points_in),
+            static_cast<unsigned long long>(stats.points_out), stats.travel_before, stats.travel_after,
+            stats.contour_time * 1e3, stats.simplify_time * 1e3, stats.order_time * 1e3, stats.emit_time * 1e3,
+            wall);
+        fflush(stdout);
+    }
+}
+
+#if defined(__linux__)
+
+static double cpuSeconds()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + 1e-6 * (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+// Ejecuta `roundtrips` idas y vueltas con send() y receive() y escribe el
+// tiempo de ida y vuelta y el tiempo de CPU del proceso (los dos hilos)
+template <class Send, class Receive>
+static void runRoundtrips(const Options& options, const std::string& name, Send send, Receive receive)
+{
+    Histogram rtt;
+    const double cpu_begin = cpuSeconds();
+    const Clock::time_point begin = Clock::now();
+    for (int i = 0; i < options.roundtrips; ++i)
+    {
+        const Clock::time_point sent = Clock::now();
+        send(static_cast<double>(i));
+        receive();
+        rtt.record(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - sent).count()));
+    }
+    const double wall = secondsSince(begin);
+    const double cpu = cpuSeconds() - cpu_begin;
+
+    printf("{\"bench\":\"%s\",\"kind\":\"transport\",\"tag\":\"%s\",\"roundtrips\":%d,\"wall_s\":%.6f,"
+           "\"rtt_ns_p50\":%llu,\"rtt_ns_p99\":%llu,\"rtt_ns_p999\":%llu,\"rtt_ns_max\":%llu,"
+           "\"cpu_ns_per_roundtrip\":%.0f}\n",
+        name.c_str(), jsonSafe(options.tag).c_str(), options.roundtrips, wall,
+        static_cast<unsigned long long>(rtt.percentile(0.5)), static_cast<unsigned long long>(rtt.percentile(0.99)),
+        static_cast<unsigned long long>(rtt.percentile(0.999)), static_cast<unsigned long long>(rtt.max()),
+        cpu * 1e9 / options.roundtrips);
+    fflush(stdout);
+}
+
+static bool readFull(int fd, void* data, std::size_t size)
+{
+    std::uint8_t* bytes = static_cast<std::uint8_t*>(data);
+    while (size > 0)
+    {
+        const ssize_t n = read(fd, bytes, size);
+        if (n <= 0)
+        {
+            return false;
+        }
+        bytes += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+// Ida y vuelta de un Twist entre dos hilos por TCP en loopback con
+// TCP_NODELAY y la trama de TCPROS (longitud + 48 bytes), como hace roscpp
+static void benchSocketRoundtrip(const Options& options)
+{
+    const std::string name = "transport.roundtrip/socket";
+    if (!selected(options, name))
+    {
+        return;
+    }
+
+    const int listener = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (listener < 0 || bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listener, 1) != 0 || getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) != 0)
+    {
+        fprintf(stderr, "%s: no se pudo abrir el socket\n", name.c_str());
+        return;
+    }
+    const int client = socket(AF_INET, SOCK_STREAM, 0);
+    if (connect(client, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        fprintf(stderr, "%s: no se pudo conectar\n", name.c_str());
+        close(listener);
+        return;
+    }
+    const int server = accept(listener, nullptr, nullptr);
+    const int one = 1;
+    setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    setsockopt(server, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    const std::size_t frame = 4 + 6 * sizeof(double);
+    std::thread echo([server, frame]() {
+        std::uint8_t buffer[64];
+        while (readFull(server, buffer, frame) && write(server, buffer, frame) == static_cast<ssize_t>(frame))
+        {
+        }
+    });
+
+    std::uint8_t buffer[64] = {0};
+    const std::uint32_t size = 6 * sizeof(double);
+    std::memcpy(buffer, &size, 4);
+    runRoundtrips(options, name,
+        [client, &buffer, frame](double value) {
+            std::memcpy(buffer + 4, &value, sizeof(value));
+            if (write(client, buffer, frame) != static_cast<ssize_t>(frame))
+            {
+                perror("write");
+            }
+        },
+        [client, &buffer, frame]() { readFull(client, buffer, frame); });
+
+    close(client);
+    echo.join();
+    close(server);
+    close(listener);
+}
+
+// La misma ida y vuelta con dos ShmRing, esperando en su futex
+static void benchShmRoundtrip(const Options& options)
+{
+    const std::string name = "transport.roundtrip/shm";
+    if (!selected(options, name))
+    {
+        return;
+    }
+
+    const std::string prefix = "/turtle_unida.bench." + std::to_string(getpid());
+    std::unique_ptr<ShmRing> ping = ShmRing::create(prefix + ".ping");
+    std::unique_ptr<ShmRing> pong = ShmRing::create(prefix + ".pong");
+    std::unique_ptr<ShmRing> ping_reader = ShmRing::open(ping->name());
+    std::unique_ptr<ShmRing> pong_reader = ShmRing::open(pong->name());
+    std::atomic<bool> stop(false);
+
+    std::thread echo([&]() {
+        ShmRing::Record record;
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            ping_reader->wait(0.1);
+            while (ping_reader->next(record))
+            {
+                pong->write(record);
+            }
+        }
+    });
+
+    ShmRing::Record record = ShmRing::Record();
+    runRoundtrips(options, name,
+        [&ping, &record](double value) {
+            record.values[0] = value;
+            ping->write(record);
+        },
+        [&pong_reader, &record]() {
+            while (!pong_reader->next(record))
+            {
+                pong_reader->wait(1.0);
+            }
+        });
+
+    stop = true;
+    echo.join();
+}
+
+// Grabar un comando en el log mapeado en memoria y buscar un instante en un
+// log de un millón de registros
+static void benchCommandLog(const Options& options)
+{
+    if (!selected(options, "log.append") && !selected(options, "log.seek"))
+    {
+        return;
+    }
+
+    const std::string path = "/tmp/turtle_unida_bench." + std::to_string(getpid()) + ".log";
+    {
+        CommandLogWriter log(path, 16);
+        const std::uint32_t topic = log.addTopic("/turtle1/cmd_vel");
+        Twist twist;
+        runMicro(options, "log.append", [&log, &twist, topic](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i)
+            {
+                twist.linear.x = static_cast<double>(i);
+                log.append(LOG_TWIST, topic, twist);
+            }
+        });
+        while (log.records() < 1000000)
+        {
+            log.append(LOG_TWIST, topic, twist);
+        }
+    }
+
+    CommandLogReader reader(path);
+    const std::uint64_t duration = reader.duration();
+    runMicro(options, "log.seek", [&reader, duration](std::uint64_t n) {
+        std::uint64_t time = 0;
+        for (std::uint64_t i = 0; i < n; ++i)
+        {
+            time = (time + 0x9e3779b97f4a7c15ull) % (duration + 1);
+            keep(static_cast<double>(reader.seek(time)));
+        }
+    });
+    unlink(path.c_str());
+}
+
+// Arranque de un script con el lanzador nativo, fase a fase: un script de sh
+// que termina enseguida (coste del propio lanzador y de posix_spawn) y uno de
+// Python que solo importa sys (arranque del intérprete)
+static void benchLaunch(const Options& options)
+{
+    const std::string dir = "/tmp/turtle_unida_bench." + std::to_string(getpid());
+
+    // Resolución del intérprete: leer el shebang frente a la caché (un stat)
+    if (selected(options, "launch.resolve/shebang") || selected(options, "launch.resolve/cache"))
+    {
+        mkdir(dir.c_str(), 0700);
+        const std::string script = dir + "/resolver.py";
+        std::FILE* file = std::fopen(script.c_str(), "w");
+        std::fputs("#!/usr/bin/env python3\nimport sys\n", file);
+        std::fclose(file);
+
+        runMicro(options, "launch.resolve/shebang", [&script](std::uint64_t n) {
+            std::size_t sum = 0;
+            for (std::uint64_t i = 0; i < n; ++i)
+            {
+                sum += getPythonExecutable(script).size();
+            }
+            keep(static_cast<double>(sum));
+        });
+        LaunchCache cache;
+        runMicro(options, "launch.resolve/cache", [&script, &cache](std::uint64_t n) {
+            std::size_t sum = 0;
+            bool cached = false;
+            for (std::uint64_t i = 0; i < n; ++i)
+            {
+                sum += cache.interpreter(script, cached).size() + cached;
+            }
+            keep(static_cast<double>(sum));
+        });
+        std::remove(script.c_str());
+        rmdir(dir.c_str());
+    }
+
+    // La caché en memoria, como la usaría un supervisor que relanza nodos, y
+    // el zigoto solo si hay uno escuchando (rosrun turtle_unida src/zygote.py)
+    const char* kinds[] = {"sh", "sh-cached", "python", "python-zygote"};
+    const char* python = "#!/usr/bin/env python3\nimport sys\n";
+    const char* bodies[] = {"#!/bin/sh\nexit 0\n", "#!/bin/sh\nexit 0\n", python, python};
+    const std::string zygote = defaultZygoteSocket();
+    for (int k = 0; k < 4; ++k)
+    {
+        const std::string name = std::string("launch.spawn/") + kinds[k];
+        if (!selected(options, name))
+        {
+            continue;
+        }
+        if (k == 3)
+        {
+            const int probe = connectZygote(zygote);
+            if (probe < 0)
+            {
+                continue;
+            }
+            close(probe);
+        }
+        mkdir(dir.c_str(), 0700);
+        const std::string node = dir + "/nodo";
+        {
+            std::FILE* file = std::fopen((node + ".py").c_str(), "w");
+            std::fputs(bodies[k], file);
+            std::fclose(file);
+        }
+
+        const int launches = k != 2 ? std::max(20, options.roundtrips / 100) : std::max(5, options.roundtrips / 1000);
+        LaunchCache cache;
+        Histogram resolve;
+        Histogram spawn;
+        Histogram total;
+        int failed = 0;
+        for (int i = 0; i < launches; ++i)
+        {
+            LaunchTiming timing;
+            try
+            {
+                const std::vector<std::string> args;
+                const int fd = k == 3 ? connectZygote(zygote) : -1;
+                const int code = fd >= 0 ? launchInZygote(fd, node, "", args, timing)
+                                         : launchScript(node, "", args, timing, k == 1 ? &cache : nullptr);
+                failed += code != 0 || (k == 3 && fd < 0);
+            }
+            catch (const std::exception&)
+            {
+                ++failed;
+                continue;
+            }
+            resolve.recordSeconds(timing.executable + timing.script + timing.interpreter);
+            spawn.recordSeconds(timing.spawn);
+            total.recordSeconds(timing.executable + timing.script + timing.interpreter + timing.spawn + timing.run);
+        }
+        std::remove((node + ".py").c_str());
+        rmdir(dir.c_str());
+
+        printf("{\"bench\":\"%s\",\"kind\":\"macro\",\"tag\":\"%s\",\"launches\":%d,\"failed\":%d,"
+               "\"resolve_us_p50\":%.1f,\"spawn_us_p50\":%.1f,\"spawn_us_p99\":%.1f,\"total_us_p50\":%.1f,"
+               "\"total_us_p99\":%.1f}\n",
+            name.c_str(), jsonSafe(options.tag).c_str(), launches, failed, resolve.percentile(0.5) * 1e-3,
+            spawn.percentile(0.5) * 1e-3, spawn.percentile(0.99) * 1e-3, total.percentile(0.5) * 1e-3,
+            total.percentile(0.99) * 1e-3);
+        fflush(stdout);
+    }
+}
+
+#endif
+
+static void usage()
+{
+    fprintf(stderr,
+        "uso: bench [--filter texto] [--tag texto] [--repeats n] [--sim-seconds s] [--quick]\n"
+        "  una línea JSON por benchmark en la salida estándar\n");
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--filter") == 0 && has_value)
+        {
+            options.filter = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--tag") == 0 && has_value)
+        {
+            options.tag = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--repeats") == 0 && has_value)
+        {
+            options.repeats = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--sim-seconds") == 0 && has_value)
+        {
+            options.sim_seconds = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--quick") == 0)
+        {
+            // Para comprobar que todo funciona, no para comparar resultados
+            options.repeats = 3;
+            options.sample_time = 0.002;
+            options.sim_seconds = 5.0;
+            options.roundtrips = 2000;
+        }
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    benchTrajectories(options);
+    benchCommander(options);
+    benchSerialization(options);
+    benchQueueHandoff(options);
+    benchFleetTick(options);
+    benchDeadband(options);
+    benchTimerWheel(options);
+    benchTimerService(options);
+    benchPurePursuit(options, 1000);
+    benchPurePursuit(options, 1000000);
+    benchControllerGroup(options, 10000);
+
+    const int counts[] = {1, 10, 100, 1000};
+    for (std::size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); ++i)
+    {
+        benchSimulation(options, counts[i]);
+    }
+    benchAvoidance(options, 1000);
+    benchAvoidance(options, 10000);
+    benchDrawing(options, 2048);
+
+#if defined(__linux__)
+    benchSocketRoundtrip(options);
+    benchShmRoundtrip(options);
+    benchCommandLog(options);
+    benchLaunch(options);
+#endif
+    return 0;
+}
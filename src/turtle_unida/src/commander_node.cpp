@@ -0,0 +1,271 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <ros/ros.h>
+
+#include "turtle_unida/command_log.h"
+#include "turtle_unida/commander.h"
+#include "turtle_unida/config_file.h"
+#include "turtle_unida/publish_policy.h"
+#include "turtle_unida/ros_params.h"
+#include "turtle_unida/ros_transport.h"
+#include "turtle_unida/sim_transport.h"
+#include "turtle_unida/timer_wheel.h"
+
+using namespace turtle_unida;
+
+// Ejecuta el commander sin roscore durante los segundos indicados, con el
+// simulador en el mismo proceso como receptor de los comandos
+static int runHeadless(double seconds, bool pipeline)
+{
+    Simulator simulator((SimulatorConfig()));
+    SimTransport transport(simulator);
+    transport.spawn("turtle1", 5.544445, 5.544445, 0.0);
+
+    CommanderConfig config;
+    config.stamp = true;
+    config.pipeline = pipeline;
+    Commander commander(transport, config);
+    PeriodicScheduler scheduler((SchedulerConfig()));
+
+    commander.run(scheduler, [&scheduler, seconds]() { return scheduler.time() < seconds; });
+
+    printf("%s %s\n", commander.stats().summary().c_str(), scheduler.stats().summary().c_str());
+    printf("latency %s\n", transport.latency().summary().c_str());
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    // --headless [segundos] [--pipeline]: prueba el bucle sin ROS master
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--headless") == 0)
+        {
+            double seconds = 5.0;
+            bool pipeline = false;
+            for (int j = i + 1; j < argc; ++j)
+            {
+                if (std::strcmp(argv[j], "--pipeline") == 0)
+                {
+                    pipeline = true;
+                }
+                else
+                {
+                    seconds = std::atof(argv[j]);
+                }
+            }
+            return runHeadless(seconds, pipeline);
+        }
+    }
+
+    // Inicializa el nodo de ROS llamado "commander"
+    ros::init(argc, argv, "commander");
+    ros::NodeHandle nh;
+    ros::NodeHandle pnh("~");
+
+    // Mismos valores por defecto que mover.py, configurables por parámetro
+    CommanderConfig config;
+    SchedulerConfig loop;
+    double stats_period = 10.0;
+    pnh.param("topic", config.topic, config.topic);
+    pnh.param("stats_period", stats_period, stats_period);
+    pnh.param("stamp", config.stamp, config.stamp);
+    pnh.param("pipeline", config.pipeline, config.pipeline);
+    bool shared_memory = false;
+    pnh.param("shared_memory", shared_memory, shared_memory);
+    std::string record;
+    pnh.param("record", record, record);
+    try
+    {
+        readSchedulerParams(pnh, loop);
+    }
+    catch (const std::invalid_argument& e)
+    {
+        ROS_ERROR("Planificador no válido: %s", e.what());
+        return 1;
+    }
+    PublishPolicy policy;
+    const bool use_deadband = readPublishPolicyParams(pnh, policy);
+    readTrajectoryParams(pnh, config.trajectory);
+    double reload_period = 1.0;
+    std::string config_file;
+    pnh.param("reload_period", reload_period, reload_period);
+    pnh.param("config_file", config_file, config_file);
+
+    // ~config_file: la trayectoria del fichero tiene prioridad sobre los parámetros
+    const TrajectoryParams server_params = config.trajectory;
+    FileWatcher watcher(config_file);
+    if (!config_file.empty())
+    {
+        // Un fichero que no existe es un error, como uno que no se entiende
+        watcher.changed();
+        try
+        {
+            readTrajectoryFile(config_file, config.trajectory);
+        }
+        catch (const std::runtime_error& e)
+        {
+            ROS_ERROR("%s", e.what());
+            return 1;
+        }
+    }
+
+    RosTransport ros_transport(nh, 10, shared_memory);
+
+    // ~record: graba comandos y poses en un log binario mientras se publican
+    std::unique_ptr<CommandLogWriter> log;
+    std::unique_ptr<RecordingTransport> recording;
+    Transport* transport = &ros_transport;
+    if (!record.empty())
+    {
+        try
+        {
+            log.reset(new CommandLogWriter(record));
+        }
+        catch (const std::runtime_error& e)
+        {
+            ROS_ERROR("No se puede grabar: %s", e.what());
+            return 1;
+        }
+        recording.reset(new RecordingTransport(ros_transport, *log));
+        transport = recording.get();
+        ROS_INFO("Grabando en %s", record.c_str());
+    }
+
+    // ~deadband: solo se publican los cambios, con un keep-alive; va por
+    // fuera de la grabación para que el log tenga lo que se envió de verdad
+    std::unique_ptr<DeadbandTransport> deadband;
+    if (use_deadband)
+    {
+        try
+        {
+            deadband.reset(new DeadbandTransport(*transport, policy));
+        }
+        catch (const std::invalid_argument& e)
+        {
+            ROS_ERROR("%s", e.what());
+            return 1;
+        }
+        transport = deadband.get();
+        ROS_INFO("Banda muerta %.3f m/s %.3f rad/s, keep-alive %.2f s", policy.linear_deadband,
+            policy.angular_deadband, policy.keep_alive);
+    }
+
+    std::unique_ptr<Commander> commander;
+    try
+    {
+        commander.reset(new Commander(*transport, config));
+    }
+    catch (const std::invalid_argument& e)
+    {
+        ROS_ERROR("Trayectoria no válida: %s", e.what());
+        return 1;
+    }
+    ROS_INFO("Publicando %s en %s a %.0f Hz", config.trajectory.type.c_str(), config.topic.c_str(), loop.rate);
+
+    // ~reload_period: cada tanto se vuelven a leer los parámetros y, si ha
+    // cambiado, ~config_file. Cada fuente solo se aplica cuando cambia ella,
+    // así que un parámetro que sigue igual no deshace un cambio del fichero.
+    // Un cambio solo se da por aplicado cuando el commander lo acepta: un
+    // fichero roto o una trayectoria no válida se reintentan en cada periodo
+    // (con un solo aviso) y no se llevan por delante un cambio de parámetros.
+    // La tabla nueva se construye en el hilo de los temporizadores y el bucle
+    // la recoge en su siguiente ciclo sin cerrojos.
+    TrajectoryParams server = server_params;
+    TrajectoryParams applied = config.trajectory;
+    bool file_pending = false;
+    std::string last_warning;
+    TimerService reloader;  // después del estado que usa: se destruye (y se para) antes
+    if (reload_period > 0.0)
+    {
+        reloader.every(reload_period, [&]() {
+            TrajectoryParams fresh;
+            readTrajectoryParams(pnh, fresh);
+            const bool server_changed = fresh != server;
+            if (!config_file.empty() && watcher.changed())
+            {
+                file_pending = true;
+            }
+            if (!server_changed && !file_pending)
+            {
+                return;
+            }
+
+            std::string warning;
+            TrajectoryParams candidate = server_changed ? fresh : applied;
+            bool file_read = false;
+            if (file_pending)
+            {
+                try
+                {
+                    readTrajectoryFile(config_file, candidate);
+                    file_read = true;
+                }
+                catch (const std::runtime_error& e)
+                {
+                    // El cambio de parámetros se aplica igualmente
+                    warning = e.what();
+                    candidate = server_changed ? fresh : applied;
+                }
+            }
+
+            if (candidate != applied)
+            {
+                try
+                {
+                    commander->setTrajectory(candidate);
+                    applied = candidate;
+                    ROS_INFO("Trayectoria recargada: %s linear_x=%.3f angular_z=%.3f", applied.type.c_str(),
+                        applied.linear, applied.angular);
+                }
+                catch (const std::invalid_argument& e)
+                {
+                    warning = std::string("Trayectoria no válida, se mantiene la anterior: ") + e.what();
+                }
+            }
+            if (candidate == applied)
+            {
+                server = fresh;
+                file_pending = file_pending && !file_read;
+            }
+
+            if (!warning.empty() && warning != last_warning)
+            {
+                ROS_WARN("%s", warning.c_str());
+            }
+            last_warning = warning;
+        });
+    }
+
+    // Las estadísticas se escriben desde el propio bucle, sin otro hilo: la
+    // rueda de temporizadores avanza con el tiempo del planificador
+    PeriodicScheduler scheduler(loop);
+    TimerWheel timers;
+    if (stats_period > 0.0)
+    {
+        timers.add(stats_period, stats_period, [&scheduler, &deadband]() {
+            ROS_INFO("%s", scheduler.stats().summary().c_str());
+            if (deadband)
+            {
+                ROS_INFO("%s", deadband->stats().summary().c_str());
+            }
+        });
+    }
+    commander->run(scheduler, [&scheduler, &timers]() {
+        timers.advance(scheduler.time());
+        return ros::ok();
+    });
+
+    ROS_INFO("%s", commander->stats().summary().c_str());
+    ROS_INFO("%s", scheduler.stats().summary().c_str());
+    if (deadband)
+    {
+        ROS_INFO("%s", deadband->stats().summary().c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,165 @@
+#include <memory>
+#include <utility>
+#include <stdexcept>
+#include <string>
+
+#include <ros/callback_queue.h>
+#include <ros/ros.h>
+
+#include "turtle_unida/command_log.h"
+#include "turtle_unida/controller.h"
+#include "turtle_unida/executor.h"
+#include "turtle_unida/ros_params.h"
+#include "turtle_unida/ros_transport.h"
+
+using namespace turtle_unida;
+
+int main(int argc, char** argv)
+{
+    // Inicializa el nodo de ROS llamado "controller"
+    ros::init(argc, argv, "controller");
+    ros::NodeHandle nh;
+    ros::NodeHandle pnh("~");
+
+    std::string pose_topic = "/turtle1/pose";
+    std::string cmd_topic = "/turtle1/cmd_vel";
+    double latency_budget = 500e-6;
+    double stats_period = 5.0;
+    pnh.param("pose_topic", pose_topic, pose_topic);
+    pnh.param("cmd_topic", cmd_topic, cmd_topic);
+    pnh.param("latency_budget", latency_budget, latency_budget);
+    bool shared_memory = false;
+    pnh.param("shared_memory", shared_memory, shared_memory);
+    std::string record;
+    pnh.param("record", record, record);
+    pnh.param("stats_period", stats_period, stats_period);
+    int count = 1;
+    pnh.param("count", count, count);
+
+    ControllerParams params;
+    readControllerParams(pnh, params);
+    std::unique_ptr<Controller> controller;
+    try
+    {
+        controller = makeController(params);
+    }
+    catch (const std::exception& e)
+    {
+        ROS_ERROR("Controlador no válido: %s", e.what());
+        return 1;
+    }
+
+    RosTransport ros_transport(nh, 1, shared_memory);
+
+    // ~record: graba comandos y poses en un log binario mientras se publican
+    std::unique_ptr<CommandLogWriter> log;
+    std::unique_ptr<RecordingTransport> recording;
+    Transport* transport = &ros_transport;
+    if (!record.empty())
+    {
+        try
+        {
+            log.reset(new CommandLogWriter(record));
+        }
+        catch (const std::runtime_error& e)
+        {
+            ROS_ERROR("No se puede grabar: %s", e.what());
+            return 1;
+        }
+        recording.reset(new RecordingTransport(ros_transport, *log));
+        transport = recording.get();
+        ROS_INFO("Grabando en %s", record.c_str());
+    }
+
+    // ~count > 1: un controlador por tortuga (turtle1..N) actualizados por
+    // ciclos en el ejecutor con robo de trabajo
+    if (count > 1)
+    {
+        ExecutorConfig executor_config;
+        SchedulerConfig loop_config;
+        loop_config.rate = 100.0;
+        readExecutorParams(pnh, executor_config);
+        try
+        {
+            readSchedulerParams(pnh, loop_config);
+        }
+        catch (const std::invalid_argument& e)
+        {
+            ROS_ERROR("Planificador no válido: %s", e.what());
+            return 1;
+        }
+
+        WorkStealingExecutor executor(executor_config);
+        ControllerGroup group(*transport, executor);
+        try
+        {
+            group.add(std::move(controller), pose_topic, cmd_topic);
+            for (int i = 2; i <= count; ++i)
+            {
+                const std::string name = "/turtle" + std::to_string(i) + "/";
+                group.add(makeController(params), name + "pose", name + "cmd_vel");
+            }
+        }
+        catch (const std::exception& e)
+        {
+            ROS_ERROR("Controlador no válido: %s", e.what());
+            return 1;
+        }
+        ROS_INFO("Controlador %s para %d tortugas a %.0f Hz con %d hilos", params.type.c_str(), count,
+            loop_config.rate, executor.threads());
+
+        const ros::WallTimer timer = nh.createWallTimer(ros::WallDuration(stats_period),
+            [&group, &executor](const ros::WallTimerEvent&) {
+                const ControllerGroupStats& stats = group.stats();
+                ROS_INFO("ticks=%llu updates=%llu max_tick_us=%.2f %s", static_cast<unsigned long long>(stats.ticks),
+                    static_cast<unsigned long long>(stats.updates), stats.max_tick_time * 1e6,
+                    executor.summary().c_str());
+            });
+
+        // Las poses y el temporizador se atienden en este hilo antes de cada ciclo
+        PeriodicScheduler scheduler(loop_config);
+        group.run(scheduler, [&ros_transport]() {
+            ros::spinOnce();
+            ros_transport.pollShared();
+            return ros::ok();
+        });
+        return 0;
+    }
+
+    // Cada pose recibida se publica como comando dentro del mismo callback
+    FeedbackLoop loop(*transport, *controller, pose_topic, cmd_topic, latency_budget);
+    ROS_INFO("Controlador %s: %s -> %s", params.type.c_str(), pose_topic.c_str(), cmd_topic.c_str());
+
+    // El temporizador corre en el mismo hilo que los callbacks de pose
+    const ros::WallTimer timer = nh.createWallTimer(ros::WallDuration(stats_period),
+        [&loop, latency_budget](const ros::WallTimerEvent&) {
+            const FeedbackStats& stats = loop.stats();
+            ROS_INFO("updates=%llu mean_latency_us=%.2f max_latency_us=%.2f over_budget(%.0f us)=%llu",
+                static_cast<unsigned long long>(stats.updates), stats.meanLatency() * 1e6,
+                stats.max_latency * 1e6, latency_budget * 1e6,
+                static_cast<unsigned long long>(stats.over_budget));
+        });
+
+    if (!shared_memory)
+    {
+        ros::spin();
+        return 0;
+    }
+
+    // Con memoria compartida las poses se leen del anillo en este mismo hilo:
+    // se espera en el futex del anillo o, mientras no haya, en la cola de roscpp
+    while (ros::ok())
+    {
+        if (ros_transport.sharedActive())
+        {
+            ros_transport.waitShared(0.01);
+            ros::spinOnce();
+        }
+        else
+        {
+            ros::getGlobalCallbackQueue()->callAvailable(ros::WallDuration(0.01));
+        }
+        ros_transport.pollShared();
+    }
+    return 0;
+}
@@ -0,0 +1,187 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <ros/ros.h>
+#include <turtlesim/SetPen.h>
+#include <turtlesim/TeleportAbsolute.h>
+
+#include "turtle_unida/drawing.h"
+#include "turtle_unida/ros_transport.h"
+#include "turtle_unida/scheduler.h"
+#include "turtle_unida/simulator.h"
+
+using namespace turtle_unida;
+
+// Planifica el dibujo y lo ejecuta sobre el simulador sin ventana
+static int runHeadless(const std::string& path, const DrawingConfig& config)
+{
+    try
+    {
+        const DrawingPlan plan = planDrawing(loadBitmap(path), config);
+        SimulatorConfig sim_config;
+        sim_config.dt = config.dt;
+        Simulator simulator(sim_config);
+        const std::size_t turtle = simulator.spawn(0.5 * sim_config.world_size, 0.5 * sim_config.world_size, 0.0);
+        const double max_error = drawInSimulator(plan.commands, simulator, turtle);
+        printf("%s %s commands=%llu max_error_m=%.6f\n", path.c_str(), plan.stats.summary().c_str(),
+            static_cast<unsigned long long>(plan.commands.size()), max_error);
+    }
+    catch (const std::exception& e)
+    {
+        fprintf(stderr, "%s: %s\n", path.c_str(), e.what());
+        return 1;
+    }
+    return 0;
+}
+
+static void usage()
+{
+    fprintf(stderr,
+        "uso: draw --headless [--threshold n] [--tolerance px] [--tiles n] [--max-linear v] [--max-angular w] imagen\n"
+        "     rosrun turtle_unida draw _image:=imagen.pgm [_turtle:=turtle1] [_threshold:=n] [_tolerance:=px]\n");
+}
+
+int main(int argc, char** argv)
+{
+    // --headless imagen: planifica y dibuja sobre el simulador sin ROS master
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--headless") != 0)
+        {
+            continue;
+        }
+        DrawingConfig config;
+        std::string path;
+        for (int j = i + 1; j < argc; ++j)
+        {
+            const bool has_value = j + 1 < argc;
+            if (std::strcmp(argv[j], "--threshold") == 0 && has_value)
+            {
+                config.threshold = std::atoi(argv[++j]);
+            }
+            else if (std::strcmp(argv[j], "--tolerance") == 0 && has_value)
+            {
+                config.tolerance = std::atof(argv[++j]);
+            }
+            else if (std::strcmp(argv[j], "--tiles") == 0 && has_value)
+            {
+                config.tiles = std::atoi(argv[++j]);
+            }
+            else if (std::strcmp(argv[j], "--max-linear") == 0 && has_value)
+            {
+                config.max_linear = std::atof(argv[++j]);
+            }
+            else if (std::strcmp(argv[j], "--max-angular") == 0 && has_value)
+            {
+                config.max_angular = std::atof(argv[++j]);
+            }
+            else if (argv[j][0] == '-' || !path.empty())
+            {
+                usage();
+                return 1;
+            }
+            else
+            {
+                path = argv[j];
+            }
+        }
+        if (path.empty())
+        {
+            usage();
+            return 1;
+        }
+        return runHeadless(path, config);
+    }
+
+    // Inicializa el nodo de ROS llamado "draw"
+    ros::init(argc, argv, "draw");
+    ros::NodeHandle nh;
+    ros::NodeHandle pnh("~");
+
+    std::string path;
+    std::string turtle = "turtle1";
+    DrawingConfig config;
+    pnh.param("image", path, path);
+    pnh.param("turtle", turtle, turtle);
+    pnh.param("threshold", config.threshold, config.threshold);
+    pnh.param("tolerance", config.tolerance, config.tolerance);
+    pnh.param("tiles", config.tiles, config.tiles);
+    pnh.param("max_linear", config.max_linear, config.max_linear);
+    pnh.param("max_angular", config.max_angular, config.max_angular);
+    if (path.empty())
+    {
+        usage();
+        return 1;
+    }
+
+    DrawingPlan plan;
+    try
+    {
+        plan = planDrawing(loadBitmap(path), config);
+    }
+    catch (const std::exception& e)
+    {
+        ROS_ERROR("No se puede dibujar %s: %s", path.c_str(), e.what());
+        return 1;
+    }
+    ROS_INFO("%s", plan.stats.summary().c_str());
+
+    const std::string prefix = "/" + turtle + "/";
+    ros::service::waitForService(prefix + "set_pen");
+    ros::service::waitForService(prefix + "teleport_absolute");
+    ros::ServiceClient set_pen = nh.serviceClient<turtlesim::SetPen>(prefix + "set_pen");
+    ros::ServiceClient teleport = nh.serviceClient<turtlesim::TeleportAbsolute>(prefix + "teleport_absolute");
+    RosTransport transport(nh);
+    const Transport::Channel cmd_vel = transport.advertise(prefix + "cmd_vel");
+
+    // Un Twist por periodo de turtlesim: cada movimiento dura exactamente
+    // `steps` pasos de su integración. Tras una llamada a un servicio la
+    // política SKIP se alinea con el siguiente instante sin ráfagas.
+    SchedulerConfig sched_config;
+    sched_config.rate = 1.0 / config.dt;
+    sched_config.policy = SKIP;
+    PeriodicScheduler scheduler(sched_config);
+    for (std::size_t i = 0; i < plan.commands.size() && ros::ok(); ++i)
+    {
+        const DrawCommand& command = plan.commands[i];
+        if (command.kind == DrawCommand::PEN)
+        {
+            turtlesim::SetPen srv;
+            srv.request.r = 255;
+            srv.request.g = 255;
+            srv.request.b = 255;
+            srv.request.width = 3;
+            srv.request.off = command.pen_down ? 0 : 1;
+            if (!set_pen.call(srv))
+            {
+                ROS_WARN("Falló %sset_pen", prefix.c_str());
+            }
+        }
+        else if (command.kind == DrawCommand::TELEPORT)
+        {
+            turtlesim::TeleportAbsolute srv;
+            srv.request.x = static_cast<float>(command.x);
+            srv.request.y = static_cast<float>(command.y);
+            srv.request.theta = static_cast<float>(command.theta);
+            if (!teleport.call(srv))
+            {
+                ROS_WARN("Falló %steleport_absolute", prefix.c_str());
+            }
+        }
+        else
+        {
+            for (std::uint32_t k = 0; k < command.steps && ros::ok(); ++k)
+            {
+                scheduler.wait();
+                transport.publish(cmd_vel, command.twist);
+            }
+        }
+        ros::spinOnce();
+    }
+    transport.publish(cmd_vel, Twist());
+    ROS_INFO("Dibujo terminado: %s", scheduler.stats().summary().c_str());
+    return 0;
+}
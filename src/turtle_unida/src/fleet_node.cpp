@@ -0,0 +1,235 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <ros/ros.h>
+#include <turtlesim/Spawn.h>
+
+#include "turtle_unida/command_log.h"
+#include "turtle_unida/fleet.h"
+#include "turtle_unida/publish_policy.h"
+#include "turtle_unida/ros_params.h"
+#include "turtle_unida/ros_transport.h"
+#include "turtle_unida/simulator.h"
+#include "turtle_unida/timer_wheel.h"
+
+using namespace turtle_unida;
+
+// Topic de velocidad de la tortuga número index (1 = la tortuga inicial)
+static std::string cmdVelTopic(int index)
+{
+    return "/turtle" + std::to_string(index) + "/cmd_vel";
+}
+
+// Añade `count` tortugas con la misma trayectoria, desfasadas `phase` segundos entre sí
+static void addTurtles(Fleet& fleet, const Trajectory& trajectory, int count, double phase)
+{
+    const std::size_t index = fleet.addTrajectory(trajectory);
+    for (int i = 1; i <= count; ++i)
+    {
+        fleet.addTurtle(cmdVelTopic(i), index, phase * (i - 1));
+    }
+}
+
+// Ejecuta la flota sin roscore durante los segundos indicados
+static int runHeadless(int count, double rate, double seconds)
+{
+    NullTransport transport;
+    Fleet fleet(transport);
+    addTurtles(fleet, makeTrajectory(TrajectoryParams()), count, 0.1);
+
+    SchedulerConfig loop;
+    loop.rate = rate;
+    PeriodicScheduler scheduler(loop);
+    fleet.run(scheduler, [&scheduler, seconds]() { return scheduler.time() < seconds; });
+
+    const FleetStats& stats = fleet.stats();
+    printf("turtles=%zu published=%llu max_tick_us=%.2f %s\n", fleet.size(),
+        static_cast<unsigned long long>(stats.published), stats.max_tick_time * 1e6,
+        scheduler.stats().summary().c_str());
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    // --headless [tortugas] [segundos]: prueba el bucle sin ROS master
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--headless") == 0)
+        {
+            const int count = i + 1 < argc ? std::atoi(argv[i + 1]) : 500;
+            const double seconds = i + 2 < argc ? std::atof(argv[i + 2]) : 5.0;
+            return runHeadless(count, 100.0, seconds);
+        }
+    }
+
+    // Un solo nodo para toda la flota
+    ros::init(argc, argv, "fleet");
+    ros::NodeHandle nh;
+    ros::NodeHandle pnh("~");
+
+    int count = 10;
+    double phase = 0.1;
+    bool spawn = true;
+    bool stamp = false;
+    double stats_period = 10.0;
+    SchedulerConfig loop;
+    loop.rate = 100.0;
+    pnh.param("count", count, count);
+    pnh.param("phase", phase, phase);
+    pnh.param("spawn", spawn, spawn);
+    pnh.param("stamp", stamp, stamp);
+    pnh.param("stats_period", stats_period, stats_period);
+    bool shared_memory = false;
+    pnh.param("shared_memory", shared_memory, shared_memory);
+    std::string record;
+    pnh.param("record", record, record);
+    bool avoid = false;
+    AvoidanceConfig avoidance;
+    pnh.param("avoid", avoid, avoid);
+    try
+    {
+        readSchedulerParams(pnh, loop);
+    }
+    catch (const std::invalid_argument& e)
+    {
+        ROS_ERROR("Planificador no válido: %s", e.what());
+        return 1;
+    }
+    PublishPolicy policy;
+    const bool use_deadband = readPublishPolicyParams(pnh, policy);
+    readAvoidanceParams(pnh, avoidance);
+    avoidance.dt = 1.0 / loop.rate;
+
+    TrajectoryParams params;
+    readTrajectoryParams(pnh, params);
+    Trajectory trajectory;
+    try
+    {
+        trajectory = makeTrajectory(params);
+    }
+    catch (const std::invalid_argument& e)
+    {
+        ROS_ERROR("Trayectoria no válida: %s", e.what());
+        return 1;
+    }
+
+    // turtlesim ya crea turtle1; el resto se reparte en una rejilla por el mundo
+    if (spawn && count > 1)
+    {
+        ros::service::waitForService("spawn");
+        ros::ServiceClient client = nh.serviceClient<turtlesim::Spawn>("spawn");
+        const int side = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count))));
+        const double step = SimulatorConfig().world_size / (side + 1);
+        for (int i = 2; i <= count && ros::ok(); ++i)
+        {
+            turtlesim::Spawn srv;
+            srv.request.x = static_cast<float>(step * (1 + (i - 1) % side));
+            srv.request.y = static_cast<float>(step * (1 + (i - 1) / side));
+            srv.request.theta = 0.0f;
+            srv.request.name = "turtle" + std::to_string(i);
+            if (!client.call(srv))
+            {
+                ROS_WARN("No se pudo crear %s (puede que ya exista)", srv.request.name.c_str());
+            }
+        }
+    }
+
+    RosTransport ros_transport(nh, 10, shared_memory);
+
+    // ~record: graba comandos y poses en un log binario mientras se publican
+    std::unique_ptr<CommandLogWriter> log;
+    std::unique_ptr<RecordingTransport> recording;
+    Transport* transport = &ros_transport;
+    if (!record.empty())
+    {
+        try
+        {
+            log.reset(new CommandLogWriter(record));
+        }
+        catch (const std::runtime_error& e)
+        {
+            ROS_ERROR("No se puede grabar: %s", e.what());
+            return 1;
+        }
+        recording.reset(new RecordingTransport(ros_transport, *log));
+        transport = recording.get();
+        ROS_INFO("Grabando en %s", record.c_str());
+    }
+
+    // ~deadband: solo se publican los cambios, con un keep-alive; va por
+    // fuera de la grabación para que el log tenga lo que se envió de verdad
+    std::unique_ptr<DeadbandTransport> deadband;
+    if (use_deadband)
+    {
+        try
+        {
+            deadband.reset(new DeadbandTransport(*transport, policy));
+        }
+        catch (const std::invalid_argument& e)
+        {
+            ROS_ERROR("%s", e.what());
+            return 1;
+        }
+        transport = deadband.get();
+        ROS_INFO("Banda muerta %.3f m/s %.3f rad/s, keep-alive %.2f s", policy.linear_deadband,
+            policy.angular_deadband, policy.keep_alive);
+    }
+
+    Fleet fleet(*transport);
+    addTurtles(fleet, trajectory, count, phase);
+    fleet.setStamping(stamp);
+    if (avoid)
+    {
+        try
+        {
+            fleet.enableAvoidance(avoidance);
+        }
+        catch (const std::invalid_argument& e)
+        {
+            ROS_ERROR("Evitación de colisiones no válida: %s", e.what());
+            return 1;
+        }
+    }
+    ROS_INFO("Moviendo %d tortugas (%s) a %.0f Hz", count, params.type.c_str(), loop.rate);
+
+    // Las poses (solo con ~avoid) llegan en este hilo antes de cada ciclo, por
+    // roscpp o por memoria compartida, y los temporizadores avanzan con el
+    // tiempo del planificador
+    PeriodicScheduler scheduler(loop);
+    TimerWheel timers;
+    if (stats_period > 0.0)
+    {
+        timers.add(stats_period, stats_period, [&fleet, &scheduler, &deadband]() {
+            ROS_INFO("published=%llu max_tick_us=%.2f %s", static_cast<unsigned long long>(fleet.stats().published),
+                fleet.stats().max_tick_time * 1e6, scheduler.stats().summary().c_str());
+            if (deadband)
+            {
+                ROS_INFO("%s", deadband->stats().summary().c_str());
+            }
+        });
+    }
+    fleet.run(scheduler, [&scheduler, &timers, &ros_transport]() {
+        ros::spinOnce();
+        ros_transport.pollShared();
+        timers.advance(scheduler.time());
+        return ros::ok();
+    });
+
+    const FleetStats& stats = fleet.stats();
+    ROS_INFO("published=%llu max_tick_us=%.2f %s", static_cast<unsigned long long>(stats.published),
+        stats.max_tick_time * 1e6, scheduler.stats().summary().c_str());
+    if (deadband)
+    {
+        ROS_INFO("%s", deadband->stats().summary().c_str());
+    }
+    if (fleet.avoidance())
+    {
+        ROS_INFO("avoidance %s", fleet.avoidance()->stats().summary().c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "turtle_unida/launch_cache.h"
+#include "turtle_unida/launcher.h"
+#include "turtle_unida/zygote.h"
+
+using namespace turtle_unida;
+
+// Lanzador de los nodos en Python. Funciona de dos formas:
+//
+//   launcher [--timing] script.py [argumentos...]
+//   mover [argumentos...]    (enlace o copia de launcher junto a mover.py)
+//
+// En la segunda, como el lanzador que catkin genera en Windows, el script es
+// el del mismo nombre con .py y todos los argumentos son para él; los tiempos
+// se piden con la variable de entorno TURTLE_UNIDA_LAUNCH_TIMING=1. Los
+// tiempos salen por stderr en una línea JSON.
+
+static void usage()
+{
+    fprintf(stderr, "uso: launcher [--timing] [--no-cache] [--zygote[=socket]] [--exec] script.py [argumentos...]\n"
+                    "     <nombre> [argumentos...]  (enlace a launcher junto a <nombre>.py)\n");
+}
+
+static std::string baseName(const std::string& path)
+{
+    const std::size_t slash = path.find_last_of('/');
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+int main(int argc, char** argv)
+{
+    const char* env = std::getenv("TURTLE_UNIDA_LAUNCH_TIMING");
+    bool timing_output = env && *env && std::strcmp(env, "0") != 0;
+    const char* cache_env = std::getenv("TURTLE_UNIDA_LAUNCH_CACHE");
+    bool use_cache = !cache_env || std::strcmp(cache_env, "0") != 0;
+    const char* exec_env = std::getenv("TURTLE_UNIDA_LAUNCH_EXEC");
+    bool in_place = exec_env && *exec_env && std::strcmp(exec_env, "0") != 0;
+    const char* zygote_env = std::getenv("TURTLE_UNIDA_ZYGOTE");
+    std::string zygote;
+    if (zygote_env && *zygote_env && std::strcmp(zygote_env, "0") != 0)
+    {
+        zygote = std::strcmp(zygote_env, "1") == 0 ? defaultZygoteSocket() : std::string(zygote_env);
+    }
+    std::string script;
+    int first = 1;
+
+    if (baseName(argv[0]) == "launcher")
+    {
+        for (; first < argc && argv[first][0] == '-'; ++first)
+        {
+            if (std::strcmp(argv[first], "--timing") == 0)
+            {
+                timing_output = true;
+            }
+            else if (std::strcmp(argv[first], "--no-cache") == 0)
+            {
+                use_cache = false;
+            }
+            else if (std::strcmp(argv[first], "--exec") == 0)
+            {
+                in_place = true;
+            }
+            else if (std::strcmp(argv[first], "--zygote") == 0)
+            {
+                zygote = defaultZygoteSocket();
+            }
+            else if (std::strncmp(argv[first], "--zygote=", 9) == 0)
+            {
+                zygote = argv[first] + 9;
+            }
+            else
+            {
+                usage();
+                return 1;
+            }
+        }
+        if (first == argc)
+        {
+            usage();
+            return 1;
+        }
+        script = argv[first++];
+    }
+    const std::vector<std::string> args(argv + first, argv + argc);
+
+    LaunchTiming timing;
+    try
+    {
+        const int zygote_fd = zygote.empty() ? -1 : connectZygote(zygote);
+        int code;
+        if (zygote_fd >= 0)
+        {
+            code = launchInZygote(zygote_fd, argv[0], script, args, timing);
+        }
+        else
+        {
+            // Sin caché no se lee ni se escribe ningún fichero
+            LaunchCache cache(use_cache ? LaunchCache::defaultFile() : std::string());
+            if (in_place)
+            {
+                execScript(argv[0], script, args, timing, use_cache ? &cache : nullptr, timing_output);
+            }
+            code = launchScript(argv[0], script, args, timing, use_cache ? &cache : nullptr);
+        }
+        if (timing_output)
+        {
+            const std::string name = script.empty() ? baseName(argv[0]) + ".py" : baseName(script);
+            fprintf(stderr, "%s\n", timing.json(name).c_str());
+        }
+        return code;
+    }
+    catch (const std::exception& e)
+    {
+        fprintf(stderr, "No se pudo lanzar el script: %s\n", e.what());
+        return 1;
+    }
+}
@@ -1,5 +1,7 @@
-#!/usr/bin/env python
+#!/usr/bin/env python3
 # -*- coding: utf-8 -*-
+import time
+
 import rospy
 from geometry_msgs.msg import Twist
 
@@ -13,15 +15,40 @@ def move_turtle():
     # Crea un objeto de tipo Twist
     twist = Twist()
     
-    # Configura las velocidades
-    twist.linear.x = 2.0  # Velocidad lineal hacia adelante --cambio para merge
-    #twist.angular.y = 1.5 
-    twist.angular.z = 1.5  # Velocidad angular (giro)
+    # Configura las velocidades: ~linear_x (hacia adelante) y ~angular_z
+    # (giro), por defecto 2.0 y 1.5. Cada ~reload_period segundos se vuelven
+    # a leer del servidor de parámetros sin parar el nodo; el temporizador
+    # sustituye la pareja entera y el bucle solo lee la vigente, así que nunca
+    # publica una velocidad nueva con la otra vieja
+    def read_speeds():
+        return (rospy.get_param('~linear_x', 2.0), rospy.get_param('~angular_z', 1.5))
+
+    speeds = [read_speeds()]
+
+    def reload_speeds(event):
+        current = read_speeds()
+        if current != speeds[0]:
+            rospy.loginfo('Velocidades recargadas: linear_x=%.3f angular_z=%.3f', current[0], current[1])
+            speeds[0] = current
+
+    reload_period = rospy.get_param('~reload_period', 1.0)
+    if reload_period > 0:
+        rospy.Timer(rospy.Duration(reload_period), reload_speeds)
+
+    # Con ~stamp:=true cada mensaje lleva marcas de latencia (ns del reloj
+    # monotónico) en campos que turtlesim ignora: linear.z al generarlo y
+    # angular.x / angular.y al publicarlo. Ver include/turtle_unida/latency.h
+    stamp = rospy.get_param('~stamp', False)
 
     # Establece la frecuencia de publicación en 10 Hz (cada 0.1 segundos)
     rate = rospy.Rate(10)  # 10 Hz
 
     while not rospy.is_shutdown():
+        twist.linear.x, twist.angular.z = speeds[0]
+        if stamp:
+            twist.linear.z = float(time.monotonic_ns())
+            twist.angular.x = twist.angular.y = float(time.monotonic_ns())
+
         # Publica el mensaje de Twist en el topic "/turtle1/cmd_vel"
         pub.publish(twist)
         
@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ros/ros.h>
+
+#include "turtle_unida/command_log.h"
+#include "turtle_unida/replay.h"
+#include "turtle_unida/ros_transport.h"
+
+using namespace turtle_unida;
+
+// Resultado de reproducir un log sin ROS
+struct Session
+{
+    std::string path;
+    ReplayStats stats;
+    std::string error;
+};
+
+// Reproduce varios logs sobre simuladores sin ventana, uno por sesión, con
+// `jobs` hilos que van tomando el siguiente log pendiente. Cada sesión tiene
+// su propio simulador, así que no comparten nada más que el contador.
+static int runHeadless(const std::vector<std::string>& paths, const ReplayConfig& config, int jobs)
+{
+    std::vector<Session> sessions(paths.size());
+    std::atomic<std::size_t> next(0);
+    const auto worker = [&]() {
+        for (std::size_t i = next++; i < sessions.size(); i = next++)
+        {
+            sessions[i].path = paths[i];
+            try
+            {
+                sessions[i].stats = replayInSimulator(paths[i], config);
+            }
+            catch (const std::exception& e)
+            {
+                sessions[i].error = e.what();
+            }
+        }
+    };
+
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point begin = Clock::now();
+    std::vector<std::thread> threads;
+    for (int k = 1; k < jobs; ++k)
+    {
+        threads.push_back(std::thread(worker));
+    }
+    worker();
+    for (std::size_t k = 0; k < threads.size(); ++k)
+    {
+        threads[k].join();
+    }
+    const double wall = std::chrono::duration<double>(Clock::now() - begin).count();
+
+    int failed = 0;
+    double log_time = 0.0;
+    for (std::size_t i = 0; i < sessions.size(); ++i)
+    {
+        if (sessions[i].error.empty())
+        {
+            printf("%s %s\n", sessions[i].path.c_str(), sessions[i].stats.summary().c_str());
+            log_time += sessions[i].stats.log_time;
+        }
+        else
+        {
+            printf("%s error: %s\n", sessions[i].path.c_str(), sessions[i].error.c_str());
+            ++failed;
+        }
+    }
+    printf("sessions=%llu failed=%d jobs=%d log_s=%.3f wall_s=%.3f warp=%.1f\n",
+        static_cast<unsigned long long>(sessions.size()), failed, jobs, log_time, wall,
+        wall > 0.0 ? log_time / wall : 0.0);
+    return failed > 0 ? 1 : 0;
+}
+
+// Espera hasta `timeout` segundos a que cada topic anunciado tenga algún
+// suscriptor conectado: roscpp descarta lo publicado antes de que se
+// conecten, así que sin esperar se perderían los primeros comandos
+static void waitForSubscribers(const RosTransport& transport, const std::vector<Transport::Channel>& channels,
+    double timeout)
+{
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point deadline =
+        Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(timeout));
+    std::size_t connected = 0;
+    while (ros::ok())
+    {
+        connected = 0;
+        for (std::size_t i = 0; i < channels.size(); ++i)
+        {
+            connected += transport.subscribers(channels[i]) > 0 ? 1 : 0;
+        }
+        if (connected == channels.size() || Clock::now() >= deadline)
+        {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    if (connected < channels.size())
+    {
+        ROS_WARN("%llu de %llu topics sin suscriptores tras %.1f s; se reproduce igualmente",
+            static_cast<unsigned long long>(channels.size() - connected),
+            static_cast<unsigned long long>(channels.size()), timeout);
+    }
+}
+
+static void usage()
+{
+    fprintf(stderr,
+        "uso: replay --headless [--speed x] [--start s] [--end s] [--jobs n] log...\n"
+        "     rosrun turtle_unida replay _log:=fichero [_speed:=x] [_start:=s] [_end:=s] [_settle:=s]\n");
+}
+
+int main(int argc, char** argv)
+{
+    // --headless log...: reproduce los logs sobre el simulador sin ROS master;
+    // por defecto tan rápido como sea posible y con un hilo por núcleo
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--headless") != 0)
+        {
+            continue;
+        }
+        ReplayConfig config;
+        config.speed = 0.0;
+        int jobs = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        std::vector<std::string> paths;
+        for (int j = i + 1; j < argc; ++j)
+        {
+            const bool has_value = j + 1 < argc;
+            if (std::strcmp(argv[j], "--speed") == 0 && has_value)
+            {
+                config.speed = std::atof(argv[++j]);
+            }
+            else if (std::strcmp(argv[j], "--start") == 0 && has_value)
+            {
+                config.start = std::atof(argv[++j]);
+            }
+            else if (std::strcmp(argv[j], "--end") == 0 && has_value)
+            {
+                config.end = std::atof(argv[++j]);
+            }
+            else if (std::strcmp(argv[j], "--jobs") == 0 && has_value)
+            {
+                jobs = std::max(1, std::atoi(argv[++j]));
+            }
+            else if (argv[j][0] == '-')
+            {
+                usage();
+                return 1;
+            }
+            else
+            {
+                paths.push_back(argv[j]);
+            }
+        }
+        if (paths.empty() || config.speed < 0.0)
+        {
+            usage();
+            return 1;
+        }
+        return runHeadless(paths, config, std::min<int>(jobs, static_cast<int>(paths.size())));
+    }
+
+    // Inicializa el nodo de ROS llamado "replay"
+    ros::init(argc, argv, "replay");
+    ros::NodeHandle nh;
+    ros::NodeHandle pnh("~");
+
+    std::string path;
+    ReplayConfig config;
+    bool loop = false;
+    double settle = 2.0;
+    pnh.param("log", path, path);
+    pnh.param("speed", config.speed, config.speed);
+    pnh.param("start", config.start, config.start);
+    pnh.param("end", config.end, config.end);
+    pnh.param("loop", loop, loop);
+    pnh.param("settle", settle, settle);
+    if (path.empty())
+    {
+        usage();
+        return 1;
+    }
+
+    // Los comandos vuelven a sus topics originales (/turtleN/cmd_vel)
+    try
+    {
+        const CommandLogReader log(path);
+        RosTransport transport(nh);
+        ROS_INFO("Reproduciendo %s (%llu registros, %.1f s) a x%.1f", path.c_str(),
+            static_cast<unsigned long long>(log.size()), log.duration() * 1e-9, config.speed);
+        Replayer replayer(log, transport, config);
+        waitForSubscribers(transport, replayer.advertised(), settle);
+        do
+        {
+            replayer.run([]() { return ros::ok(); });
+            ROS_INFO("%s", replayer.stats().summary().c_str());
+        } while (loop && ros::ok());
+    }
+    catch (const std::exception& e)
+    {
+        ROS_ERROR("No se puede reproducir %s: %s", path.c_str(), e.what());
+        return 1;
+    }
+    return 0;
+}
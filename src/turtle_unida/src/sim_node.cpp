@@ -0,0 +1,322 @@
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <geometry_msgs/Twist.h>
+#include <ros/ros.h>
+#include <std_msgs/String.h>
+#include <turtlesim/Pose.h>
+#include <turtlesim/SetPen.h>
+#include <turtlesim/Spawn.h>
+#include <turtlesim/TeleportAbsolute.h>
+
+#include "turtle_unida/latency.h"
+#include "turtle_unida/scheduler.h"
+#include "turtle_unida/shm_link.h"
+#include "turtle_unida/simulator.h"
+
+using namespace turtle_unida;
+
+// Sustituto de turtlesim_node sin ventana: mismos topics y servicios
+// (/turtleN/cmd_vel, /turtleN/pose, spawn, teleport_absolute, set_pen).
+// Además mide la latencia de los comandos que llegan con marcas (latency.h)
+// y publica el resumen en ~latency. Con shared_memory los cmd_vel de
+// publicadores locales se leen de su anillo y las poses se escriben en uno
+// propio por tortuga (ver RosTransport).
+class HeadlessTurtlesim
+{
+public:
+    HeadlessTurtlesim(const ros::NodeHandle& nh, const SimulatorConfig& config, bool shared_memory)
+        : nh_(nh), simulator_(config), shared_memory_(shared_memory)
+    {
+        latency_pub_ = ros::NodeHandle("~").advertise<std_msgs::String>("latency", 1);
+
+        const boost::function<bool(turtlesim::Spawn::Request&, turtlesim::Spawn::Response&)> on_spawn =
+            [this](turtlesim::Spawn::Request& req, turtlesim::Spawn::Response& res) {
+                res.name = spawn(req.name, req.x, req.y, req.theta);
+                return !res.name.empty();
+            };
+        spawn_ = nh_.advertiseService("spawn", on_spawn);
+    }
+
+    // Crea una tortuga con sus topics y servicios; devuelve "" si el nombre ya existe
+    std::string spawn(std::string name, double x, double y, double theta)
+    {
+        if (name.empty())
+        {
+            name = "turtle" + std::to_string(names_.size() + 1);
+        }
+        for (std::size_t i = 0; i < names_.size(); ++i)
+        {
+            if (names_[i] == name)
+            {
+                ROS_ERROR("Ya existe una tortuga llamada [%s]", name.c_str());
+                return "";
+            }
+        }
+
+        const std::size_t index = simulator_.spawn(x, y, theta);
+        names_.push_back(name);
+        const boost::function<bool(turtlesim::TeleportAbsolute::Request&, turtlesim::TeleportAbsolute::Response&)>
+            on_teleport = [this, index](turtlesim::TeleportAbsolute::Request& req, turtlesim::TeleportAbsolute::Response&) {
+                simulator_.teleport(index, req.x, req.y, req.theta);
+                return true;
+            };
+        const boost::function<bool(turtlesim::SetPen::Request&, turtlesim::SetPen::Response&)> on_set_pen =
+            [this, index](turtlesim::SetPen::Request& req, turtlesim::SetPen::Response&) {
+                simulator_.setPen(index, req.off == 0);
+                return true;
+            };
+
+        Turtle turtle;
+        ros::NodeHandle nh = nh_;
+        const std::string cmd_vel_topic = name + "/cmd_vel";
+        if (shared_memory_)
+        {
+            // Los comandos que su dueño escribe en el anillo se descartan al llegar por roscpp
+            const ShmLink::Subscribe subscribe = [this, nh, cmd_vel_topic, index](const ShmLink& link) mutable {
+                const boost::function<void(const ros::MessageEvent<geometry_msgs::Twist const>&)> on_cmd_vel =
+                    [this, index, &link](const ros::MessageEvent<geometry_msgs::Twist const>& event) {
+                        if (!link.duplicate(event.getPublisherName()))
+                        {
+                            onCommand(index, *event.getConstMessage(), monotonicNanos());
+                        }
+                    };
+                return nh.subscribe<geometry_msgs::Twist>(cmd_vel_topic, 1, on_cmd_vel);
+            };
+            turtle.cmd_vel_link.reset(new ShmLink(cmd_vel_topic, subscribe));
+            turtle.pose_ring = createShmWriter(name + "/pose");
+        }
+        else
+        {
+            const boost::function<void(const geometry_msgs::TwistConstPtr&)> on_cmd_vel =
+                [this, index](const geometry_msgs::TwistConstPtr& msg) { onCommand(index, *msg, monotonicNanos()); };
+            turtle.cmd_vel = nh.subscribe<geometry_msgs::Twist>(cmd_vel_topic, 1, on_cmd_vel);
+        }
+        turtle.pose = nh_.advertise<turtlesim::Pose>(name + "/pose", 1);
+        turtle.teleport = nh_.advertiseService(name + "/teleport_absolute", on_teleport);
+        turtle.set_pen = nh_.advertiseService(name + "/set_pen", on_set_pen);
+        turtles_.push_back(std::move(turtle));
+
+        ROS_INFO("Spawning turtle [%s] at x=[%f], y=[%f], theta=[%f]", name.c_str(), x, y, theta);
+        return name;
+    }
+
+    // Aplica los comandos llegados por memoria compartida, integra un paso y
+    // publica la pose de todas las tortugas
+    void step()
+    {
+        for (std::size_t i = 0; i < turtles_.size(); ++i)
+        {
+            if (turtles_[i].cmd_vel_link)
+            {
+                turtles_[i].cmd_vel_link->poll([this, i](const ShmRing::Record& record) {
+                    onCommand(i, twistFromRecord(record), monotonicNanos());
+                });
+            }
+        }
+
+        simulator_.step();
+        for (std::size_t i = 0; i < turtles_.size(); ++i)
+        {
+            const Pose pose = simulator_.pose(i);
+            if (turtles_[i].pose_ring)
+            {
+                ShmRing::Record record;
+                toRecord(pose, record);
+                turtles_[i].pose_ring->write(record);
+                // Los suscriptores locales leen del anillo y no cuentan en roscpp
+                if (turtles_[i].pose.getNumSubscribers() == 0)
+                {
+                    continue;
+                }
+            }
+            msg_.x = static_cast<float>(pose.x);
+            msg_.y = static_cast<float>(pose.y);
+            msg_.theta = static_cast<float>(pose.theta);
+            msg_.linear_velocity = static_cast<float>(pose.linear_velocity);
+            msg_.angular_velocity = static_cast<float>(pose.angular_velocity);
+            turtles_[i].pose.publish(msg_);
+        }
+    }
+
+    // Escribe y publica el resumen de latencia del último periodo y lo reinicia
+    void reportLatency()
+    {
+        if (latency_.endToEnd().count() == 0 && latency_.unstamped() == 0)
+        {
+            return;
+        }
+        std_msgs::String msg;
+        msg.data = latency_.summary();
+        ROS_INFO("latency %s", msg.data.c_str());
+        latency_pub_.publish(msg);
+        latency_.reset();
+    }
+
+private:
+    struct Turtle
+    {
+        ros::Subscriber cmd_vel;
+        ros::Publisher pose;
+        ros::ServiceServer teleport;
+        ros::ServiceServer set_pen;
+        std::unique_ptr<ShmLink> cmd_vel_link;
+        std::unique_ptr<ShmRing> pose_ring;
+    };
+
+    void onCommand(std::size_t index, const geometry_msgs::Twist& msg, std::uint64_t received)
+    {
+        Twist twist = Twist();
+        twist.linear.x = msg.linear.x;
+        twist.linear.y = msg.linear.y;
+        twist.linear.z = msg.linear.z;
+        twist.angular.x = msg.angular.x;
+        twist.angular.y = msg.angular.y;
+        twist.angular.z = msg.angular.z;
+        onCommand(index, twist, received);
+    }
+
+    // Aplica un comando y anota su latencia si lleva marcas
+    void onCommand(std::size_t index, const Twist& twist, std::uint64_t received)
+    {
+        simulator_.command(index, twist);
+        CommandStamp stamp;
+        if (readStamp(twist, stamp))
+        {
+            latency_.record(stamp, received);
+        }
+        else
+        {
+            latency_.recordUnstamped();
+        }
+    }
+
+    ros::NodeHandle nh_;
+    Simulator simulator_;
+    bool shared_memory_;
+    std::vector<std::string> names_;
+    std::vector<Turtle> turtles_;
+    ros::ServiceServer spawn_;
+    ros::Publisher latency_pub_;
+    LatencyStats latency_;
+    turtlesim::Pose msg_;
+};
+
+// Mide cuántos segundos-tortuga se simulan por segundo real, sin roscore
+static int runHeadless(int count, double sim_seconds)
+{
+    SimulatorConfig config;
+    Simulator simulator(config);
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> position(0.5, config.world_size - 0.5);
+    std::uniform_real_distribution<double> linear(0.0, 2.0);
+    std::uniform_real_distribution<double> angular(-2.0, 2.0);
+    for (int i = 0; i < count; ++i)
+    {
+        simulator.spawn(position(rng), position(rng), angular(rng));
+    }
+
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point begin = Clock::now();
+    const double chunk = 0.5 * config.command_timeout;
+    for (double t = 0.0; t < sim_seconds; t += chunk)
+    {
+        // Comandos nuevos antes de que caduquen los anteriores
+        for (int i = 0; i < count; ++i)
+        {
+            simulator.command(i, makeTwist(linear(rng), angular(rng)));
+        }
+        simulator.advance(chunk);
+    }
+    const double wall = std::chrono::duration<double>(Clock::now() - begin).count();
+
+    printf("turtles=%d sim_s=%.1f wall_s=%.3f turtle_s_per_wall_s=%.0f wall_hits=%llu\n",
+        count, simulator.time(), wall, count * simulator.time() / wall,
+        static_cast<unsigned long long>(simulator.wallHits()));
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    // --headless [tortugas] [segundos simulados]: prueba de carga sin ROS master
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--headless") == 0)
+        {
+            const int count = i + 1 < argc ? std::atoi(argv[i + 1]) : 1000;
+            const double seconds = i + 2 < argc ? std::atof(argv[i + 2]) : 100.0;
+            return runHeadless(count, seconds);
+        }
+    }
+
+    // Se anuncia con el mismo nombre que turtlesim_node
+    ros::init(argc, argv, "turtlesim");
+    ros::NodeHandle nh;
+    ros::NodeHandle pnh("~");
+
+    SimulatorConfig config;
+    int count = 1;
+    double speed = 1.0;
+    double stats_period = 10.0;
+    bool shared_memory = false;
+    pnh.param("count", count, count);
+    pnh.param("dt", config.dt, config.dt);
+    pnh.param("speed", speed, speed);
+    pnh.param("trails", config.trails, config.trails);
+    pnh.param("stats_period", stats_period, stats_period);
+    pnh.param("shared_memory", shared_memory, shared_memory);
+
+    // turtle1 en el centro, como turtlesim; el resto en una rejilla por el mundo
+    HeadlessTurtlesim sim(nh, config, shared_memory);
+    sim.spawn("", config.world_size / 2.0, config.world_size / 2.0, 0.0);
+    const int side = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count))));
+    const double step = config.world_size / (side + 1);
+    for (int i = 2; i <= count; ++i)
+    {
+        sim.spawn("", step * (1 + (i - 1) % side), step * (1 + (i - 1) / side), 0.0);
+    }
+
+    // Con ~stats_period <= 0 no se escriben estadísticas
+    ros::WallTimer timer;
+    if (stats_period > 0.0)
+    {
+        timer = nh.createWallTimer(ros::WallDuration(stats_period),
+            [&sim](const ros::WallTimerEvent&) { sim.reportLatency(); });
+    }
+
+    // speed = 1 tiempo real, N veces más rápido, 0 tan rápido como sea posible.
+    // El tiempo simulado no debe perder pasos, así que los retrasos se recuperan.
+    SchedulerConfig loop;
+    loop.rate = speed > 0.0 ? speed / config.dt : 1.0;
+    loop.spin_margin = 0.0;
+    loop.policy = CATCH_UP;
+    try
+    {
+        validateSchedulerConfig(loop);
+    }
+    catch (const std::invalid_argument& e)
+    {
+        ROS_ERROR("~dt o ~speed no válidos: %s", e.what());
+        return 1;
+    }
+    PeriodicScheduler scheduler(loop);
+    while (ros::ok())
+    {
+        if (speed > 0.0)
+        {
+            scheduler.wait();
+        }
+        ros::spinOnce();
+        sim.step();
+    }
+    return 0;
+}
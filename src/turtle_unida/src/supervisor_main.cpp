@@ -0,0 +1,112 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "turtle_unida/supervisor.h"
+
+using namespace turtle_unida;
+
+// Supervisor de nodos: arranca a la vez los nodos de una lista (roscore,
+// turtlesim, mover.py...), reinicia los que terminan, los fija a sus núcleos
+// y al parar escribe una línea JSON por nodo con su arranque, CPU y memoria.
+//
+//   supervisor [opciones] nodos.conf
+//
+// Ver readSupervisorFile() para el formato de la lista.
+
+static void usage()
+{
+    fprintf(stderr,
+        "uso: supervisor [--duration s] [--summary fichero] [--backoff s] [--backoff-max s]\n"
+        "                [--stable s] [--stop-timeout s] nodos.conf\n");
+}
+
+static bool parseSeconds(const char* text, double& value)
+{
+    char* end = nullptr;
+    value = std::strtod(text, &end);
+    return *text != '\0' && *end == '\0' && value >= 0.0;
+}
+
+int main(int argc, char** argv)
+{
+    SupervisorConfig config;
+    std::string summary;
+    std::string list;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string option = argv[i];
+        double* seconds = nullptr;
+        if (option == "--duration")
+        {
+            seconds = &config.duration;
+        }
+        else if (option == "--backoff")
+        {
+            seconds = &config.backoff;
+        }
+        else if (option == "--backoff-max")
+        {
+            seconds = &config.backoff_max;
+        }
+        else if (option == "--stable")
+        {
+            seconds = &config.stable_time;
+        }
+        else if (option == "--stop-timeout")
+        {
+            seconds = &config.stop_timeout;
+        }
+        else if (option == "--summary" && i + 1 < argc)
+        {
+            summary = argv[++i];
+            continue;
+        }
+        else if (option[0] != '-' && list.empty())
+        {
+            list = option;
+            continue;
+        }
+
+        if (!seconds || i + 1 >= argc || !parseSeconds(argv[++i], *seconds))
+        {
+            usage();
+            return 1;
+        }
+    }
+    if (list.empty())
+    {
+        usage();
+        return 1;
+    }
+
+    try
+    {
+        Supervisor supervisor(readSupervisorFile(list), config);
+        const int failed = supervisor.run();
+
+        std::FILE* out = summary.empty() ? stdout : std::fopen(summary.c_str(), "w");
+        if (!out)
+        {
+            fprintf(stderr, "No se puede escribir el resumen en %s\n", summary.c_str());
+            return 1;
+        }
+        for (std::size_t node = 0; node < supervisor.nodes().size(); ++node)
+        {
+            fprintf(out, "%s\n", supervisor.stats()[node].json(supervisor.nodes()[node].name).c_str());
+        }
+        if (out != stdout)
+        {
+            std::fclose(out);
+        }
+        return failed > 0 ? 2 : 0;
+    }
+    catch (const std::exception& e)
+    {
+        fprintf(stderr, "Error en el supervisor: %s\n", e.what());
+        return 1;
+    }
+}
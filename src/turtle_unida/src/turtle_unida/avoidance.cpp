@@ -0,0 +1,602 @@
+#include "turtle_unida/avoidance.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+
+#include "turtle_unida/parallel.h"
+
+namespace turtle_unida
+{
+
+namespace
+{
+
+typedef std::chrono::steady_clock Clock;
+
+const double EPSILON = 1e-9;
+
+// Tortugas por bloque de trabajo del ejecutor
+const std::size_t AVOIDANCE_BLOCK = 256;
+
+struct Vec
+{
+    double x;
+    double y;
+};
+
+Vec vec(double x, double y)
+{
+    Vec v;
+    v.x = x;
+    v.y = y;
+    return v;
+}
+
+Vec operator+(Vec a, Vec b) { return vec(a.x + b.x, a.y + b.y); }
+Vec operator-(Vec a, Vec b) { return vec(a.x - b.x, a.y - b.y); }
+Vec operator-(Vec a) { return vec(-a.x, -a.y); }
+Vec operator*(double k, Vec a) { return vec(k * a.x, k * a.y); }
+double dot(Vec a, Vec b) { return a.x * b.x + a.y * b.y; }
+double det(Vec a, Vec b) { return a.x * b.y - a.y * b.x; }
+double lengthSq(Vec a) { return dot(a, a); }
+
+Vec normalize(Vec a)
+{
+    const double length = std::sqrt(lengthSq(a));
+    return length > 0.0 ? (1.0 / length) * a : a;
+}
+
+// Semiplano de velocidades permitidas: las que quedan a la izquierda de la
+// recta que pasa por `point` con dirección unitaria `direction`
+struct Line
+{
+    Vec point;
+    Vec direction;
+};
+
+// Óptimo sobre la recta `current` respetando las anteriores y el círculo de
+// radio `radius`. Con direction_opt se busca el punto más lejano en la
+// dirección `target`; si no, el más cercano a `target`.
+bool linearProgram1(const std::vector<Line>& lines, std::size_t current, double radius, Vec target,
+    bool direction_opt, Vec& result)
+{
+    const Line& line = lines[current];
+    const double along = dot(line.point, line.direction);
+    const double discriminant = along * along + radius * radius - lengthSq(line.point);
+    if (discriminant < 0.0)
+    {
+        return false;  // la recta no corta el círculo de velocidades máximas
+    }
+    const double root = std::sqrt(discriminant);
+    double left = -along - root;
+    double right = -along + root;
+    for (std::size_t i = 0; i < current; ++i)
+    {
+        const double denominator = det(line.direction, lines[i].direction);
+        const double numerator = det(lines[i].direction, line.point - lines[i].point);
+        if (std::fabs(denominator) <= EPSILON)
+        {
+            if (numerator < 0.0)
+            {
+                return false;  // paralelas y sin intersección
+            }
+            continue;
+        }
+        const double t = numerator / denominator;
+        if (denominator >= 0.0)
+        {
+            right = std::min(right, t);
+        }
+        else
+        {
+            left = std::max(left, t);
+        }
+        if (left > right)
+        {
+            return false;
+        }
+    }
+
+    double t;
+    if (direction_opt)
+    {
+        t = dot(target, line.direction) > 0.0 ? right : left;
+    }
+    else
+    {
+        t = std::max(left, std::min(right, dot(line.direction, target - line.point)));
+    }
+    result = line.point + t * line.direction;
+    return true;
+}
+
+// Programa lineal incremental (Seidel): devuelve lines.size() si hay
+// solución o el índice de la primera recta que no se puede cumplir
+std::size_t linearProgram2(const std::vector<Line>& lines, double radius, Vec target, bool direction_opt,
+    Vec& result)
+{
+    if (direction_opt)
+    {
+        result = radius * target;
+    }
+    else if (lengthSq(target) > radius * radius)
+    {
+        result = radius * normalize(target);
+    }
+    else
+    {
+        result = target;
+    }
+    for (std::size_t i = 0; i < lines.size(); ++i)
+    {
+        if (det(lines[i].direction, lines[i].point - result) > 0.0)
+        {
+            const Vec previous = result;
+            if (!linearProgram1(lines, i, radius, target, direction_opt, result))
+            {
+                result = previous;
+                return i;
+            }
+        }
+    }
+    return lines.size();
+}
+
+// Sin solución: minimiza la mayor invasión de los semiplanos a partir de la
+// recta `first` que falló (programa lineal en 3D proyectado)
+void linearProgram3(const std::vector<Line>& lines, std::size_t first, double radius,
+    std::vector<Line>& projected, Vec& result)
+{
+    double worst = 0.0;
+    for (std::size_t i = first; i < lines.size(); ++i)
+    {
+        if (det(lines[i].direction, lines[i].point - result) <= worst)
+        {
+            continue;
+        }
+        projected.clear();
+        for (std::size_t j = 0; j < i; ++j)
+        {
+            Line line;
+            const double determinant = det(lines[i].direction, lines[j].direction);
+            if (std::fabs(determinant) <= EPSILON)
+            {
+                if (dot(lines[i].direction, lines[j].direction) > 0.0)
+                {
+                    continue;  // paralelas y en el mismo sentido
+                }
+                line.point = 0.5 * (lines[i].point + lines[j].point);
+            }
+            else
+            {
+                line.point = lines[i].point +
+                    (det(lines[j].direction, lines[i].point - lines[j].point) / determinant) * lines[i].direction;
+            }
+            line.direction = normalize(lines[j].direction - lines[i].direction);
+            projected.push_back(line);
+        }
+        const Vec previous = result;
+        if (linearProgram2(projected, radius, vec(-lines[i].direction.y, lines[i].direction.x), true, result) <
+            projected.size())
+        {
+            result = previous;  // solo por errores de redondeo
+        }
+        worst = det(lines[i].direction, lines[i].point - result);
+    }
+}
+
+// Una tortuga solo avanza en la dirección de su rumbo: de las velocidades
+// s * heading con s entre 0 y forward, la más cercana a forward que cumple
+// todos los semiplanos; 0 (girar en el sitio) si no hay ninguna
+double safeSpeed(const std::vector<Line>& lines, Vec heading, double forward)
+{
+    double low = std::min(0.0, forward);
+    double high = std::max(0.0, forward);
+    for (std::size_t i = 0; i < lines.size(); ++i)
+    {
+        // det(direction, point - s * heading) <= 0
+        const double offset = det(lines[i].direction, lines[i].point);
+        const double slope = det(lines[i].direction, heading);
+        if (std::fabs(slope) <= EPSILON)
+        {
+            if (offset > 0.0)
+            {
+                return 0.0;
+            }
+            continue;
+        }
+        if (slope > 0.0)
+        {
+            low = std::max(low, offset / slope);
+        }
+        else
+        {
+            high = std::min(high, offset / slope);
+        }
+        if (low > high)
+        {
+            return 0.0;
+        }
+    }
+    return std::max(low, std::min(high, forward));
+}
+
+} // namespace
+
+AvoidanceConfig::AvoidanceConfig()
+    : radius(0.25),
+      neighbor_distance(2.0),
+      max_neighbors(10),
+      time_horizon(1.5),
+      max_linear(2.0),
+      max_angular(4.0),
+      heading_gain(4.0),
+      dt(0.01),
+      threads(0)
+{
+}
+
+AvoidanceStats::AvoidanceStats()
+    : ticks(0), agents(0), moved(0), neighbors(0), adjusted(0), fallback(0), update_time(0.0), solve_time(0.0)
+{
+}
+
+std::string AvoidanceStats::summary() const
+{
+    char buffer[224];
+    std::snprintf(buffer, sizeof(buffer),
+        "ticks=%llu agents=%llu moved=%llu neighbors_per_agent=%.2f adjusted=%llu fallback=%llu "
+        "update_us=%.1f solve_us=%.1f",
+        static_cast<unsigned long long>(ticks), static_cast<unsigned long long>(agents),
+        static_cast<unsigned long long>(moved),
+        ticks > 0 && agents > 0 ? static_cast<double>(neighbors) / (static_cast<double>(ticks) * agents) : 0.0,
+        static_cast<unsigned long long>(adjusted), static_cast<unsigned long long>(fallback), update_time * 1e6,
+        solve_time * 1e6);
+    return buffer;
+}
+
+const std::uint32_t SpatialHash::NONE;
+
+SpatialHash::SpatialHash(double cell, std::size_t buckets)
+    : cell_(cell), mask_(0), placed_(0)
+{
+    if (!(cell > 0.0))
+    {
+        throw std::invalid_argument("el lado de la celda debe ser positivo");
+    }
+    std::size_t size = 16;
+    while (size < buckets)
+    {
+        size *= 2;
+    }
+    mask_ = size - 1;
+    buckets_.resize(size);
+}
+
+void SpatialHash::insert(std::size_t agent)
+{
+    std::vector<std::uint32_t>& bucket = buckets_[bucketOf(cell_x_[agent], cell_y_[agent])];
+    bucket_[agent] = static_cast<std::uint32_t>(bucketOf(cell_x_[agent], cell_y_[agent]));
+    slot_[agent] = static_cast<std::uint32_t>(bucket.size());
+    bucket.push_back(static_cast<std::uint32_t>(agent));
+}
+
+void SpatialHash::remove(std::size_t agent)
+{
+    if (agent >= bucket_.size() || bucket_[agent] == NONE)
+    {
+        return;
+    }
+    std::vector<std::uint32_t>& bucket = buckets_[bucket_[agent]];
+    const std::uint32_t last = bucket.back();
+    bucket[slot_[agent]] = last;
+    slot_[last] = slot_[agent];
+    bucket.pop_back();
+    bucket_[agent] = NONE;
+    --placed_;
+}
+
+void SpatialHash::rehash(std::size_t buckets)
+{
+    buckets_.assign(buckets, std::vector<std::uint32_t>());
+    mask_ = buckets - 1;
+    for (std::size_t agent = 0; agent < bucket_.size(); ++agent)
+    {
+        if (bucket_[agent] != NONE)
+        {
+            insert(agent);
+        }
+    }
+}
+
+bool SpatialHash::update(std::size_t agent, double x, double y)
+{
+    if (agent >= bucket_.size())
+    {
+        cell_x_.resize(agent + 1, 0);
+        cell_y_.resize(agent + 1, 0);
+        bucket_.resize(agent + 1, NONE);
+        slot_.resize(agent + 1, 0);
+    }
+    const std::int64_t cx = cellOf(x);
+    const std::int64_t cy = cellOf(y);
+    if (bucket_[agent] != NONE && cell_x_[agent] == cx && cell_y_[agent] == cy)
+    {
+        return false;
+    }
+    remove(agent);
+    cell_x_[agent] = cx;
+    cell_y_[agent] = cy;
+    ++placed_;
+    if (placed_ > buckets_.size())
+    {
+        bucket_[agent] = 0;  // rehash() lo coloca con los demás
+        rehash(buckets_.size() * 2);
+    }
+    else
+    {
+        insert(agent);
+    }
+    return true;
+}
+
+CollisionAvoidance::CollisionAvoidance(const AvoidanceConfig& config)
+    : config_(config), grid_(config.neighbor_distance > 0.0 ? config.neighbor_distance : 1.0, 1024)
+{
+    if (config.radius <= 0.0 || config.neighbor_distance <= 0.0 || config.max_neighbors < 1 ||
+        config.time_horizon <= 0.0 || config.max_linear <= 0.0 || config.max_angular <= 0.0 || config.dt <= 0.0)
+    {
+        throw std::invalid_argument("configuración de evitación de colisiones no válida");
+    }
+}
+
+std::size_t CollisionAvoidance::add()
+{
+    x_.push_back(0.0);
+    y_.push_back(0.0);
+    theta_.push_back(0.0);
+    vx_.push_back(0.0);
+    vy_.push_back(0.0);
+    known_.push_back(0);
+    dirty_.push_back(0);
+    return x_.size() - 1;
+}
+
+void CollisionAvoidance::setPose(std::size_t agent, const Pose& pose)
+{
+    x_[agent] = pose.x;
+    y_[agent] = pose.y;
+    theta_[agent] = pose.theta;
+    vx_[agent] = pose.linear_velocity * std::cos(pose.theta);
+    vy_[agent] = pose.linear_velocity * std::sin(pose.theta);
+    known_[agent] = 1;
+    dirty_[agent] = 1;
+}
+
+void CollisionAvoidance::neighbors(std::size_t agent, std::vector<std::uint32_t>& result) const
+{
+    std::vector<double> distances;
+    findNeighbors(agent, result, distances);
+}
+
+void CollisionAvoidance::findNeighbors(std::size_t agent, std::vector<std::uint32_t>& result,
+    std::vector<double>& distances) const
+{
+    // Los max_neighbors más cercanos, con inserción ordenada (son pocos)
+    result.clear();
+    distances.clear();
+    const double range_sq = config_.neighbor_distance * config_.neighbor_distance;
+    const std::size_t limit = static_cast<std::size_t>(config_.max_neighbors);
+    grid_.query(x_[agent], y_[agent], config_.neighbor_distance, [&](std::uint32_t other) {
+        if (other == agent)
+        {
+            return;
+        }
+        const double dx = x_[other] - x_[agent];
+        const double dy = y_[other] - y_[agent];
+        const double d = dx * dx + dy * dy;
+        if (d >= range_sq || (result.size() == limit && d >= distances.back()))
+        {
+            return;
+        }
+        if (result.size() == limit)
+        {
+            result.pop_back();
+            distances.pop_back();
+        }
+        std::size_t k = result.size();
+        result.push_back(other);
+        distances.push_back(d);
+        for (; k > 0 && distances[k - 1] > d; --k)
+        {
+            result[k] = result[k - 1];
+            distances[k] = distances[k - 1];
+        }
+        result[k] = other;
+        distances[k] = d;
+    });
+}
+
+CollisionAvoidance::BlockCounts CollisionAvoidance::solve(std::size_t first, std::size_t last, double* linear,
+    double* angular) const
+{
+    const double combined = 2.0 * config_.radius;
+    const double inv_horizon = 1.0 / config_.time_horizon;
+    const double inv_dt = 1.0 / config_.dt;
+    std::vector<std::uint32_t> around;
+    std::vector<double> distances;
+    std::vector<Line> lines;
+    std::vector<Line> projected;
+    // Contadores locales: el bloque escribe sus totales una sola vez al final
+    std::uint64_t neighbor_count = 0;
+    std::uint64_t adjusted = 0;
+    std::uint64_t fallback = 0;
+
+    for (std::size_t i = first; i < last; ++i)
+    {
+        if (!known_[i])
+        {
+            continue;
+        }
+        findNeighbors(i, around, distances);
+        if (around.empty())
+        {
+            continue;
+        }
+        neighbor_count += around.size();
+
+        // Cada vecino prohíbe las velocidades relativas que chocan antes de
+        // time_horizon; el semiplano pasa por la mitad del cambio mínimo
+        const Vec position = vec(x_[i], y_[i]);
+        const Vec velocity = vec(vx_[i], vy_[i]);
+        lines.clear();
+        for (std::size_t k = 0; k < around.size(); ++k)
+        {
+            const std::uint32_t j = around[k];
+            const Vec relative_position = vec(x_[j], y_[j]) - position;
+            const Vec relative_velocity = velocity - vec(vx_[j], vy_[j]);
+            const double distance_sq = lengthSq(relative_position);
+            const double combined_sq = combined * combined;
+            Line line;
+            Vec u;
+            if (distance_sq > combined_sq)
+            {
+                // Vector desde el centro del círculo de corte
+                const Vec w = relative_velocity - inv_horizon * relative_position;
+                const double w_length_sq = lengthSq(w);
+                const double projection = dot(w, relative_position);
+                if (projection < 0.0 && projection * projection > combined_sq * w_length_sq)
+                {
+                    // Se proyecta sobre el círculo de corte
+                    const double w_length = std::sqrt(w_length_sq);
+                    const Vec unit = (1.0 / w_length) * w;
+                    line.direction = vec(unit.y, -unit.x);
+                    u = (combined * inv_horizon - w_length) * unit;
+                }
+                else
+                {
+                    // Se proyecta sobre uno de los lados del cono
+                    const double leg = std::sqrt(distance_sq - combined_sq);
+                    const Vec& p = relative_position;
+                    if (det(p, w) > 0.0)
+                    {
+                        line.direction = (1.0 / distance_sq) * vec(p.x * leg - p.y * combined, p.x * combined + p.y * leg);
+                    }
+                    else
+                    {
+                        line.direction =
+                            -((1.0 / distance_sq) * vec(p.x * leg + p.y * combined, -p.x * combined + p.y * leg));
+                    }
+                    u = dot(relative_velocity, line.direction) * line.direction - relative_velocity;
+                }
+            }
+            else
+            {
+                // Ya se tocan: separarse en el siguiente periodo
+                const Vec w = relative_velocity - inv_dt * relative_position;
+                const double w_length = std::sqrt(lengthSq(w));
+                const Vec unit = w_length > 0.0 ? (1.0 / w_length) * w : vec(1.0, 0.0);
+                line.direction = vec(unit.y, -unit.x);
+                u = (combined * inv_dt - w_length) * unit;
+            }
+            line.point = velocity + 0.5 * u;
+            lines.push_back(line);
+        }
+
+        const double heading_x = std::cos(theta_[i]);
+        const double heading_y = std::sin(theta_[i]);
+        const Vec preferred = linear[i] * vec(heading_x, heading_y);
+        Vec chosen;
+        const std::size_t failed = linearProgram2(lines, config_.max_linear, preferred, false, chosen);
+        if (failed < lines.size())
+        {
+            linearProgram3(lines, failed, config_.max_linear, projected, chosen);
+            ++fallback;
+        }
+        if (lengthSq(chosen - preferred) <= EPSILON * EPSILON)
+        {
+            continue;
+        }
+        ++adjusted;
+
+        // Uniciclo: avance con la proyección sobre el rumbo y giro hacia la
+        // velocidad elegida (en marcha atrás se gira al revés)
+        const Vec heading = vec(heading_x, heading_y);
+        const double forward = dot(heading, chosen);
+        const double lateral = det(heading, chosen);
+        double error = 0.0;
+        if (lengthSq(chosen) > EPSILON)
+        {
+            error = forward >= 0.0 ? std::atan2(lateral, forward) : std::atan2(-lateral, -forward);
+        }
+        const double limit = std::max(config_.max_angular, std::fabs(angular[i]));
+        linear[i] = safeSpeed(lines, heading, forward);
+        angular[i] = std::max(-limit, std::min(limit, angular[i] + config_.heading_gain * error));
+    }
+    BlockCounts counts;
+    counts.neighbors = neighbor_count;
+    counts.adjusted = adjusted;
+    counts.fallback = fallback;
+    return counts;
+}
+
+void CollisionAvoidance::apply(double* linear, double* angular)
+{
+    // Solo las tortugas con pose nueva pueden haber cambiado de celda
+    Clock::time_point begin = Clock::now();
+    const std::size_t n = x_.size();
+    std::uint64_t agents = 0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        agents += known_[i];
+        if (dirty_[i])
+        {
+            stats_.moved += grid_.update(i, x_[i], y_[i]) ? 1 : 0;
+            dirty_[i] = 0;
+        }
+    }
+    stats_.update_time = std::chrono::duration<double>(Clock::now() - begin).count();
+
+    // Bloques de tortugas seguidas, más que hilos para que haya algo que
+    // robar; cada bloque escribe solo sus comandos y sus totales
+    begin = Clock::now();
+    const std::size_t blocks = (n + AVOIDANCE_BLOCK - 1) / AVOIDANCE_BLOCK;
+    blocks_.resize(blocks);
+    const int threads = threadCount(config_.threads);
+    if (blocks <= 1 || threads == 1)
+    {
+        for (std::size_t b = 0; b < blocks; ++b)
+        {
+            blocks_[b] = solve(b * AVOIDANCE_BLOCK, std::min(n, (b + 1) * AVOIDANCE_BLOCK), linear, angular);
+        }
+    }
+    else
+    {
+        if (!executor_)
+        {
+            ExecutorConfig executor_config;
+            executor_config.threads = threads;
+            executor_config.grain = 1;
+            executor_.reset(new WorkStealingExecutor(executor_config));
+        }
+        executor_->run(blocks, [this, n, linear, angular](std::size_t first, std::size_t last) {
+            for (std::size_t b = first; b < last; ++b)
+            {
+                blocks_[b] = solve(b * AVOIDANCE_BLOCK, std::min(n, (b + 1) * AVOIDANCE_BLOCK), linear, angular);
+            }
+        });
+    }
+    for (std::size_t b = 0; b < blocks; ++b)
+    {
+        stats_.neighbors += blocks_[b].neighbors;
+        stats_.adjusted += blocks_[b].adjusted;
+        stats_.fallback += blocks_[b].fallback;
+    }
+    stats_.solve_time = std::chrono::duration<double>(Clock::now() - begin).count();
+    stats_.agents = agents;
+    ++stats_.ticks;
+}
+
+} // namespace turtle_unida
@@ -0,0 +1,453 @@
+#include "turtle_unida/command_log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+#include "turtle_unida/latency.h"
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace turtle_unida
+{
+
+static_assert(sizeof(LogRecord) == 64, "un registro por línea de caché");
+
+// Primera página del fichero
+struct LogHeader
+{
+    char magic[8];               // "TUNLOG1"
+    std::uint32_t version;
+    std::uint32_t record_size;
+    std::uint32_t max_topics;
+    std::uint32_t topic_count;
+    std::uint64_t start_monotonic;  // ns, reloj monotónico
+    std::uint64_t start_wall;       // ns desde 1970
+    std::uint64_t records;          // registros completos; se actualiza con cada append()
+    std::uint64_t index_offset;     // posición del índice en el fichero (0 si no se cerró)
+    std::uint64_t index_entries;
+    std::uint32_t index_stride;
+    std::uint32_t closed;
+};
+
+namespace
+{
+
+const char MAGIC[8] = {'T', 'U', 'N', 'L', 'O', 'G', '1', '\0'};
+const std::uint32_t VERSION = 2;         // 2: tipos de registro de cada topic en la tabla
+const std::uint32_t OLDEST_VERSION = 1;  // sin tipos en la tabla, los registros son iguales
+const std::size_t PAGE = 4096;
+const std::size_t TOPIC_BYTES = 64;
+const std::size_t TOPIC_NAME = TOPIC_BYTES - 1;  // el último byte es la máscara de LogKind
+const std::uint64_t CHUNK_RECORDS = (64u << 20) / sizeof(LogRecord);  // 64 MiB por ventana
+
+std::size_t prefixBytes(std::uint32_t max_topics)
+{
+    const std::size_t bytes = PAGE + max_topics * TOPIC_BYTES;
+    return (bytes + PAGE - 1) / PAGE * PAGE;
+}
+
+std::runtime_error systemError(const std::string& what, const std::string& path)
+{
+#if !defined(_WIN32)
+    return std::runtime_error(what + "(" + path + "): " + std::strerror(errno));
+#else
+    return std::runtime_error(what + "(" + path + ")");
+#endif
+}
+
+} // namespace
+
+const std::uint32_t CommandLogWriter::INDEX_STRIDE;
+
+Twist twistFromLog(const LogRecord& record)
+{
+    Twist twist;
+    twist.linear.x = record.values[0];
+    twist.linear.y = record.values[1];
+    twist.linear.z = record.values[2];
+    twist.angular.x = record.values[3];
+    twist.angular.y = record.values[4];
+    twist.angular.z = record.values[5];
+    return twist;
+}
+
+Pose poseFromLog(const LogRecord& record)
+{
+    Pose pose;
+    pose.x = record.values[0];
+    pose.y = record.values[1];
+    pose.theta = record.values[2];
+    pose.linear_velocity = record.values[3];
+    pose.angular_velocity = record.values[4];
+    return pose;
+}
+
+#if !defined(_WIN32)
+
+CommandLogWriter::CommandLogWriter(const std::string& path, std::uint32_t max_topics)
+    : path_(path),
+      fd_(-1),
+      header_(nullptr),
+      topics_(nullptr),
+      prefix_bytes_(prefixBytes(max_topics)),
+      start_(monotonicNanos()),
+      records_(0),
+      chunk_(nullptr),
+      chunk_first_(0),
+      chunk_records_(0)
+{
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0)
+    {
+        throw systemError("open", path);
+    }
+    if (ftruncate(fd_, static_cast<off_t>(prefix_bytes_)) != 0)
+    {
+        ::close(fd_);
+        throw systemError("ftruncate", path);
+    }
+    void* prefix = mmap(nullptr, prefix_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (prefix == MAP_FAILED)
+    {
+        ::close(fd_);
+        throw systemError("mmap", path);
+    }
+
+    header_ = static_cast<LogHeader*>(prefix);
+    topics_ = static_cast<char*>(prefix) + PAGE;
+    std::memcpy(header_->magic, MAGIC, sizeof(MAGIC));
+    header_->version = VERSION;
+    header_->record_size = sizeof(LogRecord);
+    header_->max_topics = max_topics;
+    header_->start_monotonic = start_;
+    header_->start_wall = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    header_->index_stride = INDEX_STRIDE;
+    mapChunk(0);
+}
+
+CommandLogWriter::~CommandLogWriter()
+{
+    close();
+}
+
+std::uint32_t CommandLogWriter::addTopic(const std::string& topic)
+{
+    if (header_->topic_count >= header_->max_topics)
+    {
+        throw std::length_error("el log no admite más topics");
+    }
+    char* slot = topics_ + header_->topic_count * TOPIC_BYTES;
+    std::strncpy(slot, topic.c_str(), TOPIC_NAME);
+    return header_->topic_count++;
+}
+
+void CommandLogWriter::mapChunk(std::uint64_t first)
+{
+    if (chunk_)
+    {
+        munmap(chunk_, chunk_records_ * sizeof(LogRecord));
+        chunk_ = nullptr;
+    }
+    const off_t offset = static_cast<off_t>(prefix_bytes_ + first * sizeof(LogRecord));
+    const std::size_t bytes = CHUNK_RECORDS * sizeof(LogRecord);
+    if (ftruncate(fd_, offset + static_cast<off_t>(bytes)) != 0)
+    {
+        throw systemError("ftruncate", path_);
+    }
+    void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, offset);
+    if (memory == MAP_FAILED)
+    {
+        throw systemError("mmap", path_);
+    }
+    chunk_ = static_cast<LogRecord*>(memory);
+    chunk_first_ = first;
+    chunk_records_ = CHUNK_RECORDS;
+}
+
+void CommandLogWriter::markKind(std::uint32_t topic, LogKind kind)
+{
+    // Solo se escribe la primera vez: después es una lectura de una línea que ya está en caché
+    char& kinds = topics_[topic * TOPIC_BYTES + TOPIC_NAME];
+    const char bit = static_cast<char>(1u << kind);
+    if ((kinds & bit) == 0)
+    {
+        kinds = static_cast<char>(kinds | bit);
+    }
+}
+
+LogRecord* CommandLogWriter::reserve()
+{
+    if (records_ - chunk_first_ >= chunk_records_)
+    {
+        mapChunk(records_);
+    }
+    if (records_ % INDEX_STRIDE == 0)
+    {
+        index_.push_back(0);
+    }
+    return chunk_ + (records_ - chunk_first_);
+}
+
+void CommandLogWriter::append(LogKind kind, std::uint32_t topic, const Twist& twist)
+{
+    LogRecord* record = reserve();
+    record->time = monotonicNanos() - start_;
+    record->kind = kind;
+    record->topic = topic;
+    record->values[0] = twist.linear.x;
+    record->values[1] = twist.linear.y;
+    record->values[2] = twist.linear.z;
+    record->values[3] = twist.angular.x;
+    record->values[4] = twist.angular.y;
+    record->values[5] = twist.angular.z;
+    markKind(topic, kind);
+    if (records_ % INDEX_STRIDE == 0)
+    {
+        index_.back() = record->time;
+    }
+    header_->records = ++records_;
+}
+
+void CommandLogWriter::append(LogKind kind, std::uint32_t topic, const Pose& pose)
+{
+    LogRecord* record = reserve();
+    record->time = monotonicNanos() - start_;
+    record->kind = kind;
+    record->topic = topic;
+    record->values[0] = pose.x;
+    record->values[1] = pose.y;
+    record->values[2] = pose.theta;
+    record->values[3] = pose.linear_velocity;
+    record->values[4] = pose.angular_velocity;
+    record->values[5] = 0.0;
+    markKind(topic, kind);
+    if (records_ % INDEX_STRIDE == 0)
+    {
+        index_.back() = record->time;
+    }
+    header_->records = ++records_;
+}
+
+void CommandLogWriter::close()
+{
+    if (fd_ < 0)
+    {
+        return;
+    }
+    if (chunk_)
+    {
+        munmap(chunk_, chunk_records_ * sizeof(LogRecord));
+        chunk_ = nullptr;
+    }
+
+    // El índice va justo después del último registro y el fichero se recorta ahí
+    const std::uint64_t index_offset = prefix_bytes_ + records_ * sizeof(LogRecord);
+    const std::size_t index_bytes = index_.size() * sizeof(std::uint64_t);
+    if (ftruncate(fd_, static_cast<off_t>(index_offset + index_bytes)) == 0 &&
+        pwrite(fd_, index_.data(), index_bytes, static_cast<off_t>(index_offset)) ==
+            static_cast<ssize_t>(index_bytes))
+    {
+        header_->index_offset = index_offset;
+        header_->index_entries = index_.size();
+        header_->closed = 1;
+    }
+    msync(header_, prefix_bytes_, MS_SYNC);
+    munmap(header_, prefix_bytes_);
+    header_ = nullptr;
+    ::close(fd_);
+    fd_ = -1;
+}
+
+CommandLogReader::CommandLogReader(const std::string& path)
+    : data_(nullptr),
+      bytes_(0),
+      header_(nullptr),
+      records_base_(nullptr),
+      records_(0),
+      index_(nullptr),
+      index_entries_(0)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw systemError("open", path);
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < PAGE)
+    {
+        ::close(fd);
+        throw std::runtime_error(path + " no es un log de comandos");
+    }
+    bytes_ = static_cast<std::size_t>(info.st_size);
+    void* memory = mmap(nullptr, bytes_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED)
+    {
+        throw systemError("mmap", path);
+    }
+    data_ = static_cast<const char*>(memory);
+    header_ = reinterpret_cast<const LogHeader*>(data_);
+
+    const std::size_t prefix = prefixBytes(header_->max_topics);
+    if (std::memcmp(header_->magic, MAGIC, sizeof(MAGIC)) != 0 || header_->version < OLDEST_VERSION ||
+        header_->version > VERSION ||
+        header_->record_size != sizeof(LogRecord) || prefix > bytes_)
+    {
+        munmap(memory, bytes_);
+        throw std::runtime_error(path + " no es un log de comandos compatible");
+    }
+
+    // Un log sin cerrar puede tener la cola del fichero sin escribir
+    records_base_ = reinterpret_cast<const LogRecord*>(data_ + prefix);
+    records_ = std::min<std::uint64_t>(header_->records, (bytes_ - prefix) / sizeof(LogRecord));
+    if (header_->closed && header_->index_offset + header_->index_entries * sizeof(std::uint64_t) <= bytes_)
+    {
+        index_ = reinterpret_cast<const std::uint64_t*>(data_ + header_->index_offset);
+        index_entries_ = header_->index_entries;
+    }
+
+    for (std::uint32_t i = 0; i < std::min(header_->topic_count, header_->max_topics); ++i)
+    {
+        const char* name = data_ + PAGE + i * TOPIC_BYTES;
+        topics_.push_back(std::string(name, strnlen(name, TOPIC_NAME)));
+        topic_kinds_.push_back(topicKindsKnown() ? static_cast<unsigned char>(name[TOPIC_NAME]) : 0);
+    }
+}
+
+CommandLogReader::~CommandLogReader()
+{
+    munmap(const_cast<char*>(data_), bytes_);
+}
+
+#else
+
+CommandLogWriter::CommandLogWriter(const std::string& path, std::uint32_t max_topics)
+    : path_(path), fd_(-1), header_(nullptr), topics_(nullptr), prefix_bytes_(prefixBytes(max_topics)),
+      start_(0), records_(0), chunk_(nullptr), chunk_first_(0), chunk_records_(0)
+{
+    throw std::runtime_error("log de comandos no disponible en esta plataforma: " + path);
+}
+
+CommandLogWriter::~CommandLogWriter()
+{
+}
+
+std::uint32_t CommandLogWriter::addTopic(const std::string& /*topic*/)
+{
+    return 0;
+}
+
+void CommandLogWriter::append(LogKind /*kind*/, std::uint32_t /*topic*/, const Twist& /*twist*/)
+{
+}
+
+void CommandLogWriter::append(LogKind /*kind*/, std::uint32_t /*topic*/, const Pose& /*pose*/)
+{
+}
+
+void CommandLogWriter::close()
+{
+}
+
+CommandLogReader::CommandLogReader(const std::string& path)
+    : data_(nullptr), bytes_(0), header_(nullptr), records_base_(nullptr), records_(0), index_(nullptr),
+      index_entries_(0)
+{
+    throw std::runtime_error("log de comandos no disponible en esta plataforma: " + path);
+}
+
+CommandLogReader::~CommandLogReader()
+{
+}
+
+#endif
+
+std::uint64_t CommandLogReader::seek(std::uint64_t time) const
+{
+    // Con índice: bloque de INDEX_STRIDE registros donde está el resultado
+    std::uint64_t first = 0;
+    std::uint64_t last = records_;
+    if (index_)
+    {
+        const std::uint64_t* block = std::lower_bound(index_, index_ + index_entries_, time);
+        const std::uint64_t k = static_cast<std::uint64_t>(block - index_);
+        first = k > 0 ? (k - 1) * CommandLogWriter::INDEX_STRIDE : 0;
+        last = std::min(records_, k * CommandLogWriter::INDEX_STRIDE);
+        if (k == index_entries_)
+        {
+            last = records_;
+        }
+    }
+
+    const LogRecord* found = std::lower_bound(records_base_ + first, records_base_ + last, time,
+        [](const LogRecord& record, std::uint64_t value) { return record.time < value; });
+    return static_cast<std::uint64_t>(found - records_base_);
+}
+
+bool CommandLogReader::topicKindsKnown() const
+{
+    return header_ && header_->version >= 2;
+}
+
+bool CommandLogReader::topicHasKind(std::uint32_t index, LogKind kind) const
+{
+    return (topic_kinds_[index] & (1u << kind)) != 0;
+}
+
+std::uint64_t CommandLogReader::startTime() const
+{
+    return header_->start_monotonic;
+}
+
+std::uint64_t CommandLogReader::startWallTime() const
+{
+    return header_->start_wall;
+}
+
+RecordingTransport::RecordingTransport(Transport& inner, CommandLogWriter& log)
+    : inner_(inner), log_(log)
+{
+}
+
+Transport::Channel RecordingTransport::advertise(const std::string& topic)
+{
+    topics_.push_back(log_.addTopic(topic));
+    const Channel channel = inner_.advertise(topic);
+    if (channel + 1 != topics_.size())
+    {
+        throw std::logic_error("RecordingTransport debe envolver un transporte sin canales previos");
+    }
+    return channel;
+}
+
+void RecordingTransport::publish(Channel channel, const Twist& twist)
+{
+    log_.append(LOG_TWIST, topics_[channel], twist);
+    inner_.publish(channel, twist);
+}
+
+void RecordingTransport::flush()
+{
+    inner_.flush();
+}
+
+void RecordingTransport::subscribe(const std::string& topic, const PoseCallback& callback)
+{
+    const std::uint32_t index = log_.addTopic(topic);
+    CommandLogWriter& log = log_;
+    inner_.subscribe(topic, [&log, index, callback](const Pose& pose) {
+        log.append(LOG_POSE, index, pose);
+        callback(pose);
+    });
+}
+
+} // namespace turtle_unida
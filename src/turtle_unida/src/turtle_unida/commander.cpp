@@ -0,0 +1,140 @@
+#include "turtle_unida/commander.h"
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+
+#include "turtle_unida/latency.h"
+#include "turtle_unida/latest_slot.h"
+
+namespace turtle_unida
+{
+
+CommanderConfig::CommanderConfig()
+    : topic("/turtle1/cmd_vel"), stamp(false), pipeline(false)
+{
+}
+
+CommanderStats::CommanderStats()
+    : ticks(0), planned(0), dropped(0), stale(0)
+{
+}
+
+std::string CommanderStats::summary() const
+{
+    char buffer[128];
+    std::snprintf(buffer, sizeof(buffer), "published=%llu planned=%llu dropped=%llu stale=%llu",
+        static_cast<unsigned long long>(ticks), static_cast<unsigned long long>(planned),
+        static_cast<unsigned long long>(dropped), static_cast<unsigned long long>(stale));
+    return buffer;
+}
+
+Commander::Commander(Transport& transport, const CommanderConfig& config)
+    : transport_(transport),
+      config_(config),
+      trajectory_(std::unique_ptr<Trajectory>(new Trajectory(makeTrajectory(config.trajectory)))),
+      channel_(transport.advertise(config.topic))
+{
+}
+
+Twist Commander::command(double t) const
+{
+    return trajectory_.read().sample(t);
+}
+
+void Commander::setTrajectory(const TrajectoryParams& params)
+{
+    trajectory_.publish(std::unique_ptr<Trajectory>(new Trajectory(makeTrajectory(params))));
+}
+
+void Commander::step(double t)
+{
+    Twist twist = command(t);
+    trajectory_.quiescent();
+    if (config_.stamp)
+    {
+        stampGenerated(twist);
+    }
+    transport_.publish(channel_, twist);
+    transport_.flush();
+    ++stats_.ticks;
+}
+
+void Commander::run(PeriodicScheduler& scheduler, const std::function<bool()>& ok)
+{
+    if (config_.pipeline)
+    {
+        runPipeline(scheduler, ok);
+        return;
+    }
+    scheduler.reset();
+    while (ok())
+    {
+        step(scheduler.wait().time);
+    }
+}
+
+void Commander::runPipeline(PeriodicScheduler& scheduler, const std::function<bool()>& ok)
+{
+    LatestSlot<Setpoint> slot;
+    std::atomic<bool> stop(false);
+
+    // Contadores del planificador: solo los toca su hilo hasta el join
+    CommanderStats planner_stats;
+    std::thread planner([this, &slot, &stop, &scheduler, &planner_stats]() {
+        // Planifica un periodo por delante: la consigna se publica en el
+        // siguiente ciclo del bucle de publicación
+        PeriodicScheduler loop(scheduler.config());
+        const double lead = 1.0 / loop.config().rate;
+        Setpoint setpoint;
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            const double t = loop.wait().time + lead;
+            setpoint.time = t;
+            setpoint.twist = command(t);
+            trajectory_.quiescent();
+            if (config_.stamp)
+            {
+                stampGenerated(setpoint.twist);
+                // La consigna entra en la cola hacia el bucle de publicación
+                stampEnqueued(setpoint.twist);
+            }
+            // Gana la más nueva: la anterior, si nadie la ha leído, se descarta
+            if (slot.publish(setpoint))
+            {
+                ++planner_stats.dropped;
+            }
+            ++planner_stats.planned;
+        }
+    });
+
+    scheduler.reset();
+    Setpoint latest;
+    bool has_latest = false;
+    while (ok())
+    {
+        scheduler.wait();
+        if (slot.take(latest))
+        {
+            has_latest = true;
+        }
+        else
+        {
+            ++stats_.stale;
+        }
+        if (!has_latest)
+        {
+            continue;
+        }
+        transport_.publish(channel_, latest.twist);
+        transport_.flush();
+        ++stats_.ticks;
+    }
+
+    stop.store(true, std::memory_order_relaxed);
+    planner.join();
+    stats_.planned += planner_stats.planned;
+    stats_.dropped += planner_stats.dropped;
+}
+
+} // namespace turtle_unida
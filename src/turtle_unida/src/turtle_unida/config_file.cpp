@@ -0,0 +1,186 @@
+#include "turtle_unida/config_file.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include <sys/stat.h>
+
+namespace turtle_unida
+{
+
+namespace
+{
+
+std::string trim(const std::string& text)
+{
+    const std::size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos)
+    {
+        return std::string();
+    }
+    const std::size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+// Quita las comillas de un escalar de YAML ('circle' o "circle")
+std::string unquote(const std::string& text)
+{
+    if (text.size() >= 2 && (text[0] == '\'' || text[0] == '"') && text[text.size() - 1] == text[0])
+    {
+        return text.substr(1, text.size() - 2);
+    }
+    return text;
+}
+
+double parseNumber(const std::string& text, const std::string& where)
+{
+    const std::string value = unquote(trim(text));
+    char* end = nullptr;
+    errno = 0;
+    const double number = std::strtod(value.c_str(), &end);
+    if (value.empty() || *end != '\0' || errno == ERANGE)
+    {
+        throw std::runtime_error(where + ": número no válido [" + value + "]");
+    }
+    return number;
+}
+
+std::vector<double> parseList(const std::string& text, const std::string& where)
+{
+    const std::string value = trim(text);
+    if (value.size() < 2 || value[0] != '[' || value[value.size() - 1] != ']')
+    {
+        throw std::runtime_error(where + ": se esperaba una lista [a, b, ...]");
+    }
+    std::vector<double> numbers;
+    const std::string body = trim(value.substr(1, value.size() - 2));
+    std::size_t begin = 0;
+    while (!body.empty())
+    {
+        const std::size_t comma = body.find(',', begin);
+        numbers.push_back(parseNumber(body.substr(begin, comma - begin), where));
+        if (comma == std::string::npos)
+        {
+            break;
+        }
+        begin = comma + 1;
+    }
+    return numbers;
+}
+
+} // namespace
+
+void readTrajectoryFile(const std::string& path, TrajectoryParams& params)
+{
+    std::ifstream file(path.c_str());
+    if (!file)
+    {
+        throw std::runtime_error("no se puede leer la configuración " + path);
+    }
+
+    // Se rellena una copia para no dejar params a medias si una línea falla
+    TrajectoryParams result = params;
+    std::string line;
+    int number = 0;
+    while (std::getline(file, line))
+    {
+        ++number;
+        const std::string where = path + ":" + std::to_string(number);
+        const std::size_t comment = line.find('#');
+        if (comment != std::string::npos)
+        {
+            line.erase(comment);
+        }
+        line = trim(line);
+        if (line.empty() || line == "---")
+        {
+            continue;
+        }
+        const std::size_t colon = line.find(':');
+        if (colon == std::string::npos)
+        {
+            throw std::runtime_error(where + ": se esperaba clave: valor");
+        }
+        const std::string key = trim(line.substr(0, colon));
+        const std::string value = line.substr(colon + 1);
+
+        if (key == "trajectory")
+        {
+            result.type = unquote(trim(value));
+        }
+        else if (key == "linear_x")
+        {
+            result.linear = parseNumber(value, where);
+        }
+        else if (key == "angular_z")
+        {
+            result.angular = parseNumber(value, where);
+        }
+        else if (key == "size")
+        {
+            result.size = parseNumber(value, where);
+        }
+        else if (key == "period")
+        {
+            result.period = parseNumber(value, where);
+        }
+        else if (key == "growth")
+        {
+            result.growth = parseNumber(value, where);
+        }
+        else if (key == "duration")
+        {
+            result.duration = parseNumber(value, where);
+        }
+        else if (key == "points")
+        {
+            result.points = parseList(value, where);
+        }
+        else if (key == "segments")
+        {
+            result.segments = parseList(value, where);
+        }
+        else if (key == "table_dt")
+        {
+            result.table_dt = parseNumber(value, where);
+        }
+        else
+        {
+            // Una errata (linear: en vez de linear_x:) no debe pasar por "sin cambios"
+            throw std::runtime_error(where + ": clave desconocida [" + key + "]");
+        }
+    }
+    params = result;
+}
+
+FileWatcher::FileWatcher(const std::string& path)
+    : path_(path), seen_(false), mtime_(0), size_(0), inode_(0)
+{
+}
+
+bool FileWatcher::changed()
+{
+    struct stat info;
+    if (::stat(path_.c_str(), &info) != 0)
+    {
+        return false;
+    }
+    const std::int64_t mtime =
+        static_cast<std::int64_t>(info.st_mtim.tv_sec) * 1000000000 + static_cast<std::int64_t>(info.st_mtim.tv_nsec);
+    const std::int64_t size = static_cast<std::int64_t>(info.st_size);
+    const std::uint64_t inode = static_cast<std::uint64_t>(info.st_ino);
+    if (seen_ && mtime == mtime_ && size == size_ && inode == inode_)
+    {
+        return false;
+    }
+    seen_ = true;
+    mtime_ = mtime;
+    size_ = size;
+    inode_ = inode;
+    return true;
+}
+
+} // namespace turtle_unida
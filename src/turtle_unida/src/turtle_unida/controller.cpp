@@ -0,0 +1,264 @@
+#include "turtle_unida/controller.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+#include "turtle_unida/latency.h"
+
+namespace turtle_unida
+{
+
+namespace
+{
+
+double clamp(double value, double limit)
+{
+    return std::max(-limit, std::min(limit, value));
+}
+
+// Comando de persecución pura hacia el punto (tx, ty)
+Twist pursue(const Pose& pose, double tx, double ty, double speed, const ControllerGains& gains)
+{
+    const double dx = tx - pose.x;
+    const double dy = ty - pose.y;
+    const double c = std::cos(pose.theta);
+    const double s = std::sin(pose.theta);
+    const double local_x = c * dx + s * dy;
+    const double local_y = -s * dx + c * dy;
+    const double dist2 = dx * dx + dy * dy;
+    if (dist2 < 1e-12)
+    {
+        return Twist();
+    }
+
+    // Si el objetivo queda detrás, gira sobre sí misma hasta tenerlo delante
+    if (local_x < 0.0)
+    {
+        return makeTwist(0.0, local_y >= 0.0 ? gains.max_angular : -gains.max_angular);
+    }
+    const double v = std::min(speed, gains.max_linear);
+    return makeTwist(v, clamp(2.0 * v * local_y / dist2, gains.max_angular));
+}
+
+} // namespace
+
+ControllerGains::ControllerGains()
+    : k_linear(1.5),
+      k_angular(6.0),
+      max_linear(2.0),
+      max_angular(4.0),
+      tolerance(0.1)
+{
+}
+
+GoToGoalController::GoToGoalController(double goal_x, double goal_y, const ControllerGains& gains)
+    : goal_x_(goal_x), goal_y_(goal_y), gains_(gains), done_(false)
+{
+}
+
+Twist GoToGoalController::update(const Pose& pose)
+{
+    const double dx = goal_x_ - pose.x;
+    const double dy = goal_y_ - pose.y;
+    const double distance = std::sqrt(dx * dx + dy * dy);
+    if (distance < gains_.tolerance)
+    {
+        done_ = true;
+        return Twist();
+    }
+    done_ = false;
+
+    const double error = normalizeAngle(std::atan2(dy, dx) - pose.theta);
+    const double linear = std::min(gains_.k_linear * distance, gains_.max_linear) * std::max(0.0, std::cos(error));
+    return makeTwist(linear, clamp(gains_.k_angular * error, gains_.max_angular));
+}
+
+HeadingHoldController::HeadingHoldController(double heading, double speed, const ControllerGains& gains)
+    : heading_(heading), speed_(speed), gains_(gains)
+{
+}
+
+Twist HeadingHoldController::update(const Pose& pose)
+{
+    const double error = normalizeAngle(heading_ - pose.theta);
+    return makeTwist(std::min(speed_, gains_.max_linear), clamp(gains_.k_angular * error, gains_.max_angular));
+}
+
+PurePursuitController::PurePursuitController(const std::vector<double>& points, double lookahead,
+    double speed, const ControllerGains& gains)
+    : path_(points), lookahead_(lookahead), speed_(speed), gains_(gains), progress_(0.0), done_(false)
+{
+    if (lookahead_ <= 0.0)
+    {
+        throw std::invalid_argument("la distancia de anticipación debe ser positiva");
+    }
+}
+
+Twist PurePursuitController::update(const Pose& pose)
+{
+    // Punto del camino más cercano a la tortuga, buscado solo cerca del
+    // avance actual para no saltar a otra vuelta si el camino se cruza
+    const PathPoint nearest = path_.nearest(pose.x, pose.y, progress_ - lookahead_,
+        progress_ + SEARCH_WINDOW * lookahead_);
+    progress_ = nearest.s;
+
+    // El final solo cuenta al llegar a él recorriendo el camino, no al pasar
+    // cerca en una vuelta anterior
+    const PathPoint end = path_.at(path_.length());
+    if (path_.length() - progress_ <= lookahead_ + gains_.tolerance &&
+        std::hypot(end.x - pose.x, end.y - pose.y) < gains_.tolerance)
+    {
+        done_ = true;
+        return Twist();
+    }
+    done_ = false;
+
+    // Avanza por el camino la distancia de anticipación desde ese punto
+    const PathPoint target = path_.at(nearest.s + lookahead_);
+    return pursue(pose, target.x, target.y, speed_, gains_);
+}
+
+ControllerParams::ControllerParams()
+    : type("go_to_goal"),
+      goal_x(5.544445),
+      goal_y(5.544445),
+      heading(0.0),
+      speed(1.0),
+      lookahead(0.5)
+{
+}
+
+std::unique_ptr<Controller> makeController(const ControllerParams& params)
+{
+    if (params.type == "go_to_goal")
+    {
+        return std::unique_ptr<Controller>(new GoToGoalController(params.goal_x, params.goal_y, params.gains));
+    }
+    if (params.type == "heading_hold")
+    {
+        return std::unique_ptr<Controller>(new HeadingHoldController(params.heading, params.speed, params.gains));
+    }
+    if (params.type == "pure_pursuit")
+    {
+        const std::vector<double> points = params.path_file.empty() ? params.points : loadPath(params.path_file);
+        return std::unique_ptr<Controller>(
+            new PurePursuitController(points, params.lookahead, params.speed, params.gains));
+    }
+    throw std::invalid_argument("tipo de controlador desconocido: " + params.type);
+}
+
+FeedbackStats::FeedbackStats()
+    : updates(0), over_budget(0), sum_latency(0.0), max_latency(0.0)
+{
+}
+
+FeedbackLoop::FeedbackLoop(Transport& transport, Controller& controller, const std::string& pose_topic,
+    const std::string& cmd_topic, double latency_budget)
+    : transport_(transport),
+      controller_(controller),
+      channel_(transport.advertise(cmd_topic)),
+      latency_budget_(latency_budget)
+{
+    // La marca se toma en cuanto el transporte entrega la pose, antes de
+    // cualquier otro trabajo del lazo
+    transport_.subscribe(pose_topic, [this](const Pose& pose) { onPose(pose, monotonicNanos()); });
+}
+
+void FeedbackLoop::onPose(const Pose& pose, std::uint64_t received)
+{
+    transport_.publish(channel_, controller_.update(pose));
+    transport_.flush();
+
+    const double latency = static_cast<double>(monotonicNanos() - received) * 1e-9;
+    ++stats_.updates;
+    stats_.sum_latency += latency;
+    stats_.max_latency = std::max(stats_.max_latency, latency);
+    if (latency > latency_budget_)
+    {
+        ++stats_.over_budget;
+    }
+}
+
+ControllerGroupStats::ControllerGroupStats()
+    : ticks(0), updates(0), published(0), max_tick_time(0.0)
+{
+}
+
+ControllerGroup::ControllerGroup(Transport& transport, WorkStealingExecutor& executor)
+    : transport_(transport), executor_(executor)
+{
+}
+
+std::size_t ControllerGroup::add(std::unique_ptr<Controller> controller, const std::string& pose_topic,
+    const std::string& cmd_topic)
+{
+    if (!controller)
+    {
+        throw std::invalid_argument("falta el controlador");
+    }
+    const std::size_t turtle = controllers_.size();
+    controllers_.push_back(std::move(controller));
+    channels_.push_back(transport_.advertise(cmd_topic));
+    poses_.push_back(Pose());
+    twists_.push_back(Twist());
+    fresh_.push_back(0);
+    active_.push_back(0);
+    transport_.subscribe(pose_topic, [this, turtle](const Pose& pose) {
+        poses_[turtle] = pose;
+        fresh_[turtle] = 1;
+        active_[turtle] = 1;
+    });
+    return turtle;
+}
+
+void ControllerGroup::tick()
+{
+    // Solo las tortugas con pose nueva; las demás repiten su último comando
+    pending_.clear();
+    for (std::size_t i = 0; i < controllers_.size(); ++i)
+    {
+        if (fresh_[i])
+        {
+            pending_.push_back(static_cast<std::uint32_t>(i));
+            fresh_[i] = 0;
+        }
+    }
+    executor_.run(pending_.size(), [this](std::size_t first, std::size_t last) {
+        for (std::size_t k = first; k < last; ++k)
+        {
+            const std::uint32_t turtle = pending_[k];
+            twists_[turtle] = controllers_[turtle]->update(poses_[turtle]);
+        }
+    });
+    stats_.updates += pending_.size();
+
+    for (std::size_t i = 0; i < controllers_.size(); ++i)
+    {
+        if (active_[i])
+        {
+            transport_.publish(channels_[i], twists_[i]);
+            ++stats_.published;
+        }
+    }
+    transport_.flush();
+    ++stats_.ticks;
+}
+
+void ControllerGroup::run(PeriodicScheduler& scheduler, const std::function<bool()>& ok)
+{
+    typedef std::chrono::steady_clock Clock;
+    scheduler.reset();
+    while (ok())
+    {
+        scheduler.wait();
+
+        const Clock::time_point begin = Clock::now();
+        tick();
+        const double elapsed = std::chrono::duration<double>(Clock::now() - begin).count();
+        stats_.max_tick_time = std::max(stats_.max_tick_time, elapsed);
+    }
+}
+
+} // namespace turtle_unida
@@ -0,0 +1,1016 @@
+#include "turtle_unida/drawing.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "turtle_unida/parallel.h"
+#include "turtle_unida/pose.h"
+
+namespace turtle_unida
+{
+
+namespace
+{
+
+typedef std::chrono::steady_clock Clock;
+
+double secondsSince(Clock::time_point begin)
+{
+    return std::chrono::duration<double>(Clock::now() - begin).count();
+}
+
+double distance(double ax, double ay, double bx, double by)
+{
+    const double dx = bx - ax;
+    const double dy = by - ay;
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+// Primer y último punto por los que se entra y se sale de un trazo
+double entryX(const Stroke& stroke) { return stroke.points[0]; }
+double entryY(const Stroke& stroke) { return stroke.points[1]; }
+double exitX(const Stroke& stroke) { return stroke.closed ? stroke.points[0] : stroke.points[stroke.points.size() - 2]; }
+double exitY(const Stroke& stroke) { return stroke.closed ? stroke.points[1] : stroke.points[stroke.points.size() - 1]; }
+
+double strokeLength(const Stroke& stroke)
+{
+    const std::size_t n = stroke.size();
+    double length = 0.0;
+    for (std::size_t i = 1; i < n; ++i)
+    {
+        length += distance(stroke.points[2 * i - 2], stroke.points[2 * i - 1], stroke.points[2 * i],
+            stroke.points[2 * i + 1]);
+    }
+    if (stroke.closed && n > 1)
+    {
+        length += distance(stroke.points[2 * n - 2], stroke.points[2 * n - 1], stroke.points[0], stroke.points[1]);
+    }
+    return length;
+}
+
+// Recorre el trazo en sentido contrario; uno cerrado sigue empezando en el mismo punto
+void reverseStroke(Stroke& stroke)
+{
+    const std::size_t n = stroke.size();
+    for (std::size_t i = stroke.closed ? 1 : 0, j = n - 1; i < j; ++i, --j)
+    {
+        std::swap(stroke.points[2 * i], stroke.points[2 * j]);
+        std::swap(stroke.points[2 * i + 1], stroke.points[2 * j + 1]);
+    }
+}
+
+// Un trazo cerrado pasa a empezar en el punto `first`
+void rotateStroke(Stroke& stroke, std::size_t first)
+{
+    std::rotate(stroke.points.begin(), stroke.points.begin() + 2 * first, stroke.points.end());
+}
+
+// Marching squares. Cada punto de un contorno está en el centro de una arista
+// entre dos píxeles vecinos, identificada por una clave entera: así los tramos
+// de bandas distintas se unen comparando claves, sin tolerancias.
+class EdgeKeys
+{
+public:
+    explicit EdgeKeys(int width) : stride_(static_cast<std::uint64_t>(width) + 2) {}
+
+    // Arista entre (x, y) y (x + 1, y)
+    std::uint64_t horizontal(int x, int y) const { return index(x, y) * 2; }
+
+    // Arista entre (x, y) y (x, y + 1)
+    std::uint64_t vertical(int x, int y) const { return index(x, y) * 2 + 1; }
+
+    void point(std::uint64_t key, double& x, double& y) const
+    {
+        const std::uint64_t cell = key / 2;
+        x = static_cast<double>(cell % stride_) - 1.0;
+        y = static_cast<double>(cell / stride_) - 1.0;
+        if (key % 2 == 0)
+        {
+            x += 0.5;
+        }
+        else
+        {
+            y += 0.5;
+        }
+    }
+
+private:
+    std::uint64_t index(int x, int y) const
+    {
+        return static_cast<std::uint64_t>(y + 1) * stride_ + static_cast<std::uint64_t>(x + 1);
+    }
+
+    std::uint64_t stride_;
+};
+
+// Cadena de aristas; las abiertas terminan en el borde de su banda
+struct Chain
+{
+    std::vector<std::uint64_t> keys;
+    bool closed;
+};
+
+// Contornos de las celdas con esquina superior en las filas [y0, y1). La
+// imagen se rodea de fondo, así que en la imagen entera todo contorno se cierra.
+std::vector<Chain> traceBand(const Bitmap& bitmap, int threshold, int y0, int y1)
+{
+    const EdgeKeys keys(bitmap.width);
+    const auto ink = [&bitmap, threshold](int x, int y) {
+        return x >= 0 && y >= 0 && x < bitmap.width && y < bitmap.height && bitmap.at(x, y) < threshold;
+    };
+
+    // Tramos de cada celda según sus cuatro esquinas (sup-izq, sup-der, inf-der, inf-izq)
+    std::vector<std::pair<std::uint64_t, std::uint64_t> > segments;
+    for (int y = y0; y < y1; ++y)
+    {
+        for (int x = -1; x < bitmap.width; ++x)
+        {
+            const int code = (ink(x, y) ? 8 : 0) | (ink(x + 1, y) ? 4 : 0) | (ink(x + 1, y + 1) ? 2 : 0) |
+                (ink(x, y + 1) ? 1 : 0);
+            if (code == 0 || code == 15)
+            {
+                continue;
+            }
+            const std::uint64_t top = keys.horizontal(x, y);
+            const std::uint64_t bottom = keys.horizontal(x, y + 1);
+            const std::uint64_t left = keys.vertical(x, y);
+            const std::uint64_t right = keys.vertical(x + 1, y);
+            switch (code)
+            {
+            case 1: case 14: segments.push_back(std::make_pair(left, bottom)); break;
+            case 2: case 13: segments.push_back(std::make_pair(bottom, right)); break;
+            case 3: case 12: segments.push_back(std::make_pair(left, right)); break;
+            case 4: case 11: segments.push_back(std::make_pair(top, right)); break;
+            case 6: case 9: segments.push_back(std::make_pair(top, bottom)); break;
+            case 7: case 8: segments.push_back(std::make_pair(left, top)); break;
+            case 5:
+                // Esquinas opuestas: la tinta de cada esquina queda separada
+                segments.push_back(std::make_pair(top, right));
+                segments.push_back(std::make_pair(left, bottom));
+                break;
+            case 10:
+                segments.push_back(std::make_pair(left, top));
+                segments.push_back(std::make_pair(bottom, right));
+                break;
+            }
+        }
+    }
+
+    // Cada clave toca como mucho dos tramos
+    std::unordered_map<std::uint64_t, std::pair<int, int> > incident;
+    incident.reserve(segments.size() * 2);
+    for (std::size_t i = 0; i < segments.size(); ++i)
+    {
+        const std::uint64_t ends[2] = {segments[i].first, segments[i].second};
+        for (int e = 0; e < 2; ++e)
+        {
+            std::pair<int, int>& slots = incident.insert(std::make_pair(ends[e], std::make_pair(-1, -1))).first->second;
+            (slots.first < 0 ? slots.first : slots.second) = static_cast<int>(i);
+        }
+    }
+
+    std::vector<Chain> chains;
+    std::vector<bool> used(segments.size(), false);
+    const auto walk = [&](std::uint64_t start, int segment) {
+        Chain chain;
+        chain.closed = false;
+        chain.keys.push_back(start);
+        std::uint64_t key = start;
+        while (segment >= 0)
+        {
+            used[segment] = true;
+            key = segments[segment].first == key ? segments[segment].second : segments[segment].first;
+            if (key == start)
+            {
+                chain.closed = true;
+                break;
+            }
+            chain.keys.push_back(key);
+            const std::pair<int, int>& slots = incident[key];
+            const int next = slots.first == segment ? slots.second : slots.first;
+            segment = next >= 0 && !used[next] ? next : -1;
+        }
+        chains.push_back(chain);
+    };
+
+    // Primero las cadenas que empiezan en el borde de la banda, después los lazos
+    for (std::unordered_map<std::uint64_t, std::pair<int, int> >::const_iterator it = incident.begin();
+         it != incident.end(); ++it)
+    {
+        if (it->second.second < 0 && !used[it->second.first])
+        {
+            walk(it->first, it->second.first);
+        }
+    }
+    for (std::size_t i = 0; i < segments.size(); ++i)
+    {
+        if (!used[i])
+        {
+            walk(segments[i].first, static_cast<int>(i));
+        }
+    }
+    return chains;
+}
+
+// Distancia del punto p al segmento a-b
+double segmentDistance(const double* p, const double* a, const double* b)
+{
+    const double sx = b[0] - a[0];
+    const double sy = b[1] - a[1];
+    const double len2 = sx * sx + sy * sy;
+    double u = len2 > 0.0 ? ((p[0] - a[0]) * sx + (p[1] - a[1]) * sy) / len2 : 0.0;
+    u = std::max(0.0, std::min(1.0, u));
+    return distance(p[0], p[1], a[0] + u * sx, a[1] + u * sy);
+}
+
+// Marca en keep los puntos que sobreviven entre first y last (incluidos)
+void douglasPeucker(const double* points, std::size_t first, std::size_t last, double tolerance,
+    std::vector<bool>& keep)
+{
+    std::vector<std::pair<std::size_t, std::size_t> > pending(1, std::make_pair(first, last));
+    keep[first] = true;
+    keep[last] = true;
+    while (!pending.empty())
+    {
+        const std::size_t a = pending.back().first;
+        const std::size_t b = pending.back().second;
+        pending.pop_back();
+        double worst = -1.0;
+        std::size_t index = a;
+        for (std::size_t i = a + 1; i < b; ++i)
+        {
+            const double d = segmentDistance(points + 2 * i, points + 2 * a, points + 2 * b);
+            if (d > worst)
+            {
+                worst = d;
+                index = i;
+            }
+        }
+        if (worst > tolerance)
+        {
+            keep[index] = true;
+            pending.push_back(std::make_pair(a, index));
+            pending.push_back(std::make_pair(index, b));
+        }
+    }
+}
+
+// Índice del punto de la polilínea más alejado del punto `from`
+std::size_t farthestPoint(const std::vector<double>& points, std::size_t from)
+{
+    std::size_t far = from;
+    double far_distance = -1.0;
+    for (std::size_t i = 0; i < points.size() / 2; ++i)
+    {
+        const double d = distance(points[2 * from], points[2 * from + 1], points[2 * i], points[2 * i + 1]);
+        if (d > far_distance)
+        {
+            far_distance = d;
+            far = i;
+        }
+    }
+    return far;
+}
+
+// Rejilla de los puntos por los que se puede entrar en cada trazo. Los
+// puntos de trazos ya dibujados se quitan de su celda al encontrarlos.
+class EntryGrid
+{
+public:
+    explicit EntryGrid(const std::vector<Stroke>& strokes)
+        : strokes_(strokes), min_x_(0.0), min_y_(0.0), cell_(1.0), columns_(1), rows_(1)
+    {
+        double max_x = -INFINITY;
+        double max_y = -INFINITY;
+        min_x_ = INFINITY;
+        min_y_ = INFINITY;
+        std::size_t entries = 0;
+        for (std::size_t s = 0; s < strokes.size(); ++s)
+        {
+            for (std::size_t i = 0; i < strokes[s].size(); ++i)
+            {
+                min_x_ = std::min(min_x_, strokes[s].points[2 * i]);
+                min_y_ = std::min(min_y_, strokes[s].points[2 * i + 1]);
+                max_x = std::max(max_x, strokes[s].points[2 * i]);
+                max_y = std::max(max_y, strokes[s].points[2 * i + 1]);
+            }
+            entries += strokes[s].closed ? strokes[s].size() : 2;
+        }
+        if (entries == 0)
+        {
+            return;
+        }
+        const double width = std::max(max_x - min_x_, 1e-6);
+        const double height = std::max(max_y - min_y_, 1e-6);
+        cell_ = std::max(std::sqrt(width * height / static_cast<double>(entries)), 1e-6);
+        columns_ = static_cast<std::size_t>(width / cell_) + 1;
+        rows_ = static_cast<std::size_t>(height / cell_) + 1;
+        cells_.resize(columns_ * rows_);
+        for (std::size_t s = 0; s < strokes.size(); ++s)
+        {
+            const std::size_t n = strokes[s].size();
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                if (strokes[s].closed || i == 0 || i + 1 == n)
+                {
+                    cells_[cellOf(strokes[s].points[2 * i], strokes[s].points[2 * i + 1])].push_back(
+                        std::make_pair(static_cast<std::uint32_t>(s), static_cast<std::uint32_t>(i)));
+                }
+            }
+        }
+    }
+
+    // Punto de entrada más cercano a (x, y) de un trazo con done[s] == false;
+    // false si no queda ninguno
+    bool nearest(double x, double y, const std::vector<bool>& done, std::size_t& stroke, std::size_t& point)
+    {
+        const long ci = static_cast<long>(std::min<double>(columns_ - 1, std::max(0.0, std::floor((x - min_x_) / cell_))));
+        const long cj = static_cast<long>(std::min<double>(rows_ - 1, std::max(0.0, std::floor((y - min_y_) / cell_))));
+        const long columns = static_cast<long>(columns_);
+        const long rows = static_cast<long>(rows_);
+        double best = INFINITY;
+        bool found = false;
+        for (long ring = 0;; ++ring)
+        {
+            if (found && ring > 0)
+            {
+                const double left = x - (min_x_ + (ci - ring + 1) * cell_);
+                const double right = min_x_ + (ci + ring) * cell_ - x;
+                const double bottom = y - (min_y_ + (cj - ring + 1) * cell_);
+                const double top = min_y_ + (cj + ring) * cell_ - y;
+                if (std::min(std::min(left, right), std::min(bottom, top)) >= best)
+                {
+                    return true;
+                }
+            }
+            if (ci - ring < 0 && cj - ring < 0 && ci + ring >= columns && cj + ring >= rows)
+            {
+                return found;
+            }
+            for (long j = std::max(0L, cj - ring); j <= std::min(rows - 1, cj + ring); ++j)
+            {
+                const long step = j == cj - ring || j == cj + ring ? 1 : 2 * ring;
+                for (long i = ci - ring; i <= ci + ring; i += step)
+                {
+                    if (i < 0 || i >= columns)
+                    {
+                        continue;
+                    }
+                    std::vector<std::pair<std::uint32_t, std::uint32_t> >& cell =
+                        cells_[static_cast<std::size_t>(j * columns + i)];
+                    for (std::size_t k = 0; k < cell.size();)
+                    {
+                        if (done[cell[k].first])
+                        {
+                            cell[k] = cell.back();
+                            cell.pop_back();
+                            continue;
+                        }
+                        const Stroke& candidate = strokes_[cell[k].first];
+                        const double d = distance(x, y, candidate.points[2 * cell[k].second],
+                            candidate.points[2 * cell[k].second + 1]);
+                        if (d < best)
+                        {
+                            best = d;
+                            stroke = cell[k].first;
+                            point = cell[k].second;
+                            found = true;
+                        }
+                        ++k;
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    std::size_t cellOf(double x, double y) const
+    {
+        const std::size_t i = std::min(columns_ - 1, static_cast<std::size_t>((x - min_x_) / cell_));
+        const std::size_t j = std::min(rows_ - 1, static_cast<std::size_t>((y - min_y_) / cell_));
+        return j * columns_ + i;
+    }
+
+    const std::vector<Stroke>& strokes_;
+    double min_x_;
+    double min_y_;
+    double cell_;
+    std::size_t columns_;
+    std::size_t rows_;
+    std::vector<std::vector<std::pair<std::uint32_t, std::uint32_t> > > cells_;
+};
+
+} // namespace
+
+Bitmap::Bitmap()
+    : width(0), height(0)
+{
+}
+
+Stroke::Stroke()
+    : closed(false)
+{
+}
+
+DrawingConfig::DrawingConfig()
+    : threshold(128),
+      tolerance(1.0),
+      min_length(4.0),
+      tiles(0),
+      two_opt_window(32),
+      world_size(SimulatorConfig().world_size),
+      margin(0.5),
+      max_linear(2.0),
+      max_angular(4.0),
+      dt(SimulatorConfig().dt)
+{
+}
+
+DrawCommand::DrawCommand()
+    : kind(TWIST), pen_down(false), x(0.0), y(0.0), theta(0.0), steps(0)
+{
+}
+
+DrawingStats::DrawingStats()
+    : contours(0),
+      strokes(0),
+      points_in(0),
+      points_out(0),
+      travel_before(0.0),
+      travel_after(0.0),
+      drawn(0.0),
+      draw_time(0.0),
+      tiles(0),
+      contour_time(0.0),
+      simplify_time(0.0),
+      order_time(0.0),
+      emit_time(0.0)
+{
+}
+
+std::string DrawingStats::summary() const
+{
+    char buffer[320];
+    std::snprintf(buffer, sizeof(buffer),
+        "contours=%llu strokes=%llu points=%llu->%llu travel_m=%.1f->%.1f drawn_m=%.1f draw_s=%.1f tiles=%d "
+        "ms contour=%.2f simplify=%.2f order=%.2f emit=%.2f",
+        static_cast<unsigned long long>(contours), static_cast<unsigned long long>(strokes),
+        static_cast<unsigned long long>(points_in), static_cast<unsigned long long>(points_out), travel_before,
+        travel_after, drawn, draw_time, tiles, contour_time * 1e3, simplify_time * 1e3, order_time * 1e3,
+        emit_time * 1e3);
+    return buffer;
+}
+
+Bitmap loadBitmap(const std::string& path)
+{
+    std::ifstream file(path.c_str(), std::ios::binary);
+    std::string magic;
+    if (!(file >> magic) || magic.size() != 2 || magic[0] != 'P' || magic[1] < '1' || magic[1] > '5' ||
+        magic[1] == '3')
+    {
+        throw std::runtime_error(path + " no es una imagen PBM o PGM");
+    }
+    const char format = magic[1];
+    const bool bitmap_format = format == '1' || format == '4';
+
+    // Cabecera: ancho, alto y (solo PGM) valor máximo, con comentarios '#'
+    int header[3] = {0, 0, 1};
+    for (int i = 0; i < (bitmap_format ? 2 : 3); ++i)
+    {
+        file >> std::ws;
+        while (file.peek() == '#')
+        {
+            std::string comment;
+            std::getline(file, comment);
+            file >> std::ws;
+        }
+        if (!(file >> header[i]) || header[i] <= 0)
+        {
+            throw std::runtime_error(path + ": cabecera no válida");
+        }
+    }
+    if (header[2] > 255)
+    {
+        throw std::runtime_error(path + ": solo se admiten imágenes de 8 bits");
+    }
+
+    Bitmap bitmap;
+    bitmap.width = header[0];
+    bitmap.height = header[1];
+    bitmap.pixels.resize(static_cast<std::size_t>(bitmap.width) * bitmap.height);
+    if (format == '4' || format == '5')
+    {
+        file.get();  // un único blanco antes de los datos binarios
+    }
+
+    if (format == '4')
+    {
+        const std::size_t row_bytes = (static_cast<std::size_t>(bitmap.width) + 7) / 8;
+        std::vector<unsigned char> row(row_bytes);
+        for (int y = 0; y < bitmap.height; ++y)
+        {
+            file.read(reinterpret_cast<char*>(row.data()), static_cast<std::streamsize>(row_bytes));
+            for (int x = 0; x < bitmap.width; ++x)
+            {
+                const bool black = (row[x / 8] >> (7 - x % 8)) & 1;
+                bitmap.pixels[static_cast<std::size_t>(y) * bitmap.width + x] = black ? 0 : 255;
+            }
+        }
+    }
+    else if (format == '5')
+    {
+        file.read(reinterpret_cast<char*>(bitmap.pixels.data()), static_cast<std::streamsize>(bitmap.pixels.size()));
+        if (header[2] != 255)
+        {
+            for (std::size_t i = 0; i < bitmap.pixels.size(); ++i)
+            {
+                bitmap.pixels[i] = static_cast<std::uint8_t>(std::min(255, bitmap.pixels[i] * 255 / header[2]));
+            }
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0; i < bitmap.pixels.size() && file; ++i)
+        {
+            int value = 0;
+            if (format == '1')
+            {
+                char c = 0;
+                file >> c;
+                value = c == '1' ? 0 : 255;
+            }
+            else
+            {
+                file >> value;
+                value = std::min(255, value * 255 / header[2]);
+            }
+            bitmap.pixels[i] = static_cast<std::uint8_t>(value);
+        }
+    }
+    if (!file)
+    {
+        throw std::runtime_error(path + ": faltan datos de la imagen");
+    }
+    return bitmap;
+}
+
+std::vector<Stroke> extractContours(const Bitmap& bitmap, int threshold, int tiles)
+{
+    // Filas de celdas de -1 a height - 1 (la primera y la última tocan el fondo exterior)
+    const int rows = bitmap.height + 1;
+    const int bands = std::max(1, std::min(threadCount(tiles), rows));
+    std::vector<std::vector<Chain> > found(bands);
+    parallelFor(static_cast<std::size_t>(bands), bands, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t b = begin; b < end; ++b)
+        {
+            const int y0 = -1 + static_cast<int>(rows * b / bands);
+            const int y1 = -1 + static_cast<int>(rows * (b + 1) / bands);
+            found[b] = traceBand(bitmap, threshold, y0, y1);
+        }
+    });
+
+    // Las cadenas abiertas acaban en el borde entre dos bandas, donde otra
+    // cadena empieza o termina con la misma clave
+    std::vector<const Chain*> open;
+    std::vector<Stroke> strokes;
+    const EdgeKeys keys(bitmap.width);
+    const auto emit = [&keys, &strokes](const std::vector<std::uint64_t>& chain, bool closed) {
+        Stroke stroke;
+        stroke.closed = closed;
+        stroke.points.resize(chain.size() * 2);
+        for (std::size_t i = 0; i < chain.size(); ++i)
+        {
+            keys.point(chain[i], stroke.points[2 * i], stroke.points[2 * i + 1]);
+        }
+        strokes.push_back(stroke);
+    };
+    for (int b = 0; b < bands; ++b)
+    {
+        for (std::size_t c = 0; c < found[b].size(); ++c)
+        {
+            if (found[b][c].closed)
+            {
+                emit(found[b][c].keys, true);
+            }
+            else
+            {
+                open.push_back(&found[b][c]);
+            }
+        }
+    }
+
+    // extremo -> (cadena, 0 = principio / 1 = final)
+    std::unordered_map<std::uint64_t, std::vector<std::pair<std::size_t, int> > > ends;
+    for (std::size_t c = 0; c < open.size(); ++c)
+    {
+        ends[open[c]->keys.front()].push_back(std::make_pair(c, 0));
+        ends[open[c]->keys.back()].push_back(std::make_pair(c, 1));
+    }
+    std::vector<bool> used(open.size(), false);
+    for (std::size_t first = 0; first < open.size(); ++first)
+    {
+        if (used[first])
+        {
+            continue;
+        }
+        std::vector<std::uint64_t> joined(open[first]->keys);
+        used[first] = true;
+        std::size_t current = first;
+        int exit_end = 1;
+        bool closed = false;
+        for (;;)
+        {
+            const std::vector<std::pair<std::size_t, int> >& at = ends[joined.back()];
+            std::size_t next = open.size();
+            int entry_end = 0;
+            for (std::size_t k = 0; k < at.size(); ++k)
+            {
+                if (at[k].first != current || at[k].second != exit_end)
+                {
+                    next = at[k].first;
+                    entry_end = at[k].second;
+                    break;
+                }
+            }
+            if (next == first)
+            {
+                closed = true;
+                break;
+            }
+            if (next == open.size() || used[next])
+            {
+                break;
+            }
+            used[next] = true;
+            const std::vector<std::uint64_t>& chain = open[next]->keys;
+            if (entry_end == 0)
+            {
+                joined.insert(joined.end(), chain.begin() + 1, chain.end());
+            }
+            else
+            {
+                joined.insert(joined.end(), chain.rbegin() + 1, chain.rend());
+            }
+            current = next;
+            exit_end = 1 - entry_end;
+        }
+        if (closed)
+        {
+            joined.pop_back();  // la clave del principio, repetida al cerrar
+        }
+        emit(joined, closed);
+    }
+    return strokes;
+}
+
+Stroke simplifyStroke(const Stroke& stroke, double tolerance)
+{
+    const std::size_t n = stroke.size();
+    if (n < 3)
+    {
+        return stroke;
+    }
+
+    Stroke simplified;
+    simplified.closed = stroke.closed;
+    if (!stroke.closed)
+    {
+        std::vector<bool> keep(n, false);
+        douglasPeucker(stroke.points.data(), 0, n - 1, tolerance, keep);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (keep[i])
+            {
+                simplified.points.push_back(stroke.points[2 * i]);
+                simplified.points.push_back(stroke.points[2 * i + 1]);
+            }
+        }
+        return simplified;
+    }
+
+    // Un lazo se parte por dos puntos extremos (el más alejado del primero y
+    // el más alejado de ese), que siempre se conservan: el primer punto del
+    // lazo puede estar en medio de un lado y no debe quedarse como vértice
+    const std::size_t a = farthestPoint(stroke.points, 0);
+    const std::size_t b = (farthestPoint(stroke.points, a) + n - a) % n;
+    std::vector<double> points;
+    points.reserve(2 * (n + 1));
+    for (std::size_t k = 0; k <= n; ++k)
+    {
+        const std::size_t i = (a + k) % n;
+        points.push_back(stroke.points[2 * i]);
+        points.push_back(stroke.points[2 * i + 1]);
+    }
+    std::vector<bool> keep(n + 1, false);
+    if (b > 0)
+    {
+        douglasPeucker(points.data(), 0, b, tolerance, keep);
+    }
+    douglasPeucker(points.data(), b, n, tolerance, keep);
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        if (keep[k])
+        {
+            simplified.points.push_back(points[2 * k]);
+            simplified.points.push_back(points[2 * k + 1]);
+        }
+    }
+    return simplified;
+}
+
+double penUpTravel(const std::vector<Stroke>& strokes)
+{
+    double travel = 0.0;
+    for (std::size_t i = 1; i < strokes.size(); ++i)
+    {
+        travel += distance(exitX(strokes[i - 1]), exitY(strokes[i - 1]), entryX(strokes[i]), entryY(strokes[i]));
+    }
+    return travel;
+}
+
+double orderStrokes(std::vector<Stroke>& strokes, int window)
+{
+    if (strokes.size() < 2)
+    {
+        return penUpTravel(strokes);
+    }
+
+    // El vecino más próximo puede salir peor que el orden recibido (que ya
+    // esté ordenado, o que empezar cerca de (0, 0) obligue a volver atrás):
+    // en ese caso se sigue con el recibido y el resultado nunca empeora
+    const double input_travel = penUpTravel(strokes);
+    std::vector<Stroke> input(strokes);
+
+    // Vecino más próximo desde la esquina (0, 0)
+    std::vector<Stroke> ordered;
+    ordered.reserve(strokes.size());
+    std::vector<bool> done(strokes.size(), false);
+    EntryGrid grid(strokes);
+    double x = 0.0;
+    double y = 0.0;
+    std::size_t s = 0;
+    std::size_t p = 0;
+    while (grid.nearest(x, y, done, s, p))
+    {
+        done[s] = true;
+        Stroke stroke;
+        stroke.closed = strokes[s].closed;
+        stroke.points.swap(strokes[s].points);
+        if (stroke.closed)
+        {
+            rotateStroke(stroke, p);
+        }
+        else if (p != 0)
+        {
+            reverseStroke(stroke);
+        }
+        x = exitX(stroke);
+        y = exitY(stroke);
+        ordered.push_back(Stroke());
+        ordered.back().closed = stroke.closed;
+        ordered.back().points.swap(stroke.points);
+    }
+    strokes.swap(penUpTravel(ordered) <= input_travel ? ordered : input);
+
+    // 2-opt: invertir el bloque [i, j] cambia solo los saltos de sus bordes
+    const std::size_t n = strokes.size();
+    const std::size_t span = static_cast<std::size_t>(std::max(1, window));
+    for (int pass = 0; pass < 8; ++pass)
+    {
+        bool improved = false;
+        for (std::size_t i = 0; i + 1 < n; ++i)
+        {
+            for (std::size_t j = i + 1; j < n && j <= i + span; ++j)
+            {
+                double before = 0.0;
+                double after = 0.0;
+                if (i > 0)
+                {
+                    const Stroke& prev = strokes[i - 1];
+                    before += distance(exitX(prev), exitY(prev), entryX(strokes[i]), entryY(strokes[i]));
+                    after += distance(exitX(prev), exitY(prev), exitX(strokes[j]), exitY(strokes[j]));
+                }
+                if (j + 1 < n)
+                {
+                    const Stroke& next = strokes[j + 1];
+                    before += distance(exitX(strokes[j]), exitY(strokes[j]), entryX(next), entryY(next));
+                    after += distance(entryX(strokes[i]), entryY(strokes[i]), entryX(next), entryY(next));
+                }
+                if (after < before - 1e-9)
+                {
+                    std::reverse(strokes.begin() + i, strokes.begin() + j + 1);
+                    for (std::size_t k = i; k <= j; ++k)
+                    {
+                        reverseStroke(strokes[k]);
+                    }
+                    improved = true;
+                }
+            }
+        }
+        if (!improved)
+        {
+            break;
+        }
+    }
+    return penUpTravel(strokes);
+}
+
+std::vector<DrawCommand> strokeCommands(const std::vector<Stroke>& strokes, const DrawingConfig& config)
+{
+    std::vector<DrawCommand> commands;
+    const double max_turn = config.max_angular * config.dt;
+    const double max_step = config.max_linear * config.dt;
+    bool pen_down = true;  // estado desconocido al empezar: se sube siempre
+
+    for (std::size_t s = 0; s < strokes.size(); ++s)
+    {
+        const Stroke& stroke = strokes[s];
+        const std::size_t n = stroke.size();
+        if (n < 2)
+        {
+            continue;
+        }
+        if (pen_down)
+        {
+            DrawCommand pen;
+            pen.kind = DrawCommand::PEN;
+            pen.pen_down = false;
+            commands.push_back(pen);
+        }
+
+        double x = stroke.points[0];
+        double y = stroke.points[1];
+        double theta = std::atan2(stroke.points[3] - y, stroke.points[2] - x);
+        DrawCommand teleport;
+        teleport.kind = DrawCommand::TELEPORT;
+        teleport.x = x;
+        teleport.y = y;
+        teleport.theta = theta;
+        commands.push_back(teleport);
+
+        DrawCommand pen;
+        pen.kind = DrawCommand::PEN;
+        pen.pen_down = true;
+        commands.push_back(pen);
+        pen_down = true;
+
+        const std::size_t moves = stroke.closed ? n : n - 1;
+        for (std::size_t i = 1; i <= moves; ++i)
+        {
+            const std::size_t k = i % n;
+            const double tx = stroke.points[2 * k];
+            const double ty = stroke.points[2 * k + 1];
+            const double length = distance(x, y, tx, ty);
+            if (length < 1e-9)
+            {
+                continue;
+            }
+
+            // Giro en el sitio y avance en línea recta, cada uno con el mínimo
+            // número de periodos que permiten las velocidades máximas
+            const double heading = std::atan2(ty - y, tx - x);
+            const double turn = normalizeAngle(heading - theta);
+            if (std::fabs(turn) > 1e-9)
+            {
+                DrawCommand rotate;
+                rotate.x = x;
+                rotate.y = y;
+                rotate.steps = static_cast<std::uint32_t>(std::ceil(std::fabs(turn) / max_turn - 1e-9));
+                rotate.twist = makeTwist(0.0, turn / (rotate.steps * config.dt));
+                commands.push_back(rotate);
+            }
+            DrawCommand advance;
+            advance.x = tx;
+            advance.y = ty;
+            advance.steps = static_cast<std::uint32_t>(std::ceil(length / max_step - 1e-9));
+            advance.twist = makeTwist(length / (advance.steps * config.dt), 0.0);
+            commands.push_back(advance);
+
+            x = tx;
+            y = ty;
+            theta = heading;
+        }
+    }
+    if (!commands.empty())
+    {
+        DrawCommand pen;
+        pen.kind = DrawCommand::PEN;
+        pen.pen_down = false;
+        commands.push_back(pen);
+    }
+    return commands;
+}
+
+DrawingPlan planDrawing(const Bitmap& bitmap, const DrawingConfig& config)
+{
+    if (config.tolerance < 0.0 || config.max_linear <= 0.0 || config.max_angular <= 0.0 || config.dt <= 0.0 ||
+        config.world_size <= 2.0 * config.margin)
+    {
+        throw std::invalid_argument("configuración de dibujo no válida");
+    }
+    if (bitmap.width <= 0 || bitmap.height <= 0)
+    {
+        throw std::invalid_argument("la imagen está vacía");
+    }
+
+    DrawingPlan plan;
+    DrawingStats& stats = plan.stats;
+    stats.tiles = threadCount(config.tiles);
+
+    Clock::time_point begin = Clock::now();
+    std::vector<Stroke> contours = extractContours(bitmap, config.threshold, stats.tiles);
+    stats.contour_time = secondsSince(begin);
+    stats.contours = contours.size();
+
+    // Los contornos cortos son ruido; el resto se simplifica en paralelo
+    begin = Clock::now();
+    std::vector<Stroke>& strokes = plan.strokes;
+    for (std::size_t i = 0; i < contours.size(); ++i)
+    {
+        if (strokeLength(contours[i]) >= config.min_length)
+        {
+            stats.points_in += contours[i].size();
+            strokes.push_back(Stroke());
+            strokes.back().closed = contours[i].closed;
+            strokes.back().points.swap(contours[i].points);
+        }
+    }
+    parallelFor(strokes.size(), stats.tiles, [&strokes, &config](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i)
+        {
+            strokes[i] = simplifyStroke(strokes[i], config.tolerance);
+        }
+    });
+    stats.simplify_time = secondsSince(begin);
+    stats.strokes = strokes.size();
+
+    // Píxeles -> mundo: centrado, con el eje y hacia arriba
+    const double scale = (config.world_size - 2.0 * config.margin) / std::max(bitmap.width, bitmap.height);
+    const double offset_x = 0.5 * (config.world_size - scale * bitmap.width);
+    const double offset_y = 0.5 * (config.world_size + scale * bitmap.height);
+    for (std::size_t s = 0; s < strokes.size(); ++s)
+    {
+        std::vector<double>& points = strokes[s].points;
+        for (std::size_t i = 0; i < points.size(); i += 2)
+        {
+            points[i] = offset_x + scale * points[i];
+            points[i + 1] = offset_y - scale * points[i + 1];
+        }
+        stats.points_out += strokes[s].size();
+        stats.drawn += strokeLength(strokes[s]);
+    }
+
+    begin = Clock::now();
+    stats.travel_before = penUpTravel(strokes);
+    stats.travel_after = orderStrokes(strokes, config.two_opt_window);
+    stats.order_time = secondsSince(begin);
+
+    begin = Clock::now();
+    plan.commands = strokeCommands(strokes, config);
+    stats.emit_time = secondsSince(begin);
+    for (std::size_t i = 0; i < plan.commands.size(); ++i)
+    {
+        stats.draw_time += plan.commands[i].steps * config.dt;
+    }
+    return plan;
+}
+
+double drawInSimulator(const std::vector<DrawCommand>& commands, Simulator& simulator, std::size_t turtle)
+{
+    double max_error = 0.0;
+    for (std::size_t i = 0; i < commands.size(); ++i)
+    {
+        const DrawCommand& command = commands[i];
+        switch (command.kind)
+        {
+        case DrawCommand::PEN:
+            simulator.setPen(turtle, command.pen_down);
+            break;
+        case DrawCommand::TELEPORT:
+            simulator.teleport(turtle, command.x, command.y, command.theta);
+            break;
+        case DrawCommand::TWIST:
+            // Se repite el comando en cada periodo, como un publicador a 1 / dt Hz
+            for (std::uint32_t k = 0; k < command.steps; ++k)
+            {
+                simulator.command(turtle, command.twist);
+                simulator.step();
+            }
+            if (command.twist.linear.x != 0.0)
+            {
+                const Pose pose = simulator.pose(turtle);
+                max_error = std::max(max_error, distance(pose.x, pose.y, command.x, command.y));
+            }
+            break;
+        }
+    }
+    simulator.command(turtle, Twist());
+    return max_error;
+}
+
+} // namespace turtle_unida
@@ -0,0 +1,302 @@
+#include "turtle_unida/executor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+
+#include "turtle_unida/parallel.h"
+
+namespace turtle_unida
+{
+
+namespace
+{
+
+typedef std::chrono::steady_clock Clock;
+
+double secondsSince(Clock::time_point begin)
+{
+    return std::chrono::duration<double>(Clock::now() - begin).count();
+}
+
+std::uint64_t pack(std::uint64_t first, std::uint64_t last)
+{
+    return first << 32 | last;
+}
+
+std::size_t rangeFirst(std::uint64_t range)
+{
+    return static_cast<std::size_t>(range >> 32);
+}
+
+std::size_t rangeLast(std::uint64_t range)
+{
+    return static_cast<std::size_t>(range & 0xffffffffu);
+}
+
+} // namespace
+
+ExecutorConfig::ExecutorConfig()
+    : threads(0), grain(16), deterministic(false)
+{
+}
+
+WorkerStats::WorkerStats()
+    : tasks(0), chunks(0), steals(0), failed(0), busy_time(0.0), wait_time(0.0)
+{
+}
+
+std::string WorkerStats::summary() const
+{
+    char buffer[160];
+    std::snprintf(buffer, sizeof(buffer), "tasks=%llu chunks=%llu steals=%llu failed=%llu busy_ms=%.2f wait_ms=%.2f",
+        static_cast<unsigned long long>(tasks), static_cast<unsigned long long>(chunks),
+        static_cast<unsigned long long>(steals), static_cast<unsigned long long>(failed), busy_time * 1e3,
+        wait_time * 1e3);
+    return buffer;
+}
+
+WorkStealingExecutor::Worker::Worker()
+    : range(0), seed(0)
+{
+}
+
+WorkStealingExecutor::WorkStealingExecutor(const ExecutorConfig& config)
+    : config_(config), ticks_(0), generation_(0), pending_(0), stop_(false), body_(nullptr)
+{
+    if (config_.grain == 0)
+    {
+        throw std::invalid_argument("el bloque del ejecutor debe tener al menos un índice");
+    }
+    const int count = threadCount(config_.threads);
+    for (int i = 0; i < count; ++i)
+    {
+        workers_.push_back(std::unique_ptr<Worker>(new Worker()));
+        workers_.back()->seed = 0x9e3779b9u * static_cast<std::uint32_t>(i + 1);
+    }
+    for (int i = 1; i < count; ++i)
+    {
+        threads_.push_back(std::thread(&WorkStealingExecutor::loop, this, i));
+    }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    start_.notify_all();
+    for (std::size_t i = 0; i < threads_.size(); ++i)
+    {
+        threads_[i].join();
+    }
+}
+
+void WorkStealingExecutor::run(std::size_t count, const Body& body)
+{
+    if (count >= 0xffffffffu)
+    {
+        throw std::invalid_argument("demasiados índices para el ejecutor");
+    }
+    const std::size_t n = workers_.size();
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        workers_[k]->range.store(pack(count * k / n, count * (k + 1) / n), std::memory_order_relaxed);
+    }
+    ++ticks_;
+
+    // Sin hilos auxiliares o sin trabajo para ellos no hace falta despertarlos
+    if (n == 1 || count <= config_.grain)
+    {
+        workers_[0]->range.store(pack(0, count), std::memory_order_relaxed);
+        for (std::size_t k = 1; k < n; ++k)
+        {
+            workers_[k]->range.store(0, std::memory_order_relaxed);
+        }
+        body_ = &body;
+        work(0);
+        body_ = nullptr;
+    }
+    else
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            body_ = &body;
+            pending_ = static_cast<int>(n - 1);
+            ++generation_;
+        }
+        start_.notify_all();
+        work(0);
+        workers_[0]->done = Clock::now();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        finished_.wait(lock, [this]() { return pending_ == 0; });
+        body_ = nullptr;
+
+        // Cada hilo espera desde que acaba su parte hasta que acaba el último;
+        // los auxiliares anotaron `done` antes de bajar pending_ con el cerrojo
+        const Clock::time_point end = Clock::now();
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            Worker& worker = *workers_[k];
+            worker.stats.wait_time += std::chrono::duration<double>(end - worker.done).count();
+        }
+    }
+
+    if (error_)
+    {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void WorkStealingExecutor::loop(int index)
+{
+    std::uint64_t seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_.wait(lock, [this, seen]() { return stop_ || generation_ != seen; });
+            if (stop_)
+            {
+                return;
+            }
+            seen = generation_;
+        }
+        work(index);
+        workers_[index]->done = Clock::now();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0)
+            {
+                finished_.notify_one();
+            }
+        }
+    }
+}
+
+void WorkStealingExecutor::work(int index)
+{
+    Worker& worker = *workers_[index];
+    std::size_t first;
+    std::size_t last;
+    for (;;)
+    {
+        while (take(worker, first, last))
+        {
+            const Clock::time_point begin = Clock::now();
+            try
+            {
+                (*body_)(first, last);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_)
+                {
+                    error_ = std::current_exception();
+                }
+            }
+            worker.stats.busy_time += secondsSince(begin);
+            worker.stats.tasks += last - first;
+            ++worker.stats.chunks;
+        }
+        if (config_.deterministic || !steal(index))
+        {
+            return;
+        }
+    }
+}
+
+bool WorkStealingExecutor::take(Worker& worker, std::size_t& first, std::size_t& last)
+{
+    std::uint64_t range = worker.range.load(std::memory_order_acquire);
+    for (;;)
+    {
+        const std::size_t begin = rangeFirst(range);
+        const std::size_t end = rangeLast(range);
+        if (begin >= end)
+        {
+            return false;
+        }
+        const std::size_t next = std::min(end, begin + config_.grain);
+        if (worker.range.compare_exchange_weak(range, pack(next, end), std::memory_order_acq_rel))
+        {
+            first = begin;
+            last = next;
+            return true;
+        }
+    }
+}
+
+bool WorkStealingExecutor::steal(int thief)
+{
+    // Víctimas en orden desde una al azar; se lleva la mitad final de su tramo
+    Worker& self = *workers_[thief];
+    const std::size_t n = workers_.size();
+    self.seed = self.seed * 1664525u + 1013904223u;
+    const std::size_t start = (self.seed >> 8) % n;
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        const std::size_t victim = (start + k) % n;
+        if (victim == static_cast<std::size_t>(thief))
+        {
+            continue;
+        }
+        std::atomic<std::uint64_t>& range = workers_[victim]->range;
+        std::uint64_t current = range.load(std::memory_order_acquire);
+        for (;;)
+        {
+            const std::size_t begin = rangeFirst(current);
+            const std::size_t end = rangeLast(current);
+            if (begin >= end)
+            {
+                break;
+            }
+            const std::size_t middle = begin + (end - begin) / 2;
+            if (range.compare_exchange_weak(current, pack(begin, middle), std::memory_order_acq_rel))
+            {
+                // El tramo robado pasa a ser el propio y otros pueden robarlo a su vez
+                self.range.store(pack(middle, end), std::memory_order_release);
+                ++self.stats.steals;
+                return true;
+            }
+        }
+    }
+    ++self.stats.failed;
+    return false;
+}
+
+std::string WorkStealingExecutor::summary() const
+{
+    WorkerStats total;
+    double max_busy = 0.0;
+    double max_wait = 0.0;
+    for (std::size_t i = 0; i < workers_.size(); ++i)
+    {
+        const WorkerStats& stats = workers_[i]->stats;
+        total.tasks += stats.tasks;
+        total.chunks += stats.chunks;
+        total.steals += stats.steals;
+        total.failed += stats.failed;
+        total.busy_time += stats.busy_time;
+        total.wait_time += stats.wait_time;
+        max_busy = std::max(max_busy, stats.busy_time);
+        max_wait = std::max(max_wait, stats.wait_time);
+    }
+
+    // Equilibrio: trabajo medio por hilo / trabajo del hilo más cargado (1 = perfecto)
+    // wait_ms suma la espera de todos los hilos; max_wait_ms es la del que más esperó
+    char buffer[256];
+    std::snprintf(buffer, sizeof(buffer), "threads=%d ticks=%llu %s max_wait_ms=%.2f balance=%.2f%s", threads(),
+        static_cast<unsigned long long>(ticks_), total.summary().c_str(), max_wait * 1e3,
+        max_busy > 0.0 ? total.busy_time / (workers_.size() * max_busy) : 1.0,
+        config_.deterministic ? " deterministic" : "");
+    return buffer;
+}
+
+} // namespace turtle_unida
@@ -0,0 +1,120 @@
+#include "turtle_unida/fleet.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+#include "turtle_unida/latency.h"
+
+namespace turtle_unida
+{
+
+FleetStats::FleetStats()
+    : ticks(0), published(0), max_tick_time(0.0)
+{
+}
+
+Fleet::Fleet(Transport& transport)
+    : transport_(transport), stamp_(false)
+{
+}
+
+std::size_t Fleet::addTrajectory(const Trajectory& trajectory)
+{
+    trajectories_.push_back(trajectory);
+    return trajectories_.size() - 1;
+}
+
+std::size_t Fleet::addTurtle(const std::string& topic, std::size_t trajectory, double offset)
+{
+    if (trajectory >= trajectories_.size())
+    {
+        throw std::out_of_range("trayectoria no registrada");
+    }
+    trajectory_.push_back(static_cast<std::uint32_t>(trajectory));
+    offset_.push_back(offset);
+    channel_.push_back(transport_.advertise(topic));
+    topic_.push_back(topic);
+    linear_.push_back(0.0);
+    angular_.push_back(0.0);
+    if (avoidance_)
+    {
+        watchPose(channel_.size() - 1);
+    }
+    return channel_.size() - 1;
+}
+
+void Fleet::enableAvoidance(const AvoidanceConfig& config)
+{
+    if (avoidance_)
+    {
+        throw std::logic_error("la evitación de colisiones ya está activa");
+    }
+    avoidance_.reset(new CollisionAvoidance(config));
+    for (std::size_t i = 0; i < channel_.size(); ++i)
+    {
+        watchPose(i);
+    }
+}
+
+void Fleet::watchPose(std::size_t turtle)
+{
+    // "/turtle3/cmd_vel" -> "/turtle3/pose"
+    const std::string& topic = topic_[turtle];
+    const std::size_t slash = topic.rfind('/');
+    const std::string pose_topic = (slash == std::string::npos ? std::string() : topic.substr(0, slash + 1)) + "pose";
+    const std::size_t agent = avoidance_->add();
+    CollisionAvoidance* avoidance = avoidance_.get();
+    transport_.subscribe(pose_topic, [avoidance, agent](const Pose& pose) { avoidance->setPose(agent, pose); });
+}
+
+void Fleet::tick(double t)
+{
+    const std::size_t n = channel_.size();
+
+    // Evalúa todas las consignas
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const Twist twist = trajectories_[trajectory_[i]].sample(t + offset_[i]);
+        linear_[i] = twist.linear.x;
+        angular_[i] = twist.angular.z;
+    }
+    if (avoidance_)
+    {
+        avoidance_->apply(linear_.data(), angular_.data());
+    }
+
+    // Publica el lote completo; todos los comandos del lote se generaron a la vez
+    Twist stamped = Twist();
+    if (stamp_)
+    {
+        stampGenerated(stamped);
+    }
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        Twist twist = makeTwist(linear_[i], angular_[i]);
+        twist.linear.z = stamped.linear.z;
+        transport_.publish(channel_[i], twist);
+    }
+    transport_.flush();
+
+    ++stats_.ticks;
+    stats_.published += n;
+}
+
+void Fleet::run(PeriodicScheduler& scheduler, const std::function<bool()>& ok)
+{
+    typedef PeriodicScheduler::Clock Clock;
+    scheduler.reset();
+    while (ok())
+    {
+        const double t = scheduler.wait().time;
+
+        const Clock::time_point begin = Clock::now();
+        tick(t);
+        const double elapsed = std::chrono::duration<double>(Clock::now() - begin).count();
+        stats_.max_tick_time = std::max(stats_.max_tick_time, elapsed);
+    }
+}
+
+} // namespace turtle_unida
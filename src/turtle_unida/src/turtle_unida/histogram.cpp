@@ -0,0 +1,126 @@
+#include "turtle_unida/histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace turtle_unida
+{
+
+namespace
+{
+
+// Posición del bit más significativo (value > 0)
+int highestBit(std::uint64_t value)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return static_cast<int>(index);
+#else
+    return 63 - __builtin_clzll(value);
+#endif
+}
+
+} // namespace
+
+Histogram::Histogram()
+{
+    reset();
+}
+
+std::size_t Histogram::bucketOf(std::uint64_t value)
+{
+    const std::uint64_t limit = (static_cast<std::uint64_t>(1) << MAX_VALUE_BITS) - 1;
+    value = std::min(value, limit);
+    if (value < static_cast<std::uint64_t>(SUB_BUCKETS))
+    {
+        return static_cast<std::size_t>(value);
+    }
+    const int shift = highestBit(value) - SUB_BUCKET_BITS;
+    return static_cast<std::size_t>(shift + 1) * SUB_BUCKETS +
+        static_cast<std::size_t>((value >> shift) & (SUB_BUCKETS - 1));
+}
+
+std::uint64_t Histogram::upperBound(std::size_t bucket)
+{
+    const std::size_t group = bucket / SUB_BUCKETS;
+    const std::uint64_t sub = bucket % SUB_BUCKETS;
+    if (group == 0)
+    {
+        return sub;
+    }
+    const int shift = static_cast<int>(group) - 1;
+    return ((SUB_BUCKETS + sub + 1) << shift) - 1;
+}
+
+void Histogram::record(std::uint64_t value)
+{
+    ++counts_[bucketOf(value)];
+    ++count_;
+    sum_ += value;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+}
+
+void Histogram::recordSeconds(double seconds)
+{
+    record(seconds > 0.0 ? static_cast<std::uint64_t>(seconds * 1e9 + 0.5) : 0);
+}
+
+void Histogram::merge(const Histogram& other)
+{
+    for (int i = 0; i < BUCKETS; ++i)
+    {
+        counts_[i] += other.counts_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+
+void Histogram::reset()
+{
+    std::memset(counts_, 0, sizeof(counts_));
+    count_ = 0;
+    sum_ = 0;
+    min_ = UINT64_MAX;
+    max_ = 0;
+}
+
+std::uint64_t Histogram::percentile(double q) const
+{
+    if (count_ == 0)
+    {
+        return 0;
+    }
+    const double clamped = std::max(0.0, std::min(1.0, q));
+    const std::uint64_t target = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(clamped * count_)));
+    std::uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; ++i)
+    {
+        seen += counts_[i];
+        if (seen >= target)
+        {
+            return std::min(upperBound(i), max_);
+        }
+    }
+    return max_;
+}
+
+std::string Histogram::summary() const
+{
+    char buffer[160];
+    std::snprintf(buffer, sizeof(buffer), "n=%llu p50=%.1f p99=%.1f p99.9=%.1f max=%.1f us",
+        static_cast<unsigned long long>(count_), percentile(0.5) * 1e-3, percentile(0.99) * 1e-3,
+        percentile(0.999) * 1e-3, max_ * 1e-3);
+    return buffer;
+}
+
+} // namespace turtle_unida
@@ -0,0 +1,107 @@
+#include "turtle_unida/latency.h"
+
+#include <chrono>
+#include <cstdio>
+
+namespace turtle_unida
+{
+
+namespace
+{
+
+std::uint64_t fromField(double value)
+{
+    return value > 0.0 ? static_cast<std::uint64_t>(value) : 0;
+}
+
+// Diferencia b - a; 0 si el reloj de alguna marca no cuadra
+std::uint64_t elapsed(std::uint64_t a, std::uint64_t b)
+{
+    return b > a ? b - a : 0;
+}
+
+// "p50/p99/p99.9/max" en microsegundos
+std::string compact(const Histogram& histogram)
+{
+    char buffer[96];
+    std::snprintf(buffer, sizeof(buffer), "%.1f/%.1f/%.1f/%.1f", histogram.percentile(0.5) * 1e-3,
+        histogram.percentile(0.99) * 1e-3, histogram.percentile(0.999) * 1e-3, histogram.max() * 1e-3);
+    return buffer;
+}
+
+} // namespace
+
+std::uint64_t monotonicNanos()
+{
+    // steady_clock es CLOCK_MONOTONIC en Linux y QueryPerformanceCounter en Windows
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+CommandStamp::CommandStamp()
+    : generated(0), enqueued(0), sent(0)
+{
+}
+
+void stampGenerated(Twist& twist)
+{
+    twist.linear.z = static_cast<double>(monotonicNanos());
+}
+
+void stampEnqueued(Twist& twist)
+{
+    twist.angular.x = static_cast<double>(monotonicNanos());
+}
+
+void stampSent(Twist& twist)
+{
+    twist.angular.y = static_cast<double>(monotonicNanos());
+}
+
+bool readStamp(const Twist& twist, CommandStamp& stamp)
+{
+    if (!isStamped(twist))
+    {
+        return false;
+    }
+    stamp.generated = fromField(twist.linear.z);
+    stamp.enqueued = fromField(twist.angular.x);
+    stamp.sent = fromField(twist.angular.y);
+    return true;
+}
+
+LatencyStats::LatencyStats()
+    : unstamped_(0)
+{
+}
+
+void LatencyStats::record(const CommandStamp& stamp, std::uint64_t received)
+{
+    // Un emisor que no separa las fases (p. ej. mover.py) repite la marca anterior
+    const std::uint64_t enqueued = stamp.enqueued ? stamp.enqueued : stamp.generated;
+    const std::uint64_t sent = stamp.sent ? stamp.sent : enqueued;
+    end_to_end_.record(elapsed(stamp.generated, received));
+    queue_.record(elapsed(stamp.generated, enqueued));
+    send_.record(elapsed(enqueued, sent));
+    wire_.record(elapsed(sent, received));
+}
+
+void LatencyStats::reset()
+{
+    end_to_end_.reset();
+    queue_.reset();
+    send_.reset();
+    wire_.reset();
+    unstamped_ = 0;
+}
+
+std::string LatencyStats::summary() const
+{
+    char buffer[320];
+    std::snprintf(buffer, sizeof(buffer), "n=%llu unstamped=%llu e2e_us=%s queue_us=%s send_us=%s wire_us=%s",
+        static_cast<unsigned long long>(end_to_end_.count()), static_cast<unsigned long long>(unstamped_),
+        compact(end_to_end_).c_str(), compact(queue_).c_str(), compact(send_).c_str(), compact(wire_).c_str());
+    return buffer;
+}
+
+} // namespace turtle_unida
@@ -0,0 +1,260 @@
+#include "turtle_unida/launch_cache.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include <limits.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "turtle_unida/launcher.h"
+
+namespace turtle_unida
+{
+
+namespace
+{
+
+// Primera línea del fichero; si cambia el formato se ignora la caché entera
+const char HEADER[] = "turtle_unida-launch-cache 1";
+
+bool stampOf(const std::string& path, std::int64_t& mtime, std::int64_t& size, std::uint64_t& inode)
+{
+    struct stat info;
+    if (::stat(path.c_str(), &info) != 0)
+    {
+        return false;
+    }
+    mtime =
+        static_cast<std::int64_t>(info.st_mtim.tv_sec) * 1000000000 + static_cast<std::int64_t>(info.st_mtim.tv_nsec);
+    size = static_cast<std::int64_t>(info.st_size);
+    inode = static_cast<std::uint64_t>(info.st_ino);
+    return true;
+}
+
+// Los campos van separados por tabuladores y las entradas por líneas
+bool storable(const std::string& text)
+{
+    return !text.empty() && text.find_first_of("\t\n") == std::string::npos;
+}
+
+std::vector<std::string> splitTabs(const std::string& line)
+{
+    std::vector<std::string> fields;
+    std::size_t begin = 0;
+    for (;;)
+    {
+        const std::size_t tab = line.find('\t', begin);
+        fields.push_back(line.substr(begin, tab == std::string::npos ? std::string::npos : tab - begin));
+        if (tab == std::string::npos)
+        {
+            return fields;
+        }
+        begin = tab + 1;
+    }
+}
+
+// Crea el directorio del fichero y su padre (~/.cache puede no existir)
+void makeParents(const std::string& file)
+{
+    const std::size_t slash = file.find_last_of('/');
+    if (slash == std::string::npos || slash == 0)
+    {
+        return;
+    }
+    const std::string dir = file.substr(0, slash);
+    const std::size_t parent = dir.find_last_of('/');
+    if (parent != std::string::npos && parent > 0)
+    {
+        ::mkdir(dir.substr(0, parent).c_str(), 0700);
+    }
+    ::mkdir(dir.c_str(), 0700);
+}
+
+// Clave de la caché: la ruta absoluta, para que "mover.py" desde dos
+// directorios distintos no se pisen la entrada
+std::string absolutePath(const std::string& path)
+{
+    if (path.empty() || path[0] == '/')
+    {
+        return path;
+    }
+    char cwd[PATH_MAX];
+    if (!::getcwd(cwd, sizeof(cwd)))
+    {
+        return path;
+    }
+    return std::string(cwd) + "/" + path;
+}
+
+} // namespace
+
+LaunchCacheStats::LaunchCacheStats()
+    : hits(0), misses(0), invalidated(0), loaded(0)
+{
+}
+
+std::string LaunchCacheStats::summary() const
+{
+    char buffer[128];
+    std::snprintf(buffer, sizeof(buffer), "hits=%ld misses=%ld invalidated=%ld loaded=%ld", hits, misses, invalidated,
+        loaded);
+    return buffer;
+}
+
+LaunchCache::LaunchCache(const std::string& file)
+    : file_(file), dirty_(false)
+{
+    if (!file_.empty())
+    {
+        load();
+        stats_.loaded = static_cast<long>(entries_.size());
+    }
+}
+
+std::vector<std::string> LaunchCache::interpreter(const std::string& path, bool& cached)
+{
+    const std::string script = absolutePath(path);
+    std::int64_t mtime = 0;
+    std::int64_t size = 0;
+    std::uint64_t inode = 0;
+    const bool exists = stampOf(script, mtime, size, inode);
+
+    if (exists)
+    {
+        const std::unordered_map<std::string, Entry>::const_iterator found = entries_.find(script);
+        if (found != entries_.end() && found->second.mtime == mtime && found->second.size == size &&
+            found->second.inode == inode)
+        {
+            ++stats_.hits;
+            cached = true;
+            return found->second.command;
+        }
+    }
+
+    ++stats_.misses;
+    cached = false;
+    std::vector<std::string> command = getPythonExecutable(script);
+    if (exists)
+    {
+        Entry& entry = entries_[script];
+        entry.mtime = mtime;
+        entry.size = size;
+        entry.inode = inode;
+        entry.command = command;
+        forgotten_.erase(script);
+        dirty_ = true;
+    }
+    return command;
+}
+
+void LaunchCache::invalidate(const std::string& path)
+{
+    const std::string script = absolutePath(path);
+    forgotten_.insert(script);
+    if (entries_.erase(script) > 0)
+    {
+        ++stats_.invalidated;
+        dirty_ = true;
+    }
+}
+
+bool LaunchCache::save()
+{
+    if (file_.empty() || !dirty_)
+    {
+        return true;
+    }
+
+    // Otros lanzadores pueden haber guardado entradas desde que se cargó: se
+    // añaden las que falten para no perderlas al reemplazar el fichero
+    load();
+
+    makeParents(file_);
+    const std::string temporary = file_ + "." + std::to_string(::getpid());
+    {
+        std::ofstream out(temporary.c_str(), std::ios::trunc);
+        out << HEADER << '\n';
+        for (std::unordered_map<std::string, Entry>::const_iterator it = entries_.begin(); it != entries_.end(); ++it)
+        {
+            bool valid = storable(it->first);
+            for (std::size_t i = 0; i < it->second.command.size(); ++i)
+            {
+                valid = valid && storable(it->second.command[i]);
+            }
+            if (!valid)
+            {
+                continue;
+            }
+            out << it->second.mtime << '\t' << it->second.size << '\t' << it->second.inode << '\t' << it->first;
+            for (std::size_t i = 0; i < it->second.command.size(); ++i)
+            {
+                out << '\t' << it->second.command[i];
+            }
+            out << '\n';
+        }
+        if (!out.flush())
+        {
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+    if (std::rename(temporary.c_str(), file_.c_str()) != 0)
+    {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    dirty_ = false;
+    return true;
+}
+
+std::string LaunchCache::defaultFile()
+{
+    const char* file = std::getenv("TURTLE_UNIDA_LAUNCH_CACHE_FILE");
+    if (file && *file)
+    {
+        return file;
+    }
+    const char* xdg = std::getenv("XDG_CACHE_HOME");
+    if (xdg && *xdg == '/')
+    {
+        return std::string(xdg) + "/turtle_unida/launcher";
+    }
+    const char* home = std::getenv("HOME");
+    if (home && *home == '/')
+    {
+        return std::string(home) + "/.cache/turtle_unida/launcher";
+    }
+    return std::string();
+}
+
+void LaunchCache::load()
+{
+    std::ifstream in(file_.c_str());
+    std::string line;
+    if (!std::getline(in, line) || line != HEADER)
+    {
+        return;
+    }
+    // Las entradas en memoria mandan sobre las del fichero
+    while (std::getline(in, line))
+    {
+        const std::vector<std::string> fields = splitTabs(line);
+        if (fields.size() < 5 || entries_.count(fields[3]) > 0 || forgotten_.count(fields[3]) > 0)
+        {
+            continue;
+        }
+        Entry entry;
+        std::istringstream stamp(fields[0] + ' ' + fields[1] + ' ' + fields[2]);
+        if (!(stamp >> entry.mtime >> entry.size >> entry.inode))
+        {
+            continue;
+        }
+        entry.command.assign(fields.begin() + 4, fields.end());
+        entries_.insert(std::make_pair(fields[3], entry));
+    }
+}
+
+} // namespace turtle_unida
@@ -0,0 +1,365 @@
+#include "turtle_unida/launcher.h"
+
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <limits.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "turtle_unida/launch_cache.h"
+
+extern char** environ;
+
+namespace turtle_unida
+{
+
+namespace
+{
+
+typedef std::chrono::steady_clock Clock;
+
+const char SHEBANG[] = "#!";
+const char DEFAULT_PYTHON[] = "python3";
+
+double secondsSince(Clock::time_point begin)
+{
+    return std::chrono::duration<double>(Clock::now() - begin).count();
+}
+
+std::runtime_error systemError(const std::string& what)
+{
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+// Señales que se reenvían al hijo mientras el lanzador espera
+const int FORWARDED[] = {SIGINT, SIGTERM, SIGHUP, SIGQUIT};
+const int FORWARDED_COUNT = sizeof(FORWARDED) / sizeof(FORWARDED[0]);
+
+volatile sig_atomic_t g_child = 0;
+volatile sig_atomic_t g_only_sent = 1;
+
+void forwardSignal(int signal, siginfo_t* info, void*)
+{
+    const bool sent = info && (info->si_code == SI_USER || info->si_code == SI_QUEUE);
+    if (g_child > 0 && (sent || !g_only_sent))
+    {
+        ::kill(static_cast<pid_t>(g_child), signal);
+    }
+}
+
+// argv para exec: punteros a las cadenas de argv terminados en nullptr
+std::vector<char*> argvPointers(const std::vector<std::string>& argv)
+{
+    if (argv.empty())
+    {
+        throw std::invalid_argument("no hay nada que lanzar");
+    }
+    std::vector<char*> args;
+    args.reserve(argv.size() + 1);
+    for (std::size_t i = 0; i < argv.size(); ++i)
+    {
+        args.push_back(const_cast<char*>(argv[i].c_str()));
+    }
+    args.push_back(nullptr);
+    return args;
+}
+
+// Resuelve el intérprete de path (con la caché si la hay) y llama a
+// start(argv) con el intérprete, el script y los argumentos. Si el intérprete
+// venía de la caché y start falla, lo olvida y lo intenta una vez más con el
+// shebang recién leído.
+template <class Start>
+void startScript(const std::string& path, const std::vector<std::string>& args, LaunchTiming& timing,
+    LaunchCache* cache, Start start)
+{
+    Clock::time_point begin = Clock::now();
+    std::vector<std::string> argv = cache ? cache->interpreter(path, timing.cached) : getPythonExecutable(path);
+    timing.interpreter = secondsSince(begin);
+
+    const std::size_t interpreter_args = argv.size();
+    argv.push_back(path);
+    argv.insert(argv.end(), args.begin(), args.end());
+    begin = Clock::now();
+    try
+    {
+        start(argv);
+    }
+    catch (const std::runtime_error&)
+    {
+        if (!timing.cached)
+        {
+            throw;
+        }
+        // El intérprete de la caché ya no está: se resuelve de nuevo
+        cache->invalidate(path);
+        std::vector<std::string> fresh = cache->interpreter(path, timing.cached);
+        argv.erase(argv.begin(), argv.begin() + static_cast<std::ptrdiff_t>(interpreter_args));
+        argv.insert(argv.begin(), fresh.begin(), fresh.end());
+        start(argv);
+    }
+    timing.spawn = secondsSince(begin);
+}
+
+} // namespace
+
+LaunchTiming::LaunchTiming()
+    : executable(0.0),
+      script(0.0),
+      interpreter(0.0),
+      spawn(0.0),
+      run(0.0),
+      pid(0),
+      exit_code(0),
+      cached(false),
+      zygote(false),
+      exec(false)
+{
+}
+
+std::string LaunchTiming::json(const std::string& name) const
+{
+    char buffer[384];
+    std::snprintf(buffer, sizeof(buffer),
+        "{\"launch\":\"%s\",\"pid\":%d,\"exit\":%d,\"cached\":%s,\"zygote\":%s,\"exec\":%s,"
+        "\"executable_us\":%.1f,\"script_us\":%.1f,\"interpreter_us\":%.1f,\"spawn_us\":%.1f,\"run_s\":%.3f}",
+        name.c_str(), pid, exit_code, cached ? "true" : "false", zygote ? "true" : "false", exec ? "true" : "false",
+        executable * 1e6, script * 1e6, interpreter * 1e6, spawn * 1e6, run);
+    return buffer;
+}
+
+std::string currentExecutable(const std::string& argv0)
+{
+    if (argv0.find('/') != std::string::npos)
+    {
+        if (argv0[0] == '/')
+        {
+            return argv0;
+        }
+        char cwd[PATH_MAX];
+        if (!::getcwd(cwd, sizeof(cwd)))
+        {
+            throw systemError("getcwd");
+        }
+        return std::string(cwd) + "/" + argv0;
+    }
+
+    char path[PATH_MAX];
+    const ssize_t length = ::readlink("/proc/self/exe", path, sizeof(path) - 1);
+    if (length <= 0)
+    {
+        throw systemError("readlink(/proc/self/exe)");
+    }
+    return std::string(path, static_cast<std::size_t>(length));
+}
+
+std::string findPythonScript(const std::string& executable)
+{
+    const std::size_t slash = executable.find_last_of('/');
+    if (slash == std::string::npos)
+    {
+        throw std::runtime_error("ruta sin directorio: " + executable);
+    }
+    return executable + ".py";
+}
+
+std::vector<std::string> getPythonExecutable(const std::string& script)
+{
+    std::ifstream file(script.c_str());
+    std::string line;
+    std::vector<std::string> command;
+    if (std::getline(file, line) && line.compare(0, sizeof(SHEBANG) - 1, SHEBANG) == 0)
+    {
+        // Espacios y tabuladores separan el intérprete de sus argumentos
+        const char* blanks = " \t\r";
+        std::size_t begin = line.find_first_not_of(blanks, sizeof(SHEBANG) - 1);
+        while (begin != std::string::npos)
+        {
+            const std::size_t end = line.find_first_of(blanks, begin);
+            command.push_back(line.substr(begin, end == std::string::npos ? std::string::npos : end - begin));
+            begin = line.find_first_not_of(blanks, end);
+        }
+    }
+
+    // Por defecto el Python del entorno, como python.exe en Windows
+    if (command.empty() || ::access(command[0].c_str(), X_OK) != 0)
+    {
+        command.assign(1, DEFAULT_PYTHON);
+    }
+    return command;
+}
+
+int spawnProcess(const std::vector<std::string>& argv)
+{
+    std::vector<char*> args = argvPointers(argv);
+
+    // El hijo empieza sin señales bloqueadas y con todas en su acción por
+    // defecto, aunque el lanzador tenga manejadores instalados
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    sigset_t none;
+    sigset_t all;
+    sigemptyset(&none);
+    sigfillset(&all);
+    posix_spawnattr_setsigmask(&attr, &none);
+    posix_spawnattr_setsigdefault(&attr, &all);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF);
+
+    // glibc no vuelve de posix_spawn hasta que el hijo ha hecho exec (o ha
+    // fallado, y entonces devuelve el error), así que es el tiempo hasta el exec
+    pid_t pid = 0;
+    const int error = ::posix_spawnp(&pid, args[0], nullptr, &attr, args.data(), environ);
+    posix_spawnattr_destroy(&attr);
+    if (error != 0)
+    {
+        throw std::runtime_error("posix_spawn(" + argv[0] + "): " + std::strerror(error));
+    }
+    return pid;
+}
+
+void execProcess(const std::vector<std::string>& argv)
+{
+    std::vector<char*> args = argvPointers(argv);
+
+    // Como en spawnProcess: sin señales bloqueadas y todas por defecto (las
+    // que tienen manejador ya vuelven a su acción por defecto con el exec,
+    // pero no las ignoradas)
+    for (int signal = 1; signal < NSIG; ++signal)
+    {
+        if (signal != SIGKILL && signal != SIGSTOP)
+        {
+            ::signal(signal, SIG_DFL);
+        }
+    }
+    sigset_t none;
+    sigemptyset(&none);
+    ::sigprocmask(SIG_SETMASK, &none, nullptr);
+
+    ::execvp(args[0], args.data());
+    throw systemError("exec(" + argv[0] + ")");
+}
+
+SignalForwarder::SignalForwarder(int pid, bool only_sent)
+{
+    static_assert(FORWARDED_COUNT == SIGNALS, "una acción previa por señal reenviada");
+    struct sigaction forward;
+    std::memset(&forward, 0, sizeof(forward));
+    forward.sa_sigaction = forwardSignal;
+    forward.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&forward.sa_mask);
+    g_child = pid;
+    g_only_sent = only_sent;
+    for (int i = 0; i < FORWARDED_COUNT; ++i)
+    {
+        ::sigaction(FORWARDED[i], &forward, &previous_[i]);
+    }
+}
+
+SignalForwarder::~SignalForwarder()
+{
+    g_child = 0;
+    for (int i = 0; i < FORWARDED_COUNT; ++i)
+    {
+        ::sigaction(FORWARDED[i], &previous_[i], nullptr);
+    }
+}
+
+int waitProcess(int pid)
+{
+    int status = 0;
+    pid_t result;
+    {
+        SignalForwarder forwarder(pid, true);
+        do
+        {
+            result = ::waitpid(static_cast<pid_t>(pid), &status, 0);
+        } while (result < 0 && errno == EINTR);
+    }
+
+    if (result < 0)
+    {
+        throw systemError("waitpid");
+    }
+    if (WIFSIGNALED(status))
+    {
+        return 128 + WTERMSIG(status);
+    }
+    return WEXITSTATUS(status);
+}
+
+std::string scriptPath(const std::string& argv0, const std::string& script, LaunchTiming& timing)
+{
+    Clock::time_point begin = Clock::now();
+    if (!script.empty())
+    {
+        timing.script = secondsSince(begin);
+        return script;
+    }
+    const std::string executable = currentExecutable(argv0);
+    timing.executable = secondsSince(begin);
+    begin = Clock::now();
+    const std::string path = findPythonScript(executable);
+    timing.script = secondsSince(begin);
+    return path;
+}
+
+int spawnScript(const std::string& path, const std::vector<std::string>& args, LaunchTiming& timing, LaunchCache* cache)
+{
+    startScript(path, args, timing, cache, [&timing](const std::vector<std::string>& argv) {
+        timing.pid = spawnProcess(argv);
+    });
+    return timing.pid;
+}
+
+int launchScript(const std::string& argv0, const std::string& script, const std::vector<std::string>& args,
+    LaunchTiming& timing, LaunchCache* cache)
+{
+    spawnScript(scriptPath(argv0, script, timing), args, timing, cache);
+
+    // Mientras el hijo arranca
+    if (cache)
+    {
+        cache->save();
+    }
+
+    const Clock::time_point begin = Clock::now();
+    timing.exit_code = waitProcess(timing.pid);
+    timing.run = secondsSince(begin);
+    return timing.exit_code;
+}
+
+void execScript(const std::string& argv0, const std::string& script, const std::vector<std::string>& args,
+    LaunchTiming& timing, LaunchCache* cache, bool print_timing)
+{
+    timing.exec = true;
+    timing.pid = static_cast<int>(::getpid());
+    const std::string path = scriptPath(argv0, script, timing);
+    startScript(path, args, timing, cache, [&](const std::vector<std::string>& argv) {
+        // Un intérprete de la caché que ya no existe se descubre antes de
+        // escribir los tiempos, para no dar una línea del intento fallido
+        if (timing.cached && argv[0].find('/') != std::string::npos && ::access(argv[0].c_str(), X_OK) != 0)
+        {
+            throw systemError(argv[0]);
+        }
+        // Después del exec ya no hay lanzador que lo haga
+        if (cache)
+        {
+            cache->save();
+        }
+        if (print_timing)
+        {
+            const std::size_t slash = path.find_last_of('/');
+            std::fprintf(stderr, "%s\n", timing.json(path.substr(slash == std::string::npos ? 0 : slash + 1)).c_str());
+            std::fflush(stderr);
+        }
+        execProcess(argv);
+    });
+}
+
+} // namespace turtle_unida
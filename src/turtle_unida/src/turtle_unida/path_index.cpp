@@ -0,0 +1,264 @@
+#include "turtle_unida/path_index.h"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+#include "turtle_unida/command_log.h"
+
+namespace turtle_unida
+{
+
+PathIndex::PathIndex(const std::vector<double>& points)
+    : points_(points), min_x_(0.0), min_y_(0.0), cell_(1.0), columns_(1), rows_(1)
+{
+    if (points_.size() < 4 || points_.size() % 2 != 0)
+    {
+        throw std::invalid_argument("el camino necesita al menos dos puntos (x, y)");
+    }
+    const std::size_t vertices = points_.size() / 2;
+    const std::size_t segments = vertices - 1;
+    if (segments >= 0xffffffffu)
+    {
+        throw std::invalid_argument("el camino tiene demasiados puntos");
+    }
+
+    lengths_.resize(vertices);
+    lengths_[0] = 0.0;
+    double max_x = points_[0];
+    double max_y = points_[1];
+    min_x_ = max_x;
+    min_y_ = max_y;
+    for (std::size_t i = 1; i < vertices; ++i)
+    {
+        const double x = points_[2 * i];
+        const double y = points_[2 * i + 1];
+        lengths_[i] = lengths_[i - 1] + std::hypot(x - points_[2 * i - 2], y - points_[2 * i - 1]);
+        min_x_ = std::min(min_x_, x);
+        min_y_ = std::min(min_y_, y);
+        max_x = std::max(max_x, x);
+        max_y = std::max(max_y, y);
+    }
+
+    // Alrededor de una celda por segmento, y nunca más pequeñas que el
+    // segmento medio para que cada uno ocupe pocas celdas
+    const double width = std::max(max_x - min_x_, 1e-6);
+    const double height = std::max(max_y - min_y_, 1e-6);
+    cell_ = std::max(std::sqrt(width * height / static_cast<double>(segments)),
+        lengths_.back() / static_cast<double>(segments));
+    cell_ = std::max(cell_, 1e-6);
+    columns_ = static_cast<std::size_t>(width / cell_) + 1;
+    rows_ = static_cast<std::size_t>(height / cell_) + 1;
+
+    // Dos pasadas: contar los segmentos de cada celda y después repartirlos
+    const auto range = [this](std::size_t i, std::size_t& c0, std::size_t& c1, std::size_t& r0, std::size_t& r1) {
+        const double* p = &points_[2 * i];
+        c0 = static_cast<std::size_t>((std::min(p[0], p[2]) - min_x_) / cell_);
+        c1 = std::min(columns_ - 1, static_cast<std::size_t>((std::max(p[0], p[2]) - min_x_) / cell_));
+        r0 = static_cast<std::size_t>((std::min(p[1], p[3]) - min_y_) / cell_);
+        r1 = std::min(rows_ - 1, static_cast<std::size_t>((std::max(p[1], p[3]) - min_y_) / cell_));
+    };
+    cell_start_.assign(columns_ * rows_ + 1, 0);
+    std::size_t c0, c1, r0, r1;
+    for (std::size_t i = 0; i < segments; ++i)
+    {
+        range(i, c0, c1, r0, r1);
+        for (std::size_t r = r0; r <= r1; ++r)
+        {
+            for (std::size_t c = c0; c <= c1; ++c)
+            {
+                ++cell_start_[r * columns_ + c + 1];
+            }
+        }
+    }
+    for (std::size_t c = 0; c + 1 < cell_start_.size(); ++c)
+    {
+        cell_start_[c + 1] += cell_start_[c];
+    }
+    cell_segments_.resize(cell_start_.back());
+    std::vector<std::uint32_t> fill(cell_start_.begin(), cell_start_.end() - 1);
+    for (std::size_t i = 0; i < segments; ++i)
+    {
+        range(i, c0, c1, r0, r1);
+        for (std::size_t r = r0; r <= r1; ++r)
+        {
+            for (std::size_t c = c0; c <= c1; ++c)
+            {
+                cell_segments_[fill[r * columns_ + c]++] = static_cast<std::uint32_t>(i);
+            }
+        }
+    }
+}
+
+PathPoint PathIndex::project(std::size_t segment, double x, double y, double s_min, double s_max) const
+{
+    const double* p = &points_[2 * segment];
+    const double sx = p[2] - p[0];
+    const double sy = p[3] - p[1];
+    const double len = lengths_[segment + 1] - lengths_[segment];
+    double u = len > 0.0 ? ((x - p[0]) * sx + (y - p[1]) * sy) / (len * len) : 0.0;
+
+    // Solo la parte del segmento dentro de [s_min, s_max]
+    double lo = 0.0;
+    double hi = 1.0;
+    if (len > 0.0)
+    {
+        lo = std::max(lo, (s_min - lengths_[segment]) / len);
+        hi = std::min(hi, (s_max - lengths_[segment]) / len);
+    }
+    u = std::max(lo, std::min(hi, u));
+
+    PathPoint point;
+    point.segment = segment;
+    point.u = u;
+    point.s = lengths_[segment] + u * len;
+    point.x = p[0] + u * sx;
+    point.y = p[1] + u * sy;
+    const double dx = point.x - x;
+    const double dy = point.y - y;
+    point.distance = std::sqrt(dx * dx + dy * dy);
+    return point;
+}
+
+bool PathIndex::search(double x, double y, double s_min, double s_max, PathPoint& best) const
+{
+    const double fx = (x - min_x_) / cell_;
+    const double fy = (y - min_y_) / cell_;
+    const long ci = std::max(0L, std::min(static_cast<long>(columns_) - 1, static_cast<long>(std::floor(fx))));
+    const long cj = std::max(0L, std::min(static_cast<long>(rows_) - 1, static_cast<long>(std::floor(fy))));
+    const long columns = static_cast<long>(columns_);
+    const long rows = static_cast<long>(rows_);
+
+    bool found = false;
+    best.distance = INFINITY;
+    for (long ring = 0;; ++ring)
+    {
+        // Lo que queda por mirar está fuera del cuadrado de los anillos
+        // anteriores: si el mejor candidato está más cerca, no hay nada mejor
+        if (found && ring > 0)
+        {
+            const double left = x - (min_x_ + (ci - ring + 1) * cell_);
+            const double right = min_x_ + (ci + ring) * cell_ - x;
+            const double bottom = y - (min_y_ + (cj - ring + 1) * cell_);
+            const double top = min_y_ + (cj + ring) * cell_ - y;
+            if (std::min(std::min(left, right), std::min(bottom, top)) >= best.distance)
+            {
+                return true;
+            }
+        }
+        if (ci - ring < 0 && cj - ring < 0 && ci + ring >= columns && cj + ring >= rows)
+        {
+            return found;
+        }
+
+        for (long j = std::max(0L, cj - ring); j <= std::min(rows - 1, cj + ring); ++j)
+        {
+            const bool edge = j == cj - ring || j == cj + ring;
+            const long step = edge ? 1 : 2 * ring;
+            for (long i = ci - ring; i <= ci + ring; i += step)
+            {
+                if (i < 0 || i >= columns)
+                {
+                    continue;
+                }
+                // Los segmentos de cada celda están en orden, así que los que
+                // caen en [s_min, s_max] son un tramo seguido: otras vueltas
+                // del camino por la misma celda no se llegan a mirar
+                const std::size_t cell = static_cast<std::size_t>(j * columns + i);
+                const std::uint32_t* first = &cell_segments_[0] + cell_start_[cell];
+                const std::uint32_t* last = &cell_segments_[0] + cell_start_[cell + 1];
+                if (s_min > 0.0)
+                {
+                    first = std::lower_bound(first, last, s_min,
+                        [this](std::uint32_t segment, double s) { return lengths_[segment + 1] < s; });
+                }
+                for (; first != last && lengths_[*first] <= s_max; ++first)
+                {
+                    const PathPoint candidate = project(*first, x, y, s_min, s_max);
+                    if (candidate.distance < best.distance)
+                    {
+                        best = candidate;
+                        found = true;
+                    }
+                }
+            }
+        }
+    }
+}
+
+PathPoint PathIndex::nearest(double x, double y, double s_min, double s_max) const
+{
+    PathPoint best;
+    if (!search(x, y, s_min, s_max, best))
+    {
+        search(x, y, 0.0, INFINITY, best);
+    }
+    return best;
+}
+
+PathPoint PathIndex::at(double s) const
+{
+    const double clamped = std::max(0.0, std::min(s, lengths_.back()));
+    std::size_t segment = static_cast<std::size_t>(
+        std::upper_bound(lengths_.begin(), lengths_.end(), clamped) - lengths_.begin());
+    segment = std::min(segments() - 1, segment > 0 ? segment - 1 : 0);
+
+    const double* p = &points_[2 * segment];
+    const double len = lengths_[segment + 1] - lengths_[segment];
+    PathPoint point;
+    point.segment = segment;
+    point.u = len > 0.0 ? std::min(1.0, (clamped - lengths_[segment]) / len) : 1.0;
+    point.s = clamped;
+    point.x = p[0] + point.u * (p[2] - p[0]);
+    point.y = p[1] + point.u * (p[3] - p[1]);
+    point.distance = 0.0;
+    return point;
+}
+
+std::vector<double> loadPath(const std::string& path, double min_spacing)
+{
+    std::vector<double> points;
+    const auto add = [&points, min_spacing](double x, double y) {
+        const std::size_t n = points.size();
+        if (n == 0 || std::hypot(x - points[n - 2], y - points[n - 1]) >= min_spacing)
+        {
+            points.push_back(x);
+            points.push_back(y);
+        }
+    };
+
+    if (path.size() > 4 && path.compare(path.size() - 4, 4, ".log") == 0)
+    {
+        // Las poses del primer topic de pose que aparece en el log
+        const CommandLogReader log(path);
+        std::uint32_t topic = 0;
+        bool chosen = false;
+        for (std::uint64_t i = 0; i < log.size(); ++i)
+        {
+            const LogRecord& record = log.record(i);
+            if (record.kind != LOG_POSE || (chosen && record.topic != topic))
+            {
+                continue;
+            }
+            topic = record.topic;
+            chosen = true;
+            add(record.values[0], record.values[1]);
+        }
+        return points;
+    }
+
+    std::ifstream file(path.c_str());
+    if (!file)
+    {
+        throw std::runtime_error("no se puede leer el camino " + path);
+    }
+    double x;
+    double y;
+    while (file >> x >> y)
+    {
+        add(x, y);
+    }
+    return points;
+}
+
+} // namespace turtle_unida
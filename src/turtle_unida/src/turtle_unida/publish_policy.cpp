@@ -0,0 +1,109 @@
+#include "turtle_unida/publish_policy.h"
+
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+#include "turtle_unida/latency.h"
+
+namespace turtle_unida
+{
+
+namespace
+{
+
+double monotonicSeconds()
+{
+    return static_cast<double>(monotonicNanos()) * 1e-9;
+}
+
+bool isZero(const Twist& twist)
+{
+    return twist.linear.x == 0.0 && twist.linear.y == 0.0 && twist.angular.z == 0.0;
+}
+
+} // namespace
+
+PublishPolicy::PublishPolicy()
+    : linear_deadband(0.01), angular_deadband(0.01), keep_alive(0.5)
+{
+}
+
+PublishStats::PublishStats()
+    : sent(0), suppressed(0), keep_alives(0)
+{
+}
+
+std::string PublishStats::summary() const
+{
+    const std::uint64_t total = sent + suppressed;
+    char buffer[128];
+    std::snprintf(buffer, sizeof(buffer), "sent=%llu suppressed=%llu keep_alives=%llu suppressed_pct=%.1f",
+        static_cast<unsigned long long>(sent), static_cast<unsigned long long>(suppressed),
+        static_cast<unsigned long long>(keep_alives), total ? 100.0 * suppressed / total : 0.0);
+    return buffer;
+}
+
+DeadbandTransport::DeadbandTransport(Transport& inner, const PublishPolicy& policy, const Clock& clock)
+    : inner_(inner), policy_(policy), clock_(clock ? clock : Clock(monotonicSeconds))
+{
+    if (policy.linear_deadband < 0.0 || policy.angular_deadband < 0.0 || !(policy.keep_alive > 0.0))
+    {
+        throw std::invalid_argument("política de publicación no válida");
+    }
+}
+
+Transport::Channel DeadbandTransport::advertise(const std::string& topic)
+{
+    const Channel channel = inner_.advertise(topic);
+    if (channel >= last_.size())
+    {
+        last_.resize(channel + 1, Twist());
+        last_time_.resize(channel + 1, 0.0);
+        published_.resize(channel + 1, 0);
+        channel_stats_.resize(channel + 1);
+    }
+    return channel;
+}
+
+void DeadbandTransport::publish(Channel channel, const Twist& twist)
+{
+    const double now = clock_();
+    const Twist& last = last_[channel];
+    PublishStats& channel_stats = channel_stats_[channel];
+    bool send = !published_[channel] || (isZero(twist) && !isZero(last)) ||
+        std::fabs(twist.linear.x - last.linear.x) >= policy_.linear_deadband ||
+        std::fabs(twist.linear.y - last.linear.y) >= policy_.linear_deadband ||
+        std::fabs(twist.angular.z - last.angular.z) >= policy_.angular_deadband;
+    if (!send && now - last_time_[channel] >= policy_.keep_alive)
+    {
+        send = true;
+        ++stats_.keep_alives;
+        ++channel_stats.keep_alives;
+    }
+    if (!send)
+    {
+        ++stats_.suppressed;
+        ++channel_stats.suppressed;
+        return;
+    }
+
+    inner_.publish(channel, twist);
+    last_[channel] = twist;
+    last_time_[channel] = now;
+    published_[channel] = 1;
+    ++stats_.sent;
+    ++channel_stats.sent;
+}
+
+void DeadbandTransport::flush()
+{
+    inner_.flush();
+}
+
+void DeadbandTransport::subscribe(const std::string& topic, const PoseCallback& callback)
+{
+    inner_.subscribe(topic, callback);
+}
+
+} // namespace turtle_unida
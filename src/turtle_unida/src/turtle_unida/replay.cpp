@@ -0,0 +1,249 @@
+#include "turtle_unida/replay.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <thread>
+
+#include "turtle_unida/latency.h"
+#include "turtle_unida/sim_transport.h"
+
+namespace turtle_unida
+{
+
+namespace
+{
+
+typedef std::chrono::steady_clock Clock;
+
+const std::uint64_t NANOS = 1000000000ull;
+
+std::uint64_t toNanos(double seconds)
+{
+    return seconds > 0.0 ? static_cast<std::uint64_t>(seconds * 1e9) : 0;
+}
+
+// "/turtle1/cmd_vel" -> "turtle1" si el topic termina en suffix; "" si no
+std::string turtleName(const std::string& topic, const std::string& suffix)
+{
+    const std::size_t begin = topic.find_first_not_of('/');
+    const std::size_t end = topic.find('/', begin);
+    if (begin == std::string::npos || end == std::string::npos ||
+        topic.compare(end + 1, std::string::npos, suffix) != 0)
+    {
+        return std::string();
+    }
+    return topic.substr(begin, end - begin);
+}
+
+} // namespace
+
+ReplayConfig::ReplayConfig()
+    : speed(1.0), start(0.0), end(0.0)
+{
+}
+
+ReplayStats::ReplayStats()
+    : commands(0), poses(0), log_time(0.0), wall_time(0.0), max_pose_error(0.0)
+{
+}
+
+std::string ReplayStats::summary() const
+{
+    char buffer[256];
+    std::snprintf(buffer, sizeof(buffer),
+        "commands=%llu poses=%llu log_s=%.3f wall_s=%.3f warp=%.1f max_pose_error_m=%.4f late_us=%.1f/%.1f/%.1f",
+        static_cast<unsigned long long>(commands), static_cast<unsigned long long>(poses), log_time, wall_time,
+        wall_time > 0.0 ? log_time / wall_time : 0.0, max_pose_error, lateness.percentile(0.5) * 1e-3,
+        lateness.percentile(0.99) * 1e-3, lateness.max() * 1e-3);
+    return buffer;
+}
+
+Replayer::Replayer(const CommandLogReader& log, Transport& transport, const ReplayConfig& config)
+    : log_(log),
+      transport_(transport),
+      config_(config),
+      channels_(log.topicCount(), 0)
+{
+    if (config_.speed < 0.0)
+    {
+        throw std::invalid_argument("la velocidad de reproducción no puede ser negativa");
+    }
+
+    // Se anuncian los topics con comandos (los de solo poses no). La tabla de
+    // topics lo dice; en los logs antiguos, sin esa información, se miran
+    // solo los registros del tramo que se va a reproducir
+    std::vector<bool> advertised(log.topicCount(), false);
+    if (log.topicKindsKnown())
+    {
+        for (std::uint32_t topic = 0; topic < log.topicCount(); ++topic)
+        {
+            advertised[topic] = log.topicHasKind(topic, LOG_TWIST);
+        }
+    }
+    else
+    {
+        const std::uint64_t last = config_.end > 0.0 ? log.seek(toNanos(config_.end)) : log.size();
+        std::size_t pending = log.topicCount();
+        for (std::uint64_t i = log.seek(toNanos(config_.start)); i < last && pending > 0; ++i)
+        {
+            const LogRecord& record = log.record(i);
+            if (record.kind == LOG_TWIST && record.topic < advertised.size() && !advertised[record.topic])
+            {
+                advertised[record.topic] = true;
+                --pending;
+            }
+        }
+    }
+
+    for (std::uint32_t topic = 0; topic < log.topicCount(); ++topic)
+    {
+        if (advertised[topic])
+        {
+            channels_[topic] = transport_.advertise(log.topic(topic));
+            advertised_channels_.push_back(channels_[topic]);
+        }
+    }
+}
+
+const ReplayStats& Replayer::run(const std::function<bool()>& ok)
+{
+    const std::uint64_t origin = toNanos(config_.start);
+    const std::uint64_t first = log_.seek(origin);
+    const std::uint64_t last = config_.end > 0.0 ? log_.seek(toNanos(config_.end)) : log_.size();
+
+    // Cada registro tiene su instante absoluto (begin + t / speed): los
+    // retrasos de un registro no se acumulan en los siguientes
+    const bool paced = config_.speed > 0.0;
+    const double scale = paced ? 1.0 / config_.speed : 0.0;
+    const Clock::time_point begin = Clock::now();
+
+    for (std::uint64_t i = first; i < last && ok(); ++i)
+    {
+        const LogRecord& record = log_.record(i);
+        if (record.topic >= channels_.size())
+        {
+            continue;
+        }
+        const std::uint64_t offset = record.time - origin;
+        const double t = static_cast<double>(offset / NANOS) + static_cast<double>(offset % NANOS) * 1e-9;
+
+        if (paced)
+        {
+            const Clock::time_point due = begin + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(t * scale));
+            const Clock::time_point now = Clock::now();
+            if (now < due)
+            {
+                std::this_thread::sleep_until(due);
+            }
+            const Clock::duration late = Clock::now() - due;
+            stats_.lateness.record(late.count() > 0 ? static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(late).count()) : 0);
+        }
+
+        if (advance_)
+        {
+            advance_(t);
+        }
+
+        if (record.kind == LOG_TWIST)
+        {
+            Twist twist = twistFromLog(record);
+            if (isStamped(twist))
+            {
+                twist.linear.z = 0.0;
+                twist.angular.x = 0.0;
+                twist.angular.y = 0.0;
+            }
+            transport_.publish(channels_[record.topic], twist);
+            ++stats_.commands;
+        }
+        else if (record.kind == LOG_POSE && pose_callback_)
+        {
+            pose_callback_(record.topic, poseFromLog(record));
+        }
+        stats_.log_time = t;
+    }
+
+    transport_.flush();
+    stats_.wall_time = std::chrono::duration<double>(Clock::now() - begin).count();
+    return stats_;
+}
+
+ReplayStats replayInSimulator(const std::string& path, const ReplayConfig& config,
+    const SimulatorConfig& simulator_config)
+{
+    const CommandLogReader log(path);
+    Simulator simulator(simulator_config);
+    SimTransport transport(simulator);
+
+    // Una tortuga por cada topic de comandos, en su primera pose grabada
+    std::vector<std::string> names;
+    std::vector<long> pose_of(log.topicCount(), -1);  // tortuga de cada topic de pose
+    for (std::uint32_t i = 0; i < log.topicCount(); ++i)
+    {
+        const std::string name = turtleName(log.topic(i), "cmd_vel");
+        if (!name.empty())
+        {
+            names.push_back(name);
+        }
+    }
+    std::vector<Pose> initial(names.size());
+    std::vector<bool> found(names.size(), false);
+    for (std::size_t k = 0; k < names.size(); ++k)
+    {
+        initial[k].x = simulator_config.world_size / 2.0;
+        initial[k].y = simulator_config.world_size / 2.0;
+        for (std::uint32_t i = 0; i < log.topicCount(); ++i)
+        {
+            if (turtleName(log.topic(i), "pose") == names[k])
+            {
+                pose_of[i] = static_cast<long>(k);
+            }
+        }
+    }
+    std::size_t missing = names.size();
+    const std::uint64_t last = config.end > 0.0 ? log.seek(toNanos(config.end)) : log.size();
+    for (std::uint64_t i = log.seek(toNanos(config.start)); i < last && missing > 0; ++i)
+    {
+        const LogRecord& record = log.record(i);
+        if (record.kind == LOG_POSE && record.topic < pose_of.size() && pose_of[record.topic] >= 0 &&
+            !found[pose_of[record.topic]])
+        {
+            initial[pose_of[record.topic]] = poseFromLog(record);
+            found[pose_of[record.topic]] = true;
+            --missing;
+        }
+    }
+    for (std::size_t k = 0; k < names.size(); ++k)
+    {
+        transport.spawn(names[k], initial[k].x, initial[k].y, initial[k].theta);
+    }
+
+    // El tiempo simulado sigue al de la grabación, no al reloj
+    Replayer replayer(log, transport, config);
+    const double dt = simulator.config().dt;
+    replayer.setAdvance([&transport, &simulator, dt](double t) {
+        while (simulator.time() + 0.5 * dt <= t)
+        {
+            transport.step();
+        }
+    });
+    ReplayStats& stats = replayer.stats();
+    replayer.setPoseCallback([&pose_of, &simulator, &stats](std::uint32_t topic, const Pose& recorded) {
+        if (pose_of[topic] < 0)
+        {
+            return;
+        }
+        const Pose simulated = simulator.pose(static_cast<std::size_t>(pose_of[topic]));
+        const double error = std::hypot(simulated.x - recorded.x, simulated.y - recorded.y);
+        stats.max_pose_error = std::max(stats.max_pose_error, error);
+        ++stats.poses;
+    });
+    return replayer.run([]() { return true; });
+}
+
+} // namespace turtle_unida
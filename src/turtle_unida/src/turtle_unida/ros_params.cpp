@@ -0,0 +1,92 @@
+#include "turtle_unida/ros_params.h"
+
+#include <algorithm>
+
+namespace turtle_unida
+{
+
+void readTrajectoryParams(const ros::NodeHandle& pnh, TrajectoryParams& params)
+{
+    pnh.param("trajectory", params.type, params.type);
+    pnh.param("linear_x", params.linear, params.linear);
+    pnh.param("angular_z", params.angular, params.angular);
+    pnh.param("size", params.size, params.size);
+    pnh.param("period", params.period, params.period);
+    pnh.param("growth", params.growth, params.growth);
+    pnh.param("duration", params.duration, params.duration);
+    pnh.param("points", params.points, params.points);
+    pnh.param("segments", params.segments, params.segments);
+    pnh.param("table_dt", params.table_dt, params.table_dt);
+}
+
+void readSchedulerParams(const ros::NodeHandle& pnh, SchedulerConfig& config)
+{
+    pnh.param("rate", config.rate, config.rate);
+    pnh.param("spin_margin", config.spin_margin, config.spin_margin);
+
+    std::string overrun = config.policy == SKIP ? "skip" : "catch_up";
+    pnh.param("overrun", overrun, overrun);
+    if (overrun == "skip")
+    {
+        config.policy = SKIP;
+    }
+    else if (overrun == "catch_up")
+    {
+        config.policy = CATCH_UP;
+    }
+    else
+    {
+        ROS_WARN("~overrun desconocido [%s], se usa skip", overrun.c_str());
+        config.policy = SKIP;
+    }
+    validateSchedulerConfig(config);
+}
+
+void readControllerParams(const ros::NodeHandle& pnh, ControllerParams& params)
+{
+    pnh.param("controller", params.type, params.type);
+    pnh.param("goal_x", params.goal_x, params.goal_x);
+    pnh.param("goal_y", params.goal_y, params.goal_y);
+    pnh.param("heading", params.heading, params.heading);
+    pnh.param("speed", params.speed, params.speed);
+    pnh.param("lookahead", params.lookahead, params.lookahead);
+    pnh.param("points", params.points, params.points);
+    pnh.param("path_file", params.path_file, params.path_file);
+    pnh.param("k_linear", params.gains.k_linear, params.gains.k_linear);
+    pnh.param("k_angular", params.gains.k_angular, params.gains.k_angular);
+    pnh.param("max_linear", params.gains.max_linear, params.gains.max_linear);
+    pnh.param("max_angular", params.gains.max_angular, params.gains.max_angular);
+    pnh.param("tolerance", params.gains.tolerance, params.gains.tolerance);
+}
+
+void readAvoidanceParams(const ros::NodeHandle& pnh, AvoidanceConfig& config)
+{
+    pnh.param("avoid_radius", config.radius, config.radius);
+    pnh.param("avoid_distance", config.neighbor_distance, config.neighbor_distance);
+    pnh.param("avoid_neighbors", config.max_neighbors, config.max_neighbors);
+    pnh.param("avoid_horizon", config.time_horizon, config.time_horizon);
+    pnh.param("avoid_max_linear", config.max_linear, config.max_linear);
+    pnh.param("avoid_max_angular", config.max_angular, config.max_angular);
+    pnh.param("avoid_threads", config.threads, config.threads);
+}
+
+void readExecutorParams(const ros::NodeHandle& pnh, ExecutorConfig& config)
+{
+    int grain = static_cast<int>(config.grain);
+    pnh.param("threads", config.threads, config.threads);
+    pnh.param("grain", grain, grain);
+    pnh.param("deterministic", config.deterministic, config.deterministic);
+    config.grain = static_cast<std::size_t>(std::max(1, grain));
+}
+
+bool readPublishPolicyParams(const ros::NodeHandle& pnh, PublishPolicy& policy)
+{
+    bool enabled = false;
+    pnh.param("deadband", enabled, enabled);
+    pnh.param("deadband_linear", policy.linear_deadband, policy.linear_deadband);
+    pnh.param("deadband_angular", policy.angular_deadband, policy.angular_deadband);
+    pnh.param("keep_alive", policy.keep_alive, policy.keep_alive);
+    return enabled;
+}
+
+} // namespace turtle_unida
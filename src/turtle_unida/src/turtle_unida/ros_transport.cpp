@@ -0,0 +1,162 @@
+#include "turtle_unida/ros_transport.h"
+
+#include "turtle_unida/latency.h"
+
+namespace turtle_unida
+{
+
+namespace
+{
+
+// Pose de turtlesim/Pose
+Pose toPose(const turtlesim::Pose& msg)
+{
+    Pose pose;
+    pose.x = msg.x;
+    pose.y = msg.y;
+    pose.theta = msg.theta;
+    pose.linear_velocity = msg.linear_velocity;
+    pose.angular_velocity = msg.angular_velocity;
+    return pose;
+}
+
+// Función de serialización que entrega a roscpp el buffer ya escrito. Solo
+// guarda un puntero, así que boost::function la almacena sin reservar memoria.
+struct Preserialized
+{
+    const ros::SerializedMessage* message;
+
+    ros::SerializedMessage operator()() const { return *message; }
+};
+
+} // namespace
+
+RosTransport::RosTransport(const ros::NodeHandle& nh, unsigned int queue_size, bool shared_memory)
+    : nh_(nh), queue_size_(queue_size), shared_memory_(shared_memory)
+{
+}
+
+Transport::Channel RosTransport::advertise(const std::string& topic)
+{
+    publishers_.push_back(nh_.advertise<geometry_msgs::Twist>(topic, queue_size_));
+    // Uno por mensaje que quepa en la cola de roscpp, más el que se escribe
+    pools_.push_back(TwistPool(queue_size_ + 2));
+    rings_.push_back(shared_memory_ ? createShmWriter(topic) : std::unique_ptr<ShmRing>());
+    return publishers_.size() - 1;
+}
+
+void RosTransport::publish(Channel channel, const Twist& twist)
+{
+    // Sin cola previa (modo pipeline) el comando entra en la cola de envío aquí
+    Twist out = twist;
+    const bool stamped = isStamped(out);
+    if (stamped && !isEnqueued(out))
+    {
+        stampEnqueued(out);
+    }
+
+    ShmRing* ring = rings_[channel].get();
+    if (ring)
+    {
+        if (stamped)
+        {
+            stampSent(out);
+        }
+        ShmRing::Record record;
+        toRecord(out, record);
+        ring->write(record);
+        // Sin nadie en roscpp no hace falta serializar; los lectores del
+        // anillo siguen suscritos por roscpp y descartan nuestra copia
+        if (publishers_[channel].getNumSubscribers() == 0)
+        {
+            return;
+        }
+    }
+
+    TwistPool& pool = pools_[channel];
+    ros::SerializedMessage message = pool.write(out);
+    if (stamped)
+    {
+        // El envío se marca ya serializado, justo antes de pasarlo a roscpp
+        stampSent(out);
+        pool.rewriteLast(out);
+    }
+    const Preserialized serialize = {&message};
+    publishers_[channel].publish(serialize, message);
+}
+
+void RosTransport::subscribe(const std::string& topic, const PoseCallback& callback)
+{
+    // Cola de 1 y sin Nagle: solo interesa la pose más reciente, cuanto antes
+    if (!shared_memory_)
+    {
+        const boost::function<void(const turtlesim::PoseConstPtr&)> handler =
+            [callback](const turtlesim::PoseConstPtr& msg) { callback(toPose(*msg)); };
+        subscribers_.push_back(nh_.subscribe<turtlesim::Pose>(topic, 1, handler, ros::VoidConstPtr(),
+            ros::TransportHints().tcpNoDelay()));
+        return;
+    }
+
+    // Lo que el dueño del anillo publica también por roscpp ya llega por memoria compartida
+    ros::NodeHandle nh = nh_;
+    const ShmLink::Subscribe subscribe = [nh, topic, callback](const ShmLink& link) mutable {
+        const boost::function<void(const ros::MessageEvent<turtlesim::Pose const>&)> handler =
+            [&link, callback](const ros::MessageEvent<turtlesim::Pose const>& event) {
+                if (!link.duplicate(event.getPublisherName()))
+                {
+                    callback(toPose(*event.getConstMessage()));
+                }
+            };
+        return nh.subscribe<turtlesim::Pose>(topic, 1, handler, ros::VoidConstPtr(),
+            ros::TransportHints().tcpNoDelay());
+    };
+    links_.push_back(std::unique_ptr<ShmLink>(new ShmLink(topic, subscribe)));
+    link_callbacks_.push_back(callback);
+}
+
+std::size_t RosTransport::pollShared()
+{
+    std::size_t delivered = 0;
+    for (std::size_t i = 0; i < links_.size(); ++i)
+    {
+        // Como la cola de 1 de roscpp: solo interesa la pose más reciente
+        ShmRing::Record latest;
+        bool received = false;
+        links_[i]->poll([&latest, &received](const ShmRing::Record& record) {
+            latest = record;
+            received = true;
+        });
+        if (received)
+        {
+            link_callbacks_[i](poseFromRecord(latest));
+            ++delivered;
+        }
+    }
+    return delivered;
+}
+
+void RosTransport::waitShared(double timeout)
+{
+    for (std::size_t i = 0; i < links_.size(); ++i)
+    {
+        if (links_[i]->shared())
+        {
+            links_[i]->wait(timeout);
+            return;
+        }
+    }
+}
+
+bool RosTransport::sharedActive() const
+{
+    for (std::size_t i = 0; i < links_.size(); ++i)
+    {
+        if (links_[i]->shared())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace turtle_unida
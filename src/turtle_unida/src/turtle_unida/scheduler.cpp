@@ -0,0 +1,142 @@
+#include "turtle_unida/scheduler.h"
+
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <thread>
+
+namespace turtle_unida
+{
+
+namespace
+{
+
+std::uint64_t toNanoseconds(PeriodicScheduler::Clock::duration duration)
+{
+    const long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    return ns > 0 ? static_cast<std::uint64_t>(ns) : 0;
+}
+
+const SchedulerConfig& validated(const SchedulerConfig& config)
+{
+    validateSchedulerConfig(config);
+    return config;
+}
+
+} // namespace
+
+SchedulerConfig::SchedulerConfig()
+    : rate(1000.0), spin_margin(200e-6), policy(SKIP)
+{
+}
+
+void validateSchedulerConfig(const SchedulerConfig& config)
+{
+    // Con rate <= 0 el periodo sería infinito o negativo y wait() dividiría por cero
+    if (!(config.rate > 0.0) || !std::isfinite(config.rate))
+    {
+        throw std::invalid_argument("la frecuencia del planificador debe ser positiva");
+    }
+    if (std::chrono::duration_cast<PeriodicScheduler::Clock::duration>(
+            std::chrono::duration<double>(1.0 / config.rate)).count() <= 0)
+    {
+        throw std::invalid_argument("la frecuencia del planificador supera la resolución del reloj");
+    }
+    if (!(config.spin_margin >= 0.0) || !std::isfinite(config.spin_margin))
+    {
+        throw std::invalid_argument("el margen de espera activa no puede ser negativo");
+    }
+}
+
+SchedulerStats::SchedulerStats()
+    : ticks(0), missed(0), skipped(0)
+{
+}
+
+std::string SchedulerStats::summary() const
+{
+    char buffer[256];
+    std::snprintf(buffer, sizeof(buffer),
+        "ticks=%llu missed=%llu skipped=%llu period_mean_us=%.1f jitter_p50_us=%.1f jitter_p99_us=%.1f "
+        "jitter_p99.9_us=%.1f lateness_max_us=%.1f",
+        static_cast<unsigned long long>(ticks), static_cast<unsigned long long>(missed),
+        static_cast<unsigned long long>(skipped), period.mean() * 1e-3, jitter.percentile(0.5) * 1e-3,
+        jitter.percentile(0.99) * 1e-3, jitter.percentile(0.999) * 1e-3, lateness.max() * 1e-3);
+    return buffer;
+}
+
+PeriodicScheduler::PeriodicScheduler(const SchedulerConfig& config)
+    : config_(validated(config)),
+      period_(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / config_.rate))),
+      spin_(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(config_.spin_margin)))
+{
+    reset();
+}
+
+void PeriodicScheduler::reset()
+{
+    start_ = Clock::now();
+    current_ = start_;
+    deadline_ = start_;
+    last_wake_ = start_;
+    counted_until_ = start_;
+    stats_ = SchedulerStats();
+}
+
+TickInfo PeriodicScheduler::wait()
+{
+    // Duerme hasta poco antes del instante previsto y espera activamente el resto
+    std::this_thread::sleep_until(deadline_ - spin_);
+    Clock::time_point now = Clock::now();
+    while (now < deadline_)
+    {
+        now = Clock::now();
+    }
+
+    TickInfo info;
+    info.lateness = std::chrono::duration<double>(now - deadline_).count();
+    info.missed = 0;
+    stats_.lateness.record(toNanoseconds(now - deadline_));
+
+    // Instantes posteriores a este que ya han vencido. Con CATCH_UP los
+    // ciclos siguientes vuelven a verlos, así que solo se cuentan una vez.
+    const Clock::rep overdue = (now - deadline_) / period_;
+    if (overdue > 0)
+    {
+        const Clock::time_point last_overdue = deadline_ + period_ * overdue;
+        if (last_overdue > counted_until_)
+        {
+            const Clock::time_point from = counted_until_ > deadline_ ? counted_until_ : deadline_;
+            info.missed = static_cast<std::uint64_t>((last_overdue - from) / period_);
+            stats_.missed += info.missed;
+            counted_until_ = last_overdue;
+        }
+        if (config_.policy == SKIP)
+        {
+            // Se ejecuta solo el último instante ya vencido
+            deadline_ = last_overdue;
+            stats_.skipped += static_cast<std::uint64_t>(overdue);
+        }
+    }
+
+    if (stats_.ticks > 0)
+    {
+        const Clock::duration actual = now - last_wake_;
+        stats_.period.record(toNanoseconds(actual));
+        stats_.jitter.record(toNanoseconds(actual > period_ ? actual - period_ : period_ - actual));
+    }
+    ++stats_.ticks;
+    last_wake_ = now;
+
+    current_ = deadline_;
+    deadline_ += period_;
+    info.time = time();
+    return info;
+}
+
+double PeriodicScheduler::time() const
+{
+    return std::chrono::duration<double>(current_ - start_).count();
+}
+
+} // namespace turtle_unida
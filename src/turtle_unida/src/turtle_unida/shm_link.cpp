@@ -0,0 +1,145 @@
+#include "turtle_unida/shm_link.h"
+
+#include <cstdio>
+#include <stdexcept>
+
+namespace turtle_unida
+{
+
+namespace
+{
+
+// Cada cuánto se busca el segmento o se comprueba el escritor
+const double CHECK_PERIOD = 1.0;
+
+// FNV-1a de 32 bits: estable entre procesos y compiladores
+std::uint32_t fnv1a(const std::string& text)
+{
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < text.size(); ++i)
+    {
+        hash = (hash ^ static_cast<unsigned char>(text[i])) * 16777619u;
+    }
+    return hash;
+}
+
+} // namespace
+
+std::string shmSegmentName(const std::string& topic)
+{
+    char prefix[32];
+    std::snprintf(prefix, sizeof(prefix), "/turtle_unida.%08x", fnv1a(ros::master::getURI()));
+    return ShmRing::segmentName(prefix, ros::names::resolve(topic));
+}
+
+std::unique_ptr<ShmRing> createShmWriter(const std::string& topic)
+{
+    try
+    {
+        return ShmRing::create(shmSegmentName(topic), 256, ros::this_node::getName());
+    }
+    catch (const std::exception& e)
+    {
+        ROS_WARN("Sin memoria compartida para %s: %s", topic.c_str(), e.what());
+        return std::unique_ptr<ShmRing>();
+    }
+}
+
+void toRecord(const Twist& twist, ShmRing::Record& record)
+{
+    record.values[0] = twist.linear.x;
+    record.values[1] = twist.linear.y;
+    record.values[2] = twist.linear.z;
+    record.values[3] = twist.angular.x;
+    record.values[4] = twist.angular.y;
+    record.values[5] = twist.angular.z;
+    record.values[6] = 0.0;
+}
+
+void toRecord(const Pose& pose, ShmRing::Record& record)
+{
+    record.values[0] = pose.x;
+    record.values[1] = pose.y;
+    record.values[2] = pose.theta;
+    record.values[3] = pose.linear_velocity;
+    record.values[4] = pose.angular_velocity;
+    record.values[5] = 0.0;
+    record.values[6] = 0.0;
+}
+
+Twist twistFromRecord(const ShmRing::Record& record)
+{
+    Twist twist;
+    twist.linear.x = record.values[0];
+    twist.linear.y = record.values[1];
+    twist.linear.z = record.values[2];
+    twist.angular.x = record.values[3];
+    twist.angular.y = record.values[4];
+    twist.angular.z = record.values[5];
+    return twist;
+}
+
+Pose poseFromRecord(const ShmRing::Record& record)
+{
+    Pose pose;
+    pose.x = record.values[0];
+    pose.y = record.values[1];
+    pose.theta = record.values[2];
+    pose.linear_velocity = record.values[3];
+    pose.angular_velocity = record.values[4];
+    return pose;
+}
+
+ShmLink::ShmLink(const std::string& topic, const Subscribe& subscribe)
+    : topic_(topic),
+      segment_(shmSegmentName(topic)),
+      subscriber_(subscribe(*this)),
+      next_check_(Clock::now())
+{
+}
+
+void ShmLink::check()
+{
+    const Clock::time_point now = Clock::now();
+    if (now < next_check_)
+    {
+        return;
+    }
+    next_check_ = now + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(CHECK_PERIOD));
+
+    if (!ring_)
+    {
+        ring_ = ShmRing::open(segment_);
+        if (ring_)
+        {
+            owner_ = ring_->owner();
+            ROS_INFO("%s de %s por memoria compartida (%s)", topic_.c_str(), owner_.c_str(), segment_.c_str());
+        }
+    }
+    else if (!ring_->writerAlive())
+    {
+        ring_.reset();
+        ROS_INFO("%s de %s vuelve a roscpp: el publicador ha terminado", topic_.c_str(), owner_.c_str());
+        owner_.clear();
+    }
+}
+
+std::size_t ShmLink::poll(const Callback& callback)
+{
+    check();
+    std::size_t delivered = 0;
+    ShmRing::Record record;
+    while (ring_ && ring_->next(record))
+    {
+        callback(record);
+        ++delivered;
+    }
+    return delivered;
+}
+
+bool ShmLink::wait(double timeout)
+{
+    return ring_ && ring_->wait(timeout);
+}
+
+} // namespace turtle_unida
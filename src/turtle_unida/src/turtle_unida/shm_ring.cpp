@@ -0,0 +1,351 @@
+#include "turtle_unida/shm_ring.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <climits>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace turtle_unida
+{
+
+namespace
+{
+
+const std::uint32_t MAGIC = 0x74754e31;  // "tuN1"
+const std::uint32_t VERSION = 2;
+const std::size_t OWNER = 64;
+
+// Un registro por línea de caché para que escritor y lectores no compartan líneas
+struct ShmSlot
+{
+    std::atomic<std::uint64_t> seq;  // 2n+1 mientras se escribe el registro n, 2n+2 al terminar
+    double values[ShmRing::VALUES];
+};
+
+static_assert(sizeof(ShmSlot) == 64, "un registro por línea de caché");
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+    "los atómicos compartidos entre procesos tienen que ser lock-free");
+
+} // namespace
+
+// Cabecera del segmento seguida de los registros
+struct ShmSegment
+{
+    std::atomic<std::uint32_t> magic;  // se escribe el último: segmento listo
+    std::uint32_t version;
+    std::uint32_t capacity;
+    std::int32_t pid;  // proceso escritor
+    char owner[OWNER];  // quién escribe, terminado en '\0' si cabe
+
+    alignas(64) std::atomic<std::uint64_t> written;  // registros escritos en total
+    alignas(64) std::atomic<std::uint32_t> futex;     // cambia con cada registro
+    std::atomic<std::uint32_t> waiters;              // lectores dormidos en el futex
+    alignas(64) ShmSlot slots[1];
+};
+
+namespace
+{
+
+std::size_t segmentBytes(std::uint32_t capacity)
+{
+    return offsetof(ShmSegment, slots) + capacity * sizeof(ShmSlot);
+}
+
+} // namespace
+
+std::string ShmRing::segmentName(const std::string& prefix, const std::string& topic)
+{
+    std::string name = prefix;
+    for (std::size_t i = 0; i < topic.size(); ++i)
+    {
+        if (topic[i] == '/')
+        {
+            if (!name.empty() && name[name.size() - 1] != '.' && i + 1 < topic.size())
+            {
+                name += '.';
+            }
+        }
+        else
+        {
+            name += topic[i];
+        }
+    }
+    if (name.empty() || name[0] != '/')
+    {
+        name = "/" + name;
+    }
+    return name;
+}
+
+ShmRing::ShmRing(const std::string& name, ShmSegment* segment, std::size_t bytes, bool writer)
+    : name_(name), segment_(segment), bytes_(bytes), writer_(writer), inode_(0), cursor_(0), dropped_(0)
+{
+    if (!writer_)
+    {
+        cursor_ = segment_->written.load(std::memory_order_acquire);
+    }
+}
+
+std::string ShmRing::owner() const
+{
+    const char* owner = segment_->owner;
+    std::size_t length = 0;
+    while (length < OWNER && owner[length] != '\0')
+    {
+        ++length;
+    }
+    return std::string(owner, length);
+}
+
+#if defined(__linux__)
+
+namespace
+{
+
+long futex(std::atomic<std::uint32_t>* address, int op, std::uint32_t value, const struct timespec* timeout)
+{
+    // Sin FUTEX_PRIVATE_FLAG: el futex está en memoria compartida entre procesos
+    return syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(address), op, value, timeout, nullptr, 0);
+}
+
+} // namespace
+
+std::unique_ptr<ShmRing> ShmRing::create(const std::string& name, std::uint32_t capacity, const std::string& owner)
+{
+    if (capacity == 0)
+    {
+        throw std::invalid_argument("el anillo necesita al menos un registro");
+    }
+
+    // Si el escritor anterior sigue vivo el nombre es suyo: quitárselo lo
+    // dejaría escribiendo en un segmento que ningún lector nuevo encuentra
+    const std::unique_ptr<ShmRing> previous = open(name);
+    if (previous)
+    {
+        throw std::runtime_error("el segmento " + name + " ya tiene un escritor vivo (pid " +
+            std::to_string(previous->segment_->pid) + ")");
+    }
+
+    // Un segmento anterior puede seguir abierto por lectores antiguos; se
+    // desvincula y se crea otro para no escribir en el suyo
+    shm_unlink(name.c_str());
+    const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+    {
+        throw std::runtime_error("shm_open(" + name + "): " + std::strerror(errno));
+    }
+    const std::size_t bytes = segmentBytes(capacity);
+    struct stat info;
+    if (ftruncate(fd, static_cast<off_t>(bytes)) != 0 || fstat(fd, &info) != 0)
+    {
+        const int error = errno;
+        close(fd);
+        shm_unlink(name.c_str());
+        throw std::runtime_error("ftruncate(" + name + "): " + std::strerror(error));
+    }
+    void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED)
+    {
+        const int error = errno;
+        shm_unlink(name.c_str());
+        throw std::runtime_error("mmap(" + name + "): " + std::strerror(error));
+    }
+
+    // ftruncate deja el segmento a cero: contadores y secuencias ya valen 0
+    ShmSegment* segment = static_cast<ShmSegment*>(memory);
+    segment->version = VERSION;
+    segment->capacity = capacity;
+    segment->pid = static_cast<std::int32_t>(getpid());
+    std::memcpy(segment->owner, owner.data(), std::min(owner.size(), OWNER));
+    segment->magic.store(MAGIC, std::memory_order_release);
+    std::unique_ptr<ShmRing> ring(new ShmRing(name, segment, bytes, true));
+    ring->inode_ = static_cast<std::uint64_t>(info.st_ino);
+    return ring;
+}
+
+std::unique_ptr<ShmRing> ShmRing::open(const std::string& name)
+{
+    const int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+    {
+        return std::unique_ptr<ShmRing>();
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < segmentBytes(1))
+    {
+        close(fd);
+        return std::unique_ptr<ShmRing>();
+    }
+    const std::size_t bytes = static_cast<std::size_t>(info.st_size);
+    void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED)
+    {
+        return std::unique_ptr<ShmRing>();
+    }
+
+    ShmSegment* segment = static_cast<ShmSegment*>(memory);
+    std::unique_ptr<ShmRing> ring(new ShmRing(name, segment, bytes, false));
+    if (segment->magic.load(std::memory_order_acquire) != MAGIC || segment->version != VERSION ||
+        segmentBytes(segment->capacity) > bytes || !ring->writerAlive())
+    {
+        ring.reset();
+    }
+    return ring;
+}
+
+ShmRing::~ShmRing()
+{
+    if (writer_)
+    {
+        // Solo se desvincula si el nombre sigue siendo nuestro y no de un
+        // escritor posterior. Los lectores conectados conservan su mapeo y
+        // ven que el escritor ha muerto.
+        const int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+        struct stat info;
+        if (fd >= 0 && fstat(fd, &info) == 0 && static_cast<std::uint64_t>(info.st_ino) == inode_)
+        {
+            shm_unlink(name_.c_str());
+        }
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+    }
+    munmap(segment_, bytes_);
+}
+
+void ShmRing::write(const Record& record)
+{
+    const std::uint64_t n = segment_->written.load(std::memory_order_relaxed);
+    ShmSlot& slot = segment_->slots[n % segment_->capacity];
+
+    slot.seq.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(slot.values, record.values, sizeof(slot.values));
+    slot.seq.store(2 * n + 2, std::memory_order_release);
+    segment_->written.store(n + 1, std::memory_order_release);
+
+    // La llamada al sistema solo se hace si algún lector duerme
+    segment_->futex.fetch_add(1, std::memory_order_seq_cst);
+    if (segment_->waiters.load(std::memory_order_seq_cst) > 0)
+    {
+        futex(&segment_->futex, FUTEX_WAKE, INT_MAX, nullptr);
+    }
+}
+
+bool ShmRing::next(Record& record)
+{
+    const std::uint64_t capacity = segment_->capacity;
+    for (;;)
+    {
+        const std::uint64_t written = segment_->written.load(std::memory_order_acquire);
+        if (cursor_ >= written)
+        {
+            return false;
+        }
+        if (written - cursor_ > capacity)
+        {
+            // El escritor ha dado la vuelta: se saltan los registros perdidos
+            dropped_ += written - capacity - cursor_;
+            cursor_ = written - capacity;
+        }
+
+        const ShmSlot& slot = segment_->slots[cursor_ % capacity];
+        const std::uint64_t expected = 2 * cursor_ + 2;
+        const std::uint64_t before = slot.seq.load(std::memory_order_acquire);
+        if (before == expected)
+        {
+            std::memcpy(record.values, slot.values, sizeof(record.values));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) == expected)
+            {
+                ++cursor_;
+                return true;
+            }
+        }
+        // Sobrescrito mientras se leía: se vuelve a mirar cuánto se ha escrito
+        if (segment_->written.load(std::memory_order_acquire) - cursor_ <= capacity)
+        {
+            ++dropped_;
+            ++cursor_;
+        }
+    }
+}
+
+bool ShmRing::wait(double timeout)
+{
+    const std::uint32_t observed = segment_->futex.load(std::memory_order_seq_cst);
+    if (segment_->written.load(std::memory_order_acquire) > cursor_)
+    {
+        return true;
+    }
+
+    struct timespec limit;
+    limit.tv_sec = static_cast<time_t>(timeout);
+    limit.tv_nsec = static_cast<long>((timeout - static_cast<double>(limit.tv_sec)) * 1e9);
+    segment_->waiters.fetch_add(1, std::memory_order_seq_cst);
+    // Si el escritor ya ha cambiado el futex, la llamada vuelve enseguida
+    futex(&segment_->futex, FUTEX_WAIT, observed, &limit);
+    segment_->waiters.fetch_sub(1, std::memory_order_seq_cst);
+    return segment_->written.load(std::memory_order_acquire) > cursor_;
+}
+
+bool ShmRing::writerAlive() const
+{
+    return kill(static_cast<pid_t>(segment_->pid), 0) == 0 || errno == EPERM;
+}
+
+#else
+
+std::unique_ptr<ShmRing> ShmRing::create(const std::string& name, std::uint32_t /*capacity*/,
+    const std::string& /*owner*/)
+{
+    throw std::runtime_error("memoria compartida no disponible en esta plataforma: " + name);
+}
+
+std::unique_ptr<ShmRing> ShmRing::open(const std::string& /*name*/)
+{
+    return std::unique_ptr<ShmRing>();
+}
+
+ShmRing::~ShmRing()
+{
+}
+
+void ShmRing::write(const Record& /*record*/)
+{
+}
+
+bool ShmRing::next(Record& /*record*/)
+{
+    return false;
+}
+
+bool ShmRing::wait(double /*timeout*/)
+{
+    return false;
+}
+
+bool ShmRing::writerAlive() const
+{
+    return false;
+}
+
+#endif
+
+} // namespace turtle_unida
@@ -0,0 +1,86 @@
+#include "turtle_unida/sim_transport.h"
+
+#include <stdexcept>
+
+namespace turtle_unida
+{
+
+SimTransport::SimTransport(Simulator& simulator)
+    : simulator_(simulator)
+{
+}
+
+std::size_t SimTransport::spawn(const std::string& name, double x, double y, double theta)
+{
+    if (names_.count(name))
+    {
+        throw std::invalid_argument("ya existe una tortuga llamada " + name);
+    }
+    const std::size_t index = simulator_.spawn(x, y, theta);
+    names_[name] = index;
+    return index;
+}
+
+std::size_t SimTransport::turtle(const std::string& name) const
+{
+    const std::map<std::string, std::size_t>::const_iterator it = names_.find(name);
+    if (it == names_.end())
+    {
+        throw std::invalid_argument("no existe la tortuga " + name);
+    }
+    return it->second;
+}
+
+std::size_t SimTransport::turtleFromTopic(const std::string& topic, const std::string& suffix) const
+{
+    // "/turtle1/cmd_vel" -> "turtle1"
+    const std::size_t begin = topic.find_first_not_of('/');
+    const std::size_t end = topic.find('/', begin);
+    if (begin == std::string::npos || end == std::string::npos || topic.compare(end + 1, std::string::npos, suffix) != 0)
+    {
+        throw std::invalid_argument("topic no soportado por el simulador: " + topic);
+    }
+    return turtle(topic.substr(begin, end - begin));
+}
+
+Transport::Channel SimTransport::advertise(const std::string& topic)
+{
+    channels_.push_back(turtleFromTopic(topic, "cmd_vel"));
+    return channels_.size() - 1;
+}
+
+void SimTransport::publish(Channel channel, const Twist& twist)
+{
+    simulator_.command(channels_[channel], twist);
+
+    CommandStamp stamp;
+    if (readStamp(twist, stamp))
+    {
+        // En el mismo proceso la entrega es inmediata; la entrada en la cola
+        // solo se conserva si la marcó el modo pipeline
+        const std::uint64_t now = monotonicNanos();
+        stamp.enqueued = stamp.enqueued ? stamp.enqueued : now;
+        stamp.sent = now;
+        latency_.record(stamp, now);
+    }
+    else
+    {
+        latency_.recordUnstamped();
+    }
+}
+
+void SimTransport::subscribe(const std::string& topic, const PoseCallback& callback)
+{
+    subscribers_.push_back(std::make_pair(turtleFromTopic(topic, "pose"), callback));
+}
+
+void SimTransport::step()
+{
+    simulator_.step();
+    for (std::size_t i = 0; i < subscribers_.size(); ++i)
+    {
+        subscribers_[i].second(simulator_.pose(subscribers_[i].first));
+    }
+}
+
+} // namespace turtle_unida
@@ -0,0 +1,193 @@
+#include "turtle_unida/simulator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace turtle_unida
+{
+
+namespace
+{
+
+// Cada cuántos pasos se vuelve a normalizar el vector de orientación
+const std::uint64_t RENORMALIZE_STEPS = 1024;
+
+TrailPoint makeTrailPoint(double x, double y, bool pen_down)
+{
+    TrailPoint point;
+    point.x = static_cast<float>(x);
+    point.y = static_cast<float>(y);
+    point.pen_down = pen_down;
+    return point;
+}
+
+// Integra un paso de todas las tortugas y devuelve cuántas han chocado con
+// la pared. Sin saltos ni llamadas a funciones para que el bucle se vectorice.
+std::uint64_t integrate(std::size_t n, double now, double dt, double size,
+    const double* __restrict linear, const double* __restrict rot_cos, const double* __restrict rot_sin,
+    const double* __restrict deadline, double* __restrict x, double* __restrict y,
+    double* __restrict cs, double* __restrict sn)
+{
+    // El contador es double para que todas las columnas tengan el mismo tipo
+    // de vector; es exacto hasta 2^53 choques
+    double hits = 0.0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        // 1 mientras el último comando siga vigente, 0 cuando ha caducado
+        const double active = now < deadline[i] ? 1.0 : 0.0;
+        const double rc = 1.0 + active * (rot_cos[i] - 1.0);
+        const double rs = active * rot_sin[i];
+        const double distance = active * linear[i] * dt;
+
+        // Como turtlesim: primero gira y luego avanza con la orientación nueva
+        const double c = cs[i] * rc - sn[i] * rs;
+        const double s = sn[i] * rc + cs[i] * rs;
+        cs[i] = c;
+        sn[i] = s;
+
+        const double nx = x[i] + c * distance;
+        const double ny = y[i] + s * distance;
+        const double cx = std::min(std::max(nx, 0.0), size);
+        const double cy = std::min(std::max(ny, 0.0), size);
+        hits += (cx != nx || cy != ny) ? 1.0 : 0.0;
+        x[i] = cx;
+        y[i] = cy;
+    }
+    return static_cast<std::uint64_t>(hits);
+}
+
+} // namespace
+
+SimulatorConfig::SimulatorConfig()
+    : world_size(11.088889),
+      dt(0.016),
+      command_timeout(1.0),
+      trails(false),
+      trail_resolution(0.05)
+{
+}
+
+Simulator::Simulator(const SimulatorConfig& config)
+    : config_(config), time_(0.0), steps_(0), wall_hits_(0)
+{
+}
+
+std::size_t Simulator::spawn(double x, double y, double theta)
+{
+    x_.push_back(x);
+    y_.push_back(y);
+    cos_.push_back(std::cos(theta));
+    sin_.push_back(std::sin(theta));
+    linear_.push_back(0.0);
+    angular_.push_back(0.0);
+    rot_cos_.push_back(1.0);
+    rot_sin_.push_back(0.0);
+    deadline_.push_back(0.0);
+    pen_.push_back(1);
+    trails_.push_back(std::vector<TrailPoint>());
+    if (config_.trails)
+    {
+        trails_.back().push_back(makeTrailPoint(x, y, false));
+    }
+    return x_.size() - 1;
+}
+
+void Simulator::command(std::size_t turtle, const Twist& twist)
+{
+    linear_[turtle] = twist.linear.x;
+    if (angular_[turtle] != twist.angular.z)
+    {
+        angular_[turtle] = twist.angular.z;
+        rot_cos_[turtle] = std::cos(twist.angular.z * config_.dt);
+        rot_sin_[turtle] = std::sin(twist.angular.z * config_.dt);
+    }
+    deadline_[turtle] = time_ + config_.command_timeout;
+}
+
+void Simulator::teleport(std::size_t turtle, double x, double y, double theta)
+{
+    x_[turtle] = std::min(std::max(x, 0.0), config_.world_size);
+    y_[turtle] = std::min(std::max(y, 0.0), config_.world_size);
+    cos_[turtle] = std::cos(theta);
+    sin_[turtle] = std::sin(theta);
+    if (config_.trails)
+    {
+        trails_[turtle].push_back(makeTrailPoint(x_[turtle], y_[turtle], pen_[turtle] != 0));
+    }
+}
+
+void Simulator::setPen(std::size_t turtle, bool down)
+{
+    if (config_.trails && down && !pen_[turtle])
+    {
+        // Empieza un trazo nuevo en la posición actual
+        trails_[turtle].push_back(makeTrailPoint(x_[turtle], y_[turtle], false));
+    }
+    pen_[turtle] = down ? 1 : 0;
+}
+
+void Simulator::step()
+{
+    const std::size_t n = x_.size();
+    wall_hits_ += integrate(n, time_, config_.dt, config_.world_size, linear_.data(), rot_cos_.data(),
+        rot_sin_.data(), deadline_.data(), x_.data(), y_.data(), cos_.data(), sin_.data());
+
+    time_ += config_.dt;
+    ++steps_;
+    if (steps_ % RENORMALIZE_STEPS == 0)
+    {
+        // Corrige el error de redondeo acumulado por las rotaciones
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const double inv = 1.0 / std::sqrt(cos_[i] * cos_[i] + sin_[i] * sin_[i]);
+            cos_[i] *= inv;
+            sin_[i] *= inv;
+        }
+    }
+    if (config_.trails)
+    {
+        recordTrails();
+    }
+}
+
+void Simulator::advance(double duration)
+{
+    const std::uint64_t steps = static_cast<std::uint64_t>(std::floor(duration / config_.dt + 0.5));
+    for (std::uint64_t i = 0; i < steps; ++i)
+    {
+        step();
+    }
+}
+
+Pose Simulator::pose(std::size_t turtle) const
+{
+    const bool active = time_ < deadline_[turtle];
+    Pose pose;
+    pose.x = x_[turtle];
+    pose.y = y_[turtle];
+    pose.theta = std::atan2(sin_[turtle], cos_[turtle]);
+    pose.linear_velocity = active ? linear_[turtle] : 0.0;
+    pose.angular_velocity = active ? angular_[turtle] : 0.0;
+    return pose;
+}
+
+void Simulator::recordTrails()
+{
+    const double min_distance2 = config_.trail_resolution * config_.trail_resolution;
+    for (std::size_t i = 0; i < x_.size(); ++i)
+    {
+        if (!pen_[i])
+        {
+            continue;
+        }
+        std::vector<TrailPoint>& trail = trails_[i];
+        const double dx = x_[i] - trail.back().x;
+        const double dy = y_[i] - trail.back().y;
+        if (dx * dx + dy * dy >= min_distance2)
+        {
+            trail.push_back(makeTrailPoint(x_[i], y_[i], true));
+        }
+    }
+}
+
+} // namespace turtle_unida
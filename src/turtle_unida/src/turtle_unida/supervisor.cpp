@@ -0,0 +1,493 @@
+#include "turtle_unida/supervisor.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include "turtle_unida/launcher.h"
+
+namespace turtle_unida
+{
+
+namespace
+{
+
+const char SEPARATOR[] = "--";
+
+double nowSeconds()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+double seconds(const struct timeval& time)
+{
+    return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_usec) * 1e-6;
+}
+
+bool endsWith(const std::string& text, const std::string& suffix)
+{
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+int parseInt(const std::string& text, const std::string& where)
+{
+    char* end = nullptr;
+    errno = 0;
+    const long value = std::strtol(text.c_str(), &end, 10);
+    if (text.empty() || *end != '\0' || errno == ERANGE || value < 0 || value > 1000000)
+    {
+        throw std::runtime_error(where + ": número no válido [" + text + "]");
+    }
+    return static_cast<int>(value);
+}
+
+// "0,2-3" -> {0, 2, 3}
+std::vector<int> parseCpus(const std::string& text, const std::string& where)
+{
+    std::vector<int> cpus;
+    std::size_t begin = 0;
+    while (begin <= text.size())
+    {
+        const std::size_t comma = text.find(',', begin);
+        const std::string item = text.substr(begin, comma == std::string::npos ? std::string::npos : comma - begin);
+        const std::size_t dash = item.find('-');
+        const int first = parseInt(item.substr(0, dash), where);
+        const int last = dash == std::string::npos ? first : parseInt(item.substr(dash + 1), where);
+        if (last < first || last >= CPU_SETSIZE)
+        {
+            throw std::runtime_error(where + ": núcleos no válidos [" + item + "]");
+        }
+        for (int cpu = first; cpu <= last; ++cpu)
+        {
+            cpus.push_back(cpu);
+        }
+        if (comma == std::string::npos)
+        {
+            break;
+        }
+        begin = comma + 1;
+    }
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+RestartPolicy parseRestart(const std::string& text, const std::string& where)
+{
+    if (text == "never")
+    {
+        return RESTART_NEVER;
+    }
+    if (text == "on-failure")
+    {
+        return RESTART_ON_FAILURE;
+    }
+    if (text == "always")
+    {
+        return RESTART_ALWAYS;
+    }
+    throw std::runtime_error(where + ": política de reinicio no válida [" + text + "]");
+}
+
+int exitCode(int status)
+{
+    if (WIFSIGNALED(status))
+    {
+        return 128 + WTERMSIG(status);
+    }
+    return WEXITSTATUS(status);
+}
+
+struct timespec toTimespec(double seconds)
+{
+    struct timespec time;
+    seconds = std::max(0.0, seconds);
+    time.tv_sec = static_cast<time_t>(seconds);
+    time.tv_nsec = static_cast<long>((seconds - static_cast<double>(time.tv_sec)) * 1e9);
+    return time;
+}
+
+// Señales que atiende el supervisor
+sigset_t handledSignals()
+{
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGCHLD);
+    sigaddset(&set, SIGINT);
+    sigaddset(&set, SIGTERM);
+    sigaddset(&set, SIGHUP);
+    return set;
+}
+
+} // namespace
+
+NodeSpec::NodeSpec()
+    : restart(RESTART_ON_FAILURE), max_restarts(-1)
+{
+}
+
+std::vector<NodeSpec> readSupervisorFile(const std::string& path)
+{
+    std::ifstream file(path.c_str());
+    if (!file)
+    {
+        throw std::runtime_error("no se puede leer la lista de nodos " + path);
+    }
+
+    std::vector<NodeSpec> nodes;
+    std::string line;
+    int number = 0;
+    while (std::getline(file, line))
+    {
+        ++number;
+        const std::string where = path + ":" + std::to_string(number);
+        const std::size_t comment = line.find('#');
+        if (comment != std::string::npos)
+        {
+            line.erase(comment);
+        }
+        std::istringstream tokens(line);
+        std::string token;
+        if (!(tokens >> token))
+        {
+            continue;
+        }
+
+        NodeSpec node;
+        node.name = token;
+        bool command = false;
+        while (tokens >> token)
+        {
+            if (command)
+            {
+                node.command.push_back(token);
+                continue;
+            }
+            if (token == SEPARATOR)
+            {
+                command = true;
+                continue;
+            }
+            const std::size_t equals = token.find('=');
+            const std::string key = token.substr(0, equals);
+            const std::string value = equals == std::string::npos ? std::string() : token.substr(equals + 1);
+            if (key == "cpus")
+            {
+                node.cpus = parseCpus(value, where);
+            }
+            else if (key == "restart")
+            {
+                node.restart = parseRestart(value, where);
+            }
+            else if (key == "retries")
+            {
+                node.max_restarts = parseInt(value, where);
+            }
+            else
+            {
+                throw std::runtime_error(where + ": opción desconocida [" + token + "]");
+            }
+        }
+        if (node.command.empty())
+        {
+            throw std::runtime_error(where + ": falta el comando del nodo " + node.name + " tras --");
+        }
+        for (std::size_t i = 0; i < nodes.size(); ++i)
+        {
+            if (nodes[i].name == node.name)
+            {
+                throw std::runtime_error(where + ": nodo repetido " + node.name);
+            }
+        }
+        nodes.push_back(node);
+    }
+    return nodes;
+}
+
+SupervisorConfig::SupervisorConfig()
+    : backoff(0.5), backoff_max(30.0), stable_time(10.0), stop_timeout(5.0), duration(0.0)
+{
+}
+
+NodeStats::NodeStats()
+    : pid(0), starts(0), failures(0), last_exit(-1), startup(0.0), startup_max(0.0), cpu_user(0.0), cpu_system(0.0),
+      max_rss_kb(0), uptime(0.0)
+{
+}
+
+std::string NodeStats::json(const std::string& name) const
+{
+    char buffer[384];
+    std::snprintf(buffer, sizeof(buffer),
+        "{\"node\":\"%s\",\"pid\":%d,\"starts\":%d,\"failures\":%d,\"last_exit\":%d,\"startup_us\":%.1f,"
+        "\"startup_us_max\":%.1f,\"cpu_user_s\":%.3f,\"cpu_system_s\":%.3f,\"max_rss_kb\":%ld,\"uptime_s\":%.3f}",
+        name.c_str(), pid, starts, failures, last_exit, startup * 1e6, startup_max * 1e6, cpu_user, cpu_system,
+        max_rss_kb, uptime);
+    return buffer;
+}
+
+Supervisor::Supervisor(const std::vector<NodeSpec>& nodes, const SupervisorConfig& config)
+    : nodes_(nodes), config_(config), cache_(LaunchCache::defaultFile()), stopping_(false), pids_(nodes.size(), 0),
+      started_at_(nodes.size(), 0.0), restart_at_(nodes.size(), -1.0), backoff_(nodes.size(), config.backoff),
+      restarts_(nodes.size(), 0), stats_(nodes.size())
+{
+    if (config_.backoff <= 0.0 || config_.backoff_max < config_.backoff || config_.stop_timeout <= 0.0 ||
+        config_.duration < 0.0)
+    {
+        throw std::invalid_argument("configuración del supervisor no válida");
+    }
+}
+
+void Supervisor::start(std::size_t node, double now)
+{
+    const NodeSpec& spec = nodes_[node];
+    restart_at_[node] = -1.0;
+
+    // El hijo hereda la afinidad del supervisor en el spawn: se cambia la
+    // propia un momento en vez de fijar al hijo cuando ya está corriendo
+    cpu_set_t previous;
+    bool pinned = false;
+    if (!spec.cpus.empty() && ::sched_getaffinity(0, sizeof(previous), &previous) == 0)
+    {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (std::size_t i = 0; i < spec.cpus.size(); ++i)
+        {
+            CPU_SET(spec.cpus[i], &cpus);
+        }
+        pinned = ::sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+        if (!pinned)
+        {
+            std::fprintf(stderr, "[supervisor] %s: no se puede fijar a sus núcleos (%s), arranca sin fijar\n",
+                spec.name.c_str(), std::strerror(errno));
+        }
+    }
+
+    LaunchTiming timing;
+    std::string error;
+    try
+    {
+        if (endsWith(spec.command[0], ".py"))
+        {
+            const std::vector<std::string> args(spec.command.begin() + 1, spec.command.end());
+            spawnScript(spec.command[0], args, timing, &cache_);
+        }
+        else
+        {
+            const double begin = nowSeconds();
+            timing.pid = spawnProcess(spec.command);
+            timing.spawn = nowSeconds() - begin;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        error = e.what();
+    }
+    if (pinned)
+    {
+        ::sched_setaffinity(0, sizeof(previous), &previous);
+    }
+
+    NodeStats& stats = stats_[node];
+    ++stats.starts;
+    if (!error.empty())
+    {
+        ++stats.failures;
+        stats.last_exit = 127;
+        std::fprintf(stderr, "[supervisor] %s no arranca: %s\n", spec.name.c_str(), error.c_str());
+        if (spec.restart != RESTART_NEVER && (spec.max_restarts < 0 || restarts_[node] < spec.max_restarts))
+        {
+            ++restarts_[node];
+            restart_at_[node] = now + backoff_[node];
+            backoff_[node] = std::min(2.0 * backoff_[node], config_.backoff_max);
+        }
+        return;
+    }
+
+    pids_[node] = timing.pid;
+    started_at_[node] = now;
+    stats.pid = timing.pid;
+    stats.last_exit = -1;
+    stats.startup = timing.interpreter + timing.spawn;
+    stats.startup_max = std::max(stats.startup_max, stats.startup);
+    std::fprintf(stderr, "[supervisor] %s arrancado (pid %d) en %.0f us\n", spec.name.c_str(), timing.pid,
+        stats.startup * 1e6);
+}
+
+void Supervisor::reap(double now)
+{
+    for (;;)
+    {
+        int status = 0;
+        struct rusage usage;
+        const pid_t pid = ::wait4(-1, &status, WNOHANG, &usage);
+        if (pid <= 0)
+        {
+            return;
+        }
+        const std::vector<int>::iterator found = std::find(pids_.begin(), pids_.end(), static_cast<int>(pid));
+        if (found == pids_.end())
+        {
+            continue;
+        }
+        const std::size_t node = static_cast<std::size_t>(found - pids_.begin());
+        const NodeSpec& spec = nodes_[node];
+        NodeStats& stats = stats_[node];
+        const double ran = now - started_at_[node];
+        pids_[node] = 0;
+
+        // wait4 da los recursos de esa ejecución; ru_maxrss en KiB en Linux
+        stats.cpu_user += seconds(usage.ru_utime);
+        stats.cpu_system += seconds(usage.ru_stime);
+        stats.max_rss_kb = std::max(stats.max_rss_kb, static_cast<long>(usage.ru_maxrss));
+        stats.uptime += ran;
+        stats.last_exit = exitCode(status);
+        if (stopping_)
+        {
+            continue;
+        }
+
+        const bool failed = stats.last_exit != 0;
+        stats.failures += failed;
+        const bool restart = spec.restart == RESTART_ALWAYS || (spec.restart == RESTART_ON_FAILURE && failed);
+        if (!restart || (spec.max_restarts >= 0 && restarts_[node] >= spec.max_restarts))
+        {
+            std::fprintf(stderr, "[supervisor] %s (pid %d) ha terminado con código %d tras %.1f s\n",
+                spec.name.c_str(), static_cast<int>(pid), stats.last_exit, ran);
+            continue;
+        }
+
+        // Una ejecución larga es que el nodo estaba bien: la espera vuelve al principio
+        if (ran >= config_.stable_time)
+        {
+            backoff_[node] = config_.backoff;
+        }
+        ++restarts_[node];
+        restart_at_[node] = now + backoff_[node];
+        std::fprintf(stderr, "[supervisor] %s (pid %d) ha terminado con código %d tras %.1f s; reinicio en %.1f s\n",
+            spec.name.c_str(), static_cast<int>(pid), stats.last_exit, ran, backoff_[node]);
+        backoff_[node] = std::min(2.0 * backoff_[node], config_.backoff_max);
+    }
+}
+
+bool Supervisor::running() const
+{
+    for (std::size_t node = 0; node < nodes_.size(); ++node)
+    {
+        if (pids_[node] > 0 || restart_at_[node] >= 0.0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Supervisor::stop()
+{
+    stopping_ = true;
+    std::fill(restart_at_.begin(), restart_at_.end(), -1.0);
+
+    const sigset_t children = handledSignals();
+    const int escalation[] = {SIGINT, SIGTERM, SIGKILL};
+    for (int step = 0; step < 3 && running(); ++step)
+    {
+        for (std::size_t node = 0; node < nodes_.size(); ++node)
+        {
+            if (pids_[node] > 0)
+            {
+                ::kill(static_cast<pid_t>(pids_[node]), escalation[step]);
+            }
+        }
+        const double deadline = nowSeconds() + config_.stop_timeout;
+        while (running())
+        {
+            const double left = deadline - nowSeconds();
+            if (left <= 0.0)
+            {
+                break;
+            }
+            const struct timespec timeout = toTimespec(left);
+            ::sigtimedwait(&children, nullptr, &timeout);
+            reap(nowSeconds());
+        }
+    }
+}
+
+int Supervisor::run()
+{
+    const sigset_t handled = handledSignals();
+    sigset_t previous;
+    ::sigprocmask(SIG_BLOCK, &handled, &previous);
+    stopping_ = false;
+
+    const double begin = nowSeconds();
+    for (std::size_t node = 0; node < nodes_.size(); ++node)
+    {
+        start(node, begin);
+    }
+    cache_.save();
+
+    const double end = config_.duration > 0.0 ? begin + config_.duration : -1.0;
+    while (running())
+    {
+        // Hasta el próximo reinicio pendiente o el final
+        double wake = end;
+        for (std::size_t node = 0; node < nodes_.size(); ++node)
+        {
+            if (restart_at_[node] >= 0.0 && (wake < 0.0 || restart_at_[node] < wake))
+            {
+                wake = restart_at_[node];
+            }
+        }
+        siginfo_t info;
+        int signal;
+        if (wake < 0.0)
+        {
+            signal = ::sigwaitinfo(&handled, &info);
+        }
+        else
+        {
+            const struct timespec timeout = toTimespec(wake - nowSeconds());
+            signal = ::sigtimedwait(&handled, &info, &timeout);
+        }
+
+        const double now = nowSeconds();
+        if (signal == SIGINT || signal == SIGTERM || signal == SIGHUP || (end >= 0.0 && now >= end))
+        {
+            break;
+        }
+        reap(now);
+        for (std::size_t node = 0; node < nodes_.size(); ++node)
+        {
+            if (restart_at_[node] >= 0.0 && restart_at_[node] <= now)
+            {
+                start(node, now);
+            }
+        }
+    }
+
+    stop();
+    cache_.save();
+    ::sigprocmask(SIG_SETMASK, &previous, nullptr);
+
+    int failed = 0;
+    for (std::size_t node = 0; node < nodes_.size(); ++node)
+    {
+        failed += stats_[node].failures > 0;
+    }
+    return failed;
+}
+
+} // namespace turtle_unida
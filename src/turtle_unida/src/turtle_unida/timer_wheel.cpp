@@ -0,0 +1,486 @@
+#include "turtle_unida/timer_wheel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace turtle_unida
+{
+
+namespace
+{
+
+const std::uint64_t NEVER = std::numeric_limits<std::uint64_t>::max();
+
+// Pasos de `resolution` en `seconds`, redondeando hacia arriba (vencimientos)
+// o hacia abajo (instante actual). Los valores que caen casi justo en un paso
+// cuentan como ese paso para que 0.3 / 0.001 no se convierta en 301.
+std::uint64_t steps(double seconds, double resolution, bool up)
+{
+    const double value = seconds / resolution;
+    if (!(value > 0.0))
+    {
+        return 0;
+    }
+    if (value >= 1.8e19)
+    {
+        return NEVER - 1;
+    }
+    const double nearest = std::round(value);
+    if (std::fabs(value - nearest) < 1e-6)
+    {
+        return static_cast<std::uint64_t>(nearest);
+    }
+    return static_cast<std::uint64_t>(up ? std::ceil(value) : std::floor(value));
+}
+
+// Primer bit a 1 de un mapa de 256 bits a partir de `from`; 256 si no hay
+int nextBit(const std::uint64_t* words, int from)
+{
+    for (int w = from >> 6; w < TimerWheel::SLOTS / 64; ++w)
+    {
+        std::uint64_t bits = words[w];
+        if (w == from >> 6)
+        {
+            bits &= ~0ull << (from & 63);
+        }
+        if (bits)
+        {
+            return w * 64 + __builtin_ctzll(bits);
+        }
+    }
+    return TimerWheel::SLOTS;
+}
+
+} // namespace
+
+const int TimerWheel::LEVELS;
+const int TimerWheel::SLOT_BITS;
+const int TimerWheel::SLOTS;
+const std::uint32_t TimerWheel::NONE;
+const std::uint32_t TimerWheel::OVERFLOW_LIST;
+const std::uint32_t TimerWheel::DUE_LIST;
+const std::uint32_t TimerWheel::LISTS;
+const std::uint32_t TimerWheel::FIRING;
+const std::uint32_t TimerWheel::CANCELLED;
+
+TimerStats::TimerStats()
+    : scheduled(0), cancelled(0), expired(0), cascaded(0), wakeups(0)
+{
+}
+
+std::string TimerStats::summary() const
+{
+    char buffer[160];
+    std::snprintf(buffer, sizeof(buffer), "scheduled=%llu cancelled=%llu expired=%llu cascaded=%llu wakeups=%llu",
+        static_cast<unsigned long long>(scheduled), static_cast<unsigned long long>(cancelled),
+        static_cast<unsigned long long>(expired), static_cast<unsigned long long>(cascaded),
+        static_cast<unsigned long long>(wakeups));
+    return buffer;
+}
+
+TimerWheel::TimerWheel(double resolution)
+    : resolution_(resolution), current_(0), size_(0), heads_(LISTS, NONE)
+{
+    if (!(resolution > 0.0))
+    {
+        throw std::invalid_argument("la resolución de los temporizadores debe ser positiva");
+    }
+    std::memset(occupied_, 0, sizeof(occupied_));
+}
+
+TimerId TimerWheel::add(double deadline, double period, const Callback& callback)
+{
+    if (!callback)
+    {
+        throw std::invalid_argument("temporizador sin callback");
+    }
+    if (period < 0.0 || std::isnan(period))
+    {
+        throw std::invalid_argument("el periodo de un temporizador no puede ser negativo");
+    }
+
+    std::uint32_t timer;
+    if (!free_.empty())
+    {
+        timer = free_.back();
+        free_.pop_back();
+    }
+    else
+    {
+        if (deadline_.size() >= NONE)
+        {
+            throw std::length_error("demasiados temporizadores");
+        }
+        timer = static_cast<std::uint32_t>(deadline_.size());
+        deadline_.push_back(0);
+        period_.push_back(0);
+        next_.push_back(NONE);
+        prev_.push_back(NONE);
+        list_.push_back(NONE);
+        generation_.push_back(1);
+        callbacks_.push_back(Callback());
+    }
+
+    deadline_[timer] = std::max(steps(deadline, resolution_, true), current_ + 1);
+    period_[timer] = period > 0.0 ? std::max<std::uint64_t>(1, steps(period, resolution_, true)) : 0;
+    callbacks_[timer] = callback;
+    place(timer);
+    ++size_;
+    ++stats_.scheduled;
+    return static_cast<TimerId>(generation_[timer]) << 32 | timer;
+}
+
+bool TimerWheel::cancel(TimerId id)
+{
+    const std::uint32_t timer = static_cast<std::uint32_t>(id & 0xffffffffu);
+    if (timer >= list_.size() || generation_[timer] != static_cast<std::uint32_t>(id >> 32) ||
+        list_[timer] == NONE || list_[timer] == CANCELLED)
+    {
+        return false;
+    }
+    ++stats_.cancelled;
+    if (list_[timer] == FIRING)
+    {
+        // Se cancela desde su propio callback: el hueco se libera al volver
+        list_[timer] = CANCELLED;
+        return true;
+    }
+    unlink(timer);
+    release(timer);
+    return true;
+}
+
+void TimerWheel::advance(double now)
+{
+    const std::uint64_t target = steps(now, resolution_, false);
+
+    // Vencidos que quedaron pendientes si un callback lanzó una excepción
+    fireDue();
+    for (;;)
+    {
+        const std::uint64_t next = nextEvent();
+        if (next > target)
+        {
+            current_ = std::max(current_, target);
+            return;
+        }
+        current_ = next;
+        processTick();
+    }
+}
+
+double TimerWheel::nextExpiry() const
+{
+    if (heads_[DUE_LIST] != NONE)
+    {
+        return now();
+    }
+
+    // En cada nivel basta la primera casilla ocupada: las siguientes vencen
+    // después. En el nivel 0 la casilla es el vencimiento exacto; en los
+    // superiores es una cota inferior y se busca el mínimo en la lista.
+    std::uint64_t best = NEVER;
+    for (int level = 0; level < LEVELS; ++level)
+    {
+        const int shift = level * SLOT_BITS;
+        const int digit = static_cast<int>((current_ >> shift) & (SLOTS - 1));
+        const int slot = nextBit(occupied_[level], digit + 1);
+        if (slot == SLOTS)
+        {
+            continue;
+        }
+        const std::uint64_t start = (current_ >> (shift + SLOT_BITS) << (shift + SLOT_BITS)) |
+            static_cast<std::uint64_t>(slot) << shift;
+        if (start >= best)
+        {
+            continue;
+        }
+        if (level == 0)
+        {
+            best = start;
+            continue;
+        }
+        for (std::uint32_t t = heads_[level * SLOTS + slot]; t != NONE; t = next_[t])
+        {
+            best = std::min(best, deadline_[t]);
+        }
+    }
+    for (std::uint32_t t = heads_[OVERFLOW_LIST]; t != NONE; t = next_[t])
+    {
+        best = std::min(best, deadline_[t]);
+    }
+    return best == NEVER ? std::numeric_limits<double>::infinity() : best * resolution_;
+}
+
+std::uint32_t TimerWheel::listOf(std::uint64_t deadline) const
+{
+    // El nivel es el dígito más alto en el que el vencimiento difiere del paso actual
+    const std::uint64_t diff = deadline ^ current_;
+    const int level = diff ? (63 - __builtin_clzll(diff)) / SLOT_BITS : 0;
+    if (level >= LEVELS)
+    {
+        return OVERFLOW_LIST;
+    }
+    return static_cast<std::uint32_t>(level * SLOTS + ((deadline >> (level * SLOT_BITS)) & (SLOTS - 1)));
+}
+
+void TimerWheel::link(std::uint32_t list, std::uint32_t timer)
+{
+    const std::uint32_t head = heads_[list];
+    next_[timer] = head;
+    prev_[timer] = NONE;
+    if (head != NONE)
+    {
+        prev_[head] = timer;
+    }
+    heads_[list] = timer;
+    list_[timer] = list;
+    if (list < OVERFLOW_LIST)
+    {
+        occupied_[list / SLOTS][(list % SLOTS) >> 6] |= 1ull << (list & 63);
+    }
+}
+
+void TimerWheel::unlink(std::uint32_t timer)
+{
+    const std::uint32_t list = list_[timer];
+    if (prev_[timer] != NONE)
+    {
+        next_[prev_[timer]] = next_[timer];
+    }
+    else
+    {
+        heads_[list] = next_[timer];
+    }
+    if (next_[timer] != NONE)
+    {
+        prev_[next_[timer]] = prev_[timer];
+    }
+    if (list < OVERFLOW_LIST && heads_[list] == NONE)
+    {
+        occupied_[list / SLOTS][(list % SLOTS) >> 6] &= ~(1ull << (list & 63));
+    }
+}
+
+void TimerWheel::place(std::uint32_t timer)
+{
+    link(listOf(deadline_[timer]), timer);
+}
+
+void TimerWheel::release(std::uint32_t timer)
+{
+    list_[timer] = NONE;
+    if (++generation_[timer] == 0)
+    {
+        generation_[timer] = 1;
+    }
+    callbacks_[timer] = Callback();
+    free_.push_back(timer);
+    --size_;
+}
+
+std::uint64_t TimerWheel::nextEvent() const
+{
+    // Principio de la siguiente casilla ocupada de cada nivel: vencimiento
+    // en el nivel 0, bajada de nivel en los demás
+    std::uint64_t best = NEVER;
+    for (int level = 0; level < LEVELS; ++level)
+    {
+        const int shift = level * SLOT_BITS;
+        const int digit = static_cast<int>((current_ >> shift) & (SLOTS - 1));
+        const int slot = nextBit(occupied_[level], digit + 1);
+        if (slot < SLOTS)
+        {
+            best = std::min(best, (current_ >> (shift + SLOT_BITS) << (shift + SLOT_BITS)) |
+                static_cast<std::uint64_t>(slot) << shift);
+        }
+    }
+    if (heads_[OVERFLOW_LIST] != NONE)
+    {
+        best = std::min(best, ((current_ >> (LEVELS * SLOT_BITS)) + 1) << (LEVELS * SLOT_BITS));
+    }
+    return best;
+}
+
+void TimerWheel::processTick()
+{
+    const std::uint64_t span = 1ull << (LEVELS * SLOT_BITS);
+    if (current_ % span == 0 && heads_[OVERFLOW_LIST] != NONE)
+    {
+        std::vector<std::uint32_t> far;
+        while (heads_[OVERFLOW_LIST] != NONE)
+        {
+            far.push_back(heads_[OVERFLOW_LIST]);
+            unlink(far.back());
+        }
+        for (std::size_t i = 0; i < far.size(); ++i)
+        {
+            place(far[i]);
+        }
+    }
+
+    // De arriba abajo: lo que baja del nivel 3 puede volver a bajar del 2 en este mismo paso
+    for (int level = LEVELS - 1; level >= 1; --level)
+    {
+        const int shift = level * SLOT_BITS;
+        if ((current_ & ((1ull << shift) - 1)) != 0)
+        {
+            continue;
+        }
+        const std::uint32_t slot = static_cast<std::uint32_t>(level * SLOTS + ((current_ >> shift) & (SLOTS - 1)));
+        while (heads_[slot] != NONE)
+        {
+            const std::uint32_t timer = heads_[slot];
+            unlink(timer);
+            place(timer);
+            ++stats_.cascaded;
+        }
+    }
+
+    const std::uint32_t slot = static_cast<std::uint32_t>(current_ & (SLOTS - 1));
+    while (heads_[slot] != NONE)
+    {
+        const std::uint32_t timer = heads_[slot];
+        unlink(timer);
+        link(DUE_LIST, timer);
+    }
+    fireDue();
+}
+
+void TimerWheel::fireDue()
+{
+    while (heads_[DUE_LIST] != NONE)
+    {
+        const std::uint32_t timer = heads_[DUE_LIST];
+        unlink(timer);
+        list_[timer] = FIRING;
+
+        // El callback sale de la columna: puede añadir temporizadores (y
+        // hacer crecer callbacks_) o cancelarse a sí mismo mientras se ejecuta
+        Callback callback = std::move(callbacks_[timer]);
+        ++stats_.expired;
+        try
+        {
+            callback();
+        }
+        catch (...)
+        {
+            release(timer);
+            throw;
+        }
+
+        if (list_[timer] == FIRING && period_[timer] > 0)
+        {
+            callbacks_[timer] = std::move(callback);
+            deadline_[timer] += period_[timer];
+            place(timer);
+        }
+        else
+        {
+            release(timer);
+        }
+    }
+}
+
+TimerService::TimerService(double resolution)
+    : wheel_(resolution), start_(Clock::now()), sleeping_until_(std::numeric_limits<double>::infinity()),
+      stop_(false), thread_(&TimerService::loop, this)
+{
+}
+
+TimerService::~TimerService()
+{
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+}
+
+TimerId TimerService::after(double delay, const TimerWheel::Callback& callback)
+{
+    return schedule(delay, 0.0, callback);
+}
+
+TimerId TimerService::every(double period, const TimerWheel::Callback& callback, double delay)
+{
+    if (!(period > 0.0))
+    {
+        throw std::invalid_argument("el periodo de un temporizador debe ser positivo");
+    }
+    return schedule(delay < 0.0 ? period : delay, period, callback);
+}
+
+bool TimerService::cancel(TimerId id)
+{
+    // Cancelar no adelanta nada: el hilo puede despertar para un vencimiento
+    // que ya no existe y volver a dormir
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    return wheel_.cancel(id);
+}
+
+std::size_t TimerService::size() const
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    return wheel_.size();
+}
+
+TimerStats TimerService::stats() const
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    return wheel_.stats();
+}
+
+double TimerService::elapsed() const
+{
+    return std::chrono::duration<double>(Clock::now() - start_).count();
+}
+
+TimerId TimerService::schedule(double delay, double period, const TimerWheel::Callback& callback)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    const double deadline = elapsed() + std::max(delay, 0.0);
+    const TimerId id = wheel_.add(deadline, period, callback);
+
+    // Solo se despierta al hilo si este vencimiento es anterior al que espera
+    if (deadline < sleeping_until_)
+    {
+        wake_.notify_one();
+    }
+    return id;
+}
+
+void TimerService::loop()
+{
+    std::unique_lock<std::recursive_mutex> lock(mutex_);
+    while (!stop_)
+    {
+        const double next = wheel_.nextExpiry();
+        sleeping_until_ = next;
+        if (std::isinf(next))
+        {
+            wake_.wait(lock);
+        }
+        else if (next > elapsed())
+        {
+            wake_.wait_until(lock, start_ + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(next)));
+        }
+
+        // Despierto: lo que se añada ahora se verá al calcular la siguiente espera
+        sleeping_until_ = -std::numeric_limits<double>::infinity();
+        if (stop_)
+        {
+            break;
+        }
+        ++wheel_.stats().wakeups;
+        wheel_.advance(elapsed());
+    }
+}
+
+} // namespace turtle_unida
@@ -0,0 +1,320 @@
+#include "turtle_unida/trajectory.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace turtle_unida
+{
+
+namespace
+{
+
+const double PI = 3.14159265358979323846;
+
+// Tramo polinómico de un spline: x(u), y(u) con u en [0, 1]
+struct SplineSegment
+{
+    double cx[6];
+    double cy[6];
+};
+
+// Evalúa la primera y segunda derivada de un polinomio de grado 5 en u
+void polyDerivatives(const double c[6], double u, double& d1, double& d2)
+{
+    d1 = c[1] + u * (2.0 * c[2] + u * (3.0 * c[3] + u * (4.0 * c[4] + u * 5.0 * c[5])));
+    d2 = 2.0 * c[2] + u * (6.0 * c[3] + u * (12.0 * c[4] + u * 20.0 * c[5]));
+}
+
+// Spline que pasa por los puntos dados, `segment_time` segundos por tramo.
+// Las tangentes se estiman por diferencias centradas (Catmull-Rom); el
+// quíntico además fija la aceleración en cada punto para que la velocidad
+// angular sea continua.
+Trajectory makeSpline(const std::vector<double>& points, double segment_time, bool quintic, double dt)
+{
+    if (points.size() < 4 || points.size() % 2 != 0)
+    {
+        throw std::invalid_argument("el spline necesita al menos dos puntos (x, y)");
+    }
+    if (segment_time <= 0.0)
+    {
+        throw std::invalid_argument("la duración de cada tramo debe ser positiva");
+    }
+
+    const std::size_t n = points.size() / 2;
+    std::vector<double> vel(points.size());
+    std::vector<double> acc(points.size(), 0.0);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const std::size_t prev = i > 0 ? i - 1 : i;
+        const std::size_t next = i + 1 < n ? i + 1 : i;
+        for (std::size_t k = 0; k < 2; ++k)
+        {
+            vel[2 * i + k] = (points[2 * next + k] - points[2 * prev + k]) / (next - prev);
+            if (quintic && prev != i && next != i)
+            {
+                acc[2 * i + k] = points[2 * next + k] - 2.0 * points[2 * i + k] + points[2 * prev + k];
+            }
+        }
+    }
+
+    std::vector<SplineSegment> segments(n - 1);
+    for (std::size_t i = 0; i + 1 < n; ++i)
+    {
+        for (std::size_t k = 0; k < 2; ++k)
+        {
+            double* c = k == 0 ? segments[i].cx : segments[i].cy;
+            const double p0 = points[2 * i + k];
+            const double p1 = points[2 * (i + 1) + k];
+            const double v0 = vel[2 * i + k];
+            const double v1 = vel[2 * (i + 1) + k];
+            const double a0 = acc[2 * i + k];
+            const double a1 = acc[2 * (i + 1) + k];
+            c[0] = p0;
+            c[1] = v0;
+            if (quintic)
+            {
+                c[2] = 0.5 * a0;
+                c[3] = 10.0 * (p1 - p0) - 6.0 * v0 - 4.0 * v1 - 0.5 * (3.0 * a0 - a1);
+                c[4] = -15.0 * (p1 - p0) + 8.0 * v0 + 7.0 * v1 + 0.5 * (3.0 * a0 - 2.0 * a1);
+                c[5] = 6.0 * (p1 - p0) - 3.0 * v0 - 3.0 * v1 - 0.5 * (a0 - a1);
+            }
+            else
+            {
+                c[2] = 3.0 * (p1 - p0) - 2.0 * v0 - v1;
+                c[3] = 2.0 * (p0 - p1) + v0 + v1;
+                c[4] = 0.0;
+                c[5] = 0.0;
+            }
+        }
+    }
+
+    const double inv_time = 1.0 / segment_time;
+    return Trajectory::fromPath([&segments, inv_time](double t) {
+        std::size_t i = static_cast<std::size_t>(t * inv_time);
+        if (i >= segments.size())
+        {
+            i = segments.size() - 1;
+        }
+        const double u = t * inv_time - i;
+
+        PathDerivatives d;
+        polyDerivatives(segments[i].cx, u, d.dx, d.ddx);
+        polyDerivatives(segments[i].cy, u, d.dy, d.ddy);
+        d.dx *= inv_time;
+        d.dy *= inv_time;
+        d.ddx *= inv_time * inv_time;
+        d.ddy *= inv_time * inv_time;
+        return d;
+    }, segment_time * segments.size(), dt);
+}
+
+} // namespace
+
+Trajectory::Trajectory()
+    : dt_(0.0), inv_dt_(0.0), duration_(0.0), periodic_(false)
+{
+}
+
+void Trajectory::resize(double duration, double dt)
+{
+    if (dt <= 0.0 || duration <= 0.0)
+    {
+        throw std::invalid_argument("la duración y el paso de la tabla deben ser positivos");
+    }
+    dt_ = dt;
+    inv_dt_ = 1.0 / dt;
+    duration_ = duration;
+    // Una muestra extra al final para poder interpolar hasta t = duration
+    table_.assign(2 * (static_cast<std::size_t>(std::ceil(duration * inv_dt_)) + 1), 0.0);
+}
+
+Trajectory Trajectory::constant(double linear, double angular, double duration, double dt)
+{
+    Trajectory trajectory;
+    trajectory.resize(duration, dt);
+    for (std::size_t i = 0; i < trajectory.table_.size(); i += 2)
+    {
+        trajectory.table_[i] = linear;
+        trajectory.table_[i + 1] = angular;
+    }
+    return trajectory;
+}
+
+Trajectory Trajectory::fromPath(const PathFunction& path, double duration, double dt)
+{
+    Trajectory trajectory;
+    trajectory.resize(duration, dt);
+    for (std::size_t i = 0; i < trajectory.size(); ++i)
+    {
+        const double t = std::min(i * dt, duration);
+        const PathDerivatives d = path(t);
+        const double speed2 = d.dx * d.dx + d.dy * d.dy;
+        trajectory.table_[2 * i] = std::sqrt(speed2);
+        trajectory.table_[2 * i + 1] = speed2 > 1e-12 ? (d.dx * d.ddy - d.dy * d.ddx) / speed2 : 0.0;
+    }
+    return trajectory;
+}
+
+void Trajectory::append(const Trajectory& other)
+{
+    if (table_.empty())
+    {
+        *this = other;
+        return;
+    }
+    if (other.dt_ != dt_)
+    {
+        throw std::invalid_argument("las trayectorias encadenadas deben usar el mismo paso de tabla");
+    }
+
+    // Se vuelve a muestrear el conjunto para que las muestras sigan alineadas con dt
+    const Trajectory first = *this;
+    resize(first.duration_ + other.duration_, dt_);
+    for (std::size_t i = 0; i < size(); ++i)
+    {
+        const double t = i * dt_;
+        const Twist twist = t < first.duration_ ? first.sample(t) : other.sample(t - first.duration_);
+        table_[2 * i] = twist.linear.x;
+        table_[2 * i + 1] = twist.angular.z;
+    }
+}
+
+Twist Trajectory::sample(double t) const
+{
+    if (table_.empty() || t < 0.0)
+    {
+        return Twist();
+    }
+    if (t >= duration_)
+    {
+        if (!periodic_)
+        {
+            return Twist();
+        }
+        t -= duration_ * std::floor(t / duration_);
+    }
+
+    const double pos = t * inv_dt_;
+    std::size_t i = static_cast<std::size_t>(pos);
+    double frac = pos - i;
+    if (2 * i + 3 >= table_.size())
+    {
+        i = size() - 2;
+        frac = 1.0;
+    }
+
+    const double* s = &table_[2 * i];
+    return makeTwist(s[0] + frac * (s[2] - s[0]), s[1] + frac * (s[3] - s[1]));
+}
+
+TrajectoryParams::TrajectoryParams()
+    : type("circle"),
+      linear(2.0),
+      angular(1.5),
+      size(2.0),
+      period(10.0),
+      growth(0.1),
+      duration(20.0),
+      table_dt(0.005)
+{
+}
+
+bool operator==(const TrajectoryParams& a, const TrajectoryParams& b)
+{
+    return a.type == b.type && a.linear == b.linear && a.angular == b.angular && a.size == b.size &&
+        a.period == b.period && a.growth == b.growth && a.duration == b.duration && a.points == b.points &&
+        a.segments == b.segments && a.table_dt == b.table_dt;
+}
+
+bool operator!=(const TrajectoryParams& a, const TrajectoryParams& b)
+{
+    return !(a == b);
+}
+
+Trajectory makeTrajectory(const TrajectoryParams& params)
+{
+    const double dt = params.table_dt;
+
+    if (params.type == "circle")
+    {
+        Trajectory trajectory = Trajectory::constant(params.linear, params.angular, dt, dt);
+        trajectory.setPeriodic(true);
+        return trajectory;
+    }
+    if (params.type == "lemniscate")
+    {
+        // Lemniscata de Gerono: x = a sin(s), y = a sin(s) cos(s), s = 2 pi t / T
+        if (params.period <= 0.0)
+        {
+            throw std::invalid_argument("el periodo de la lemniscata debe ser positivo");
+        }
+        const double a = params.size;
+        const double c = 2.0 * PI / params.period;
+        Trajectory trajectory = Trajectory::fromPath([a, c](double t) {
+            const double s = c * t;
+            PathDerivatives d;
+            d.dx = a * c * std::cos(s);
+            d.dy = a * c * std::cos(2.0 * s);
+            d.ddx = -a * c * c * std::sin(s);
+            d.ddy = -2.0 * a * c * c * std::sin(2.0 * s);
+            return d;
+        }, params.period, dt);
+        trajectory.setPeriodic(true);
+        return trajectory;
+    }
+    if (params.type == "spiral")
+    {
+        // Velocidad lineal constante con radio r(t) = size + growth * t
+        if (params.size <= 0.0)
+        {
+            throw std::invalid_argument("el radio inicial de la espiral debe ser positivo");
+        }
+        // Con growth negativo el radio no puede llegar a cero: la curvatura sería infinita
+        if (params.size + params.growth * params.duration <= 0.0)
+        {
+            throw std::invalid_argument("la espiral se cierra en un punto antes de terminar: " +
+                std::to_string(params.size) + " + " + std::to_string(params.growth) + " * " +
+                std::to_string(params.duration) + " <= 0");
+        }
+        const double v = params.linear;
+        const double r0 = params.size;
+        const double k = params.growth;
+        return Trajectory::fromPath([v, r0, k](double t) {
+            // Curva con |p'| = v y curvatura 1 / r(t): basta con el ángulo de la tangente
+            const double r = r0 + k * t;
+            const double heading = std::abs(k) > 1e-12 ? v / k * std::log(r / r0) : v / r0 * t;
+            const double w = v / r;
+            PathDerivatives d;
+            d.dx = v * std::cos(heading);
+            d.dy = v * std::sin(heading);
+            d.ddx = -w * d.dy;
+            d.ddy = w * d.dx;
+            return d;
+        }, params.duration, dt);
+    }
+    if (params.type == "cubic" || params.type == "quintic")
+    {
+        return makeSpline(params.points, params.duration, params.type == "quintic", dt);
+    }
+    if (params.type == "piecewise")
+    {
+        // Tramos de velocidad constante (duración, lineal, angular) que se repiten
+        if (params.segments.empty() || params.segments.size() % 3 != 0)
+        {
+            throw std::invalid_argument("los tramos se indican como ternas (duración, lineal, angular)");
+        }
+        Trajectory trajectory;
+        for (std::size_t i = 0; i < params.segments.size(); i += 3)
+        {
+            trajectory.append(Trajectory::constant(params.segments[i + 1], params.segments[i + 2],
+                params.segments[i], dt));
+        }
+        trajectory.setPeriodic(true);
+        return trajectory;
+    }
+
+    throw std::invalid_argument("tipo de trayectoria desconocido: " + params.type);
+}
+
+} // namespace turtle_unida
@@ -0,0 +1,55 @@
+#include "turtle_unida/transport.h"
+
+namespace turtle_unida
+{
+
+NullTransport::NullTransport()
+    : channels_(0), published_(0)
+{
+}
+
+Transport::Channel NullTransport::advertise(const std::string& /*topic*/)
+{
+    return channels_++;
+}
+
+void NullTransport::publish(Channel /*channel*/, const Twist& /*twist*/)
+{
+    ++published_;
+}
+
+void NullTransport::subscribe(const std::string& /*topic*/, const PoseCallback& /*callback*/)
+{
+}
+
+Transport::Channel MemoryTransport::advertise(const std::string& topic)
+{
+    topics_.push_back(topic);
+    last_.push_back(Twist());
+    counts_.push_back(0);
+    return topics_.size() - 1;
+}
+
+void MemoryTransport::publish(Channel channel, const Twist& twist)
+{
+    last_[channel] = twist;
+    ++counts_[channel];
+}
+
+void MemoryTransport::subscribe(const std::string& topic, const PoseCallback& callback)
+{
+    subscribers_.push_back(std::make_pair(topic, callback));
+}
+
+void MemoryTransport::deliver(const std::string& topic, const Pose& pose) const
+{
+    for (std::size_t i = 0; i < subscribers_.size(); ++i)
+    {
+        if (subscribers_[i].first == topic)
+        {
+            subscribers_[i].second(pose);
+        }
+    }
+}
+
+} // namespace turtle_unida
@@ -0,0 +1,87 @@
+#include "turtle_unida/twist_pool.h"
+
+#include <cstring>
+
+namespace turtle_unida
+{
+
+const std::uint32_t TwistPool::MESSAGE_SIZE;
+
+TwistPoolStats::TwistPoolStats()
+    : written(0), patched(0), grown(0)
+{
+}
+
+TwistPool::TwistPool(std::size_t buffers)
+    : next_(0), last_(0)
+{
+    slots_.reserve(buffers);
+    for (std::size_t i = 0; i < buffers; ++i)
+    {
+        addSlot();
+    }
+}
+
+void TwistPool::addSlot()
+{
+    // Mismo formato que ros::serialization::serializeMessage(): longitud de
+    // 4 bytes y después el mensaje, con todos los campos a 0
+    const std::uint32_t total = 4 + MESSAGE_SIZE;
+    Slot slot;
+    slot.message.buf.reset(new std::uint8_t[total]);
+    slot.message.num_bytes = total;
+    slot.message.message_start = slot.message.buf.get() + 4;
+    std::memcpy(slot.message.buf.get(), &MESSAGE_SIZE, 4);
+    std::memset(slot.message.message_start, 0, MESSAGE_SIZE);
+    std::memset(slot.fields, 0, sizeof(slot.fields));
+    slots_.push_back(slot);
+}
+
+const ros::SerializedMessage& TwistPool::write(const Twist& twist)
+{
+    // Siguiente buffer que roscpp ya no usa (solo queda nuestra referencia)
+    const std::size_t count = slots_.size();
+    std::size_t index = next_;
+    std::size_t tried = 0;
+    while (tried < count && slots_[index].message.buf.use_count() != 1)
+    {
+        index = index + 1 == count ? 0 : index + 1;
+        ++tried;
+    }
+    if (tried == count)
+    {
+        index = count;
+        addSlot();
+        ++stats_.grown;
+    }
+    next_ = index + 1 == slots_.size() ? 0 : index + 1;
+    last_ = index;
+
+    patch(slots_[index], twist);
+    ++stats_.written;
+    return slots_[index].message;
+}
+
+void TwistPool::rewriteLast(const Twist& twist)
+{
+    patch(slots_[last_], twist);
+}
+
+void TwistPool::patch(Slot& slot, const Twist& twist)
+{
+    // Orden de geometry_msgs/Twist: linear.x, .y, .z, angular.x, .y, .z.
+    // ROS serializa en little-endian, igual que la memoria en x86 y ARM.
+    const double fields[6] = {
+        twist.linear.x, twist.linear.y, twist.linear.z, twist.angular.x, twist.angular.y, twist.angular.z};
+    for (int i = 0; i < 6; ++i)
+    {
+        if (std::memcmp(&slot.fields[i], &fields[i], sizeof(double)) != 0)
+        {
+            slot.fields[i] = fields[i];
+            std::memcpy(slot.message.message_start + i * sizeof(double), &fields[i], sizeof(double));
+            ++stats_.patched;
+        }
+    }
+}
+
+} // namespace turtle_unida
@@ -0,0 +1,270 @@
+#include "turtle_unida/zygote.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#include <limits.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace turtle_unida
+{
+
+namespace
+{
+
+typedef std::chrono::steady_clock Clock;
+
+// Debe coincidir con PROTOCOL en src/zygote.py
+const char PROTOCOL[] = "turtle_unida-zygote 1";
+
+double secondsSince(Clock::time_point begin)
+{
+    return std::chrono::duration<double>(Clock::now() - begin).count();
+}
+
+std::runtime_error systemError(const std::string& what)
+{
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+// Cierra el descriptor al salir del ámbito, también con excepciones
+struct FdGuard
+{
+    explicit FdGuard(int fd) : fd(fd) {}
+    ~FdGuard()
+    {
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+    }
+    int fd;
+};
+
+void appendField(std::string& body, const std::string& field)
+{
+    body += field;
+    body += '\0';
+}
+
+// Petición con la longitud delante y stdin, stdout y stderr adjuntos
+void sendRequest(int fd, const std::string& body)
+{
+    const std::uint32_t length = static_cast<std::uint32_t>(body.size());
+    std::string message(4, '\0');
+    message[0] = static_cast<char>(length >> 24);
+    message[1] = static_cast<char>(length >> 16);
+    message[2] = static_cast<char>(length >> 8);
+    message[3] = static_cast<char>(length);
+    message += body;
+
+    const int stdio[3] = {0, 1, 2};
+    char control[CMSG_SPACE(sizeof(stdio))];
+    std::memset(control, 0, sizeof(control));
+    struct iovec iov;
+    iov.iov_base = &message[0];
+    iov.iov_len = message.size();
+    struct msghdr header;
+    std::memset(&header, 0, sizeof(header));
+    header.msg_iov = &iov;
+    header.msg_iovlen = 1;
+    header.msg_control = control;
+    header.msg_controllen = sizeof(control);
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&header);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(stdio));
+    std::memcpy(CMSG_DATA(cmsg), stdio, sizeof(stdio));
+
+    ssize_t sent;
+    do
+    {
+        sent = ::sendmsg(fd, &header, MSG_NOSIGNAL);
+    } while (sent < 0 && errno == EINTR);
+    if (sent < 0)
+    {
+        throw systemError("sendmsg(zigoto)");
+    }
+    // Los descriptores ya han ido con el primer fragmento
+    std::size_t done = static_cast<std::size_t>(sent);
+    while (done < message.size())
+    {
+        sent = ::send(fd, message.data() + done, message.size() - done, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (sent <= 0)
+        {
+            throw systemError("send(zigoto)");
+        }
+        done += static_cast<std::size_t>(sent);
+    }
+}
+
+// Una línea de la respuesta sin el salto de línea; vacía si se ha cerrado
+std::string readLine(int fd, std::string& pending)
+{
+    for (;;)
+    {
+        const std::size_t newline = pending.find('\n');
+        if (newline != std::string::npos)
+        {
+            const std::string line = pending.substr(0, newline);
+            pending.erase(0, newline + 1);
+            return line;
+        }
+        char buffer[256];
+        const ssize_t received = ::read(fd, buffer, sizeof(buffer));
+        if (received < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (received < 0)
+        {
+            throw systemError("read(zigoto)");
+        }
+        if (received == 0)
+        {
+            return std::string();
+        }
+        pending.append(buffer, static_cast<std::size_t>(received));
+    }
+}
+
+// Valor de una respuesta "clave N"; lanza con el mensaje del zigoto si es un error
+int replyValue(const std::string& line, const char* key)
+{
+    const std::size_t length = std::strlen(key);
+    if (line.compare(0, 6, "error ") == 0)
+    {
+        throw std::runtime_error("el zigoto ha rechazado la petición: " + line.substr(6));
+    }
+    if (line.size() <= length + 1 || line.compare(0, length, key) != 0 || line[length] != ' ')
+    {
+        throw std::runtime_error("respuesta inesperada del zigoto: [" + line + "]");
+    }
+    return std::atoi(line.c_str() + length + 1);
+}
+
+} // namespace
+
+std::string defaultZygoteSocket()
+{
+    const char* runtime = std::getenv("XDG_RUNTIME_DIR");
+    if (runtime && *runtime)
+    {
+        return std::string(runtime) + "/turtle_unida-zygote";
+    }
+    // Directorio propio con permisos 0700 que crea zygote.py: en /tmp
+    // cualquiera podría ocupar antes un nombre fijo
+    return "/tmp/turtle_unida-" + std::to_string(::getuid()) + "/zygote";
+}
+
+int connectZygote(const std::string& socket)
+{
+    struct sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    if (socket.size() >= sizeof(address.sun_path))
+    {
+        return -1;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, socket.c_str(), socket.size());
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    if (::connect(fd, reinterpret_cast<const struct sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        ::close(fd);
+        return -1;
+    }
+
+    // Antes de mandarle el entorno y la entrada/salida, y de aceptar un pid al
+    // que reenviar señales, el zigoto tiene que ser del mismo usuario
+    FdGuard guard(fd);
+    uid_t uid;
+#ifdef SO_PEERCRED
+    struct ucred credentials;
+    socklen_t length = sizeof(credentials);
+    if (::getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &credentials, &length) != 0)
+    {
+        throw systemError("getsockopt(SO_PEERCRED) en " + socket);
+    }
+    uid = credentials.uid;
+#else
+    gid_t gid;
+    if (::getpeereid(fd, &uid, &gid) != 0)
+    {
+        throw systemError("getpeereid en " + socket);
+    }
+#endif
+    if (uid != ::getuid())
+    {
+        throw std::runtime_error("el zigoto de " + socket + " es del usuario " + std::to_string(uid) +
+            ", no del que lanza (" + std::to_string(::getuid()) + ")");
+    }
+    guard.fd = -1;
+    return fd;
+}
+
+int launchInZygote(int fd, const std::string& argv0, const std::string& script, const std::vector<std::string>& args,
+    LaunchTiming& timing)
+{
+    FdGuard guard(fd);
+    timing.zygote = true;
+    const std::string path = scriptPath(argv0, script, timing);
+
+    Clock::time_point begin = Clock::now();
+    char cwd[PATH_MAX];
+    if (!::getcwd(cwd, sizeof(cwd)))
+    {
+        throw systemError("getcwd");
+    }
+    std::string body;
+    appendField(body, PROTOCOL);
+    appendField(body, cwd);
+    appendField(body, path);
+    appendField(body, std::to_string(args.size()));
+    for (std::size_t i = 0; i < args.size(); ++i)
+    {
+        appendField(body, args[i]);
+    }
+    for (char** variable = environ; *variable; ++variable)
+    {
+        appendField(body, *variable);
+    }
+    body.resize(body.size() - 1);
+    sendRequest(fd, body);
+
+    std::string pending;
+    timing.pid = replyValue(readLine(fd, pending), "pid");
+    timing.spawn = secondsSince(begin);
+
+    begin = Clock::now();
+    std::string line;
+    {
+        SignalForwarder forwarder(timing.pid, false);
+        line = readLine(fd, pending);
+    }
+    if (line.empty())
+    {
+        throw std::runtime_error("el zigoto se ha cerrado sin informar del final del hijo");
+    }
+    timing.exit_code = replyValue(line, "exit");
+    timing.run = secondsSince(begin);
+    return timing.exit_code;
+}
+
+} // namespace turtle_unida
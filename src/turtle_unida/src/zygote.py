@@ -0,0 +1,297 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+# Zigoto de los nodos en Python: un proceso residente que ya ha arrancado el
+# intérprete e importado rospy y geometry_msgs, y que por cada petición del
+# lanzador (launcher --zygote) hace fork y ejecuta el script en el hijo. El
+# nodo se ahorra el arranque de Python y los imports: solo paga el fork.
+#
+#   rosrun turtle_unida src/zygote.py [--socket RUTA] [--preload mod1,mod2]
+#
+# Protocolo (socket UNIX de tipo stream, una petición por conexión):
+#   lanzador -> zigoto: longitud (4 bytes, big endian) y los campos separados
+#     por '\0': versión, directorio de trabajo, script, número de argumentos,
+#     argumentos y el entorno (CLAVE=valor). Con el primer byte van stdin,
+#     stdout y stderr del lanzador (SCM_RIGHTS).
+#   zigoto -> lanzador: "pid N\n" al arrancar el hijo y "exit N\n" cuando
+#     termina (128 + señal si lo mató una señal), o "error mensaje\n".
+# Si el lanzador se cierra antes que el hijo, el zigoto le envía SIGTERM.
+import array
+import builtins
+import gc
+import importlib
+import os
+import select
+import signal
+import socket
+import stat
+import struct
+import sys
+import traceback
+import types
+
+PROTOCOL = 'turtle_unida-zygote 1'
+PRELOAD = ['rospy', 'geometry_msgs.msg']
+MAX_REQUEST = 1 << 20
+STDIO = 3
+
+
+def default_socket():
+    # La misma ruta que defaultZygoteSocket() en include/turtle_unida/zygote.h
+    runtime = os.environ.get('XDG_RUNTIME_DIR')
+    if runtime:
+        return os.path.join(runtime, 'turtle_unida-zygote')
+    return '/tmp/turtle_unida-%d/zygote' % os.getuid()
+
+
+def private_directory(path):
+    # En /tmp el socket va en un directorio propio con permisos 0700; si ya
+    # existe tiene que ser nuestro y no accesible para nadie más
+    try:
+        os.mkdir(path, 0o700)
+    except FileExistsError:
+        pass
+    info = os.lstat(path)
+    if not stat.S_ISDIR(info.st_mode) or info.st_uid != os.getuid() or info.st_mode & 0o077:
+        sys.exit('%s no es un directorio privado del usuario %d' % (path, os.getuid()))
+
+
+def same_user(conn):
+    # Solo se atiende a lanzadores del mismo usuario que el zigoto
+    creds = conn.getsockopt(socket.SOL_SOCKET, socket.SO_PEERCRED, struct.calcsize('3i'))
+    return struct.unpack('3i', creds)[1] == os.getuid()
+
+
+def receive_request(conn):
+    conn.settimeout(1.0)
+    data, ancillary, _, _ = conn.recvmsg(4, socket.CMSG_SPACE(STDIO * array.array('i').itemsize))
+    fds = array.array('i')
+    for level, kind, payload in ancillary:
+        if level == socket.SOL_SOCKET and kind == socket.SCM_RIGHTS:
+            fds.frombytes(payload[:len(payload) - len(payload) % fds.itemsize])
+    fds = list(fds)
+    try:
+        while len(data) < 4:
+            chunk = conn.recv(4 - len(data))
+            if not chunk:
+                raise ValueError('petición incompleta')
+            data += chunk
+        length = struct.unpack('>I', data)[0]
+        if length > MAX_REQUEST:
+            raise ValueError('petición demasiado grande')
+        body = b''
+        while len(body) < length:
+            chunk = conn.recv(length - len(body))
+            if not chunk:
+                raise ValueError('petición incompleta')
+            body += chunk
+        fields = [field.decode('utf-8', 'surrogateescape') for field in body.split(b'\0')]
+        if len(fields) < 4 or fields[0] != PROTOCOL or len(fds) != STDIO:
+            raise ValueError('petición no válida')
+        nargs = int(fields[3])
+        args = fields[4:4 + nargs]
+        env = dict(item.split('=', 1) for item in fields[4 + nargs:] if '=' in item)
+        return fields[1], fields[2], args, env, fds
+    except Exception:
+        for fd in fds:
+            os.close(fd)
+        raise
+
+
+def run_child(cwd, script, args, env, fds):
+    # Solo se llega aquí en el hijo, que no vuelve nunca
+    code = 1
+    try:
+        for target, fd in enumerate(fds):
+            os.dup2(fd, target)
+        for fd in fds:
+            if fd > 2:
+                os.close(fd)
+        sys.stdin = os.fdopen(0, 'r', closefd=False)
+        sys.stdout = os.fdopen(1, 'w', buffering=1 if os.isatty(1) else -1, closefd=False)
+        sys.stderr = os.fdopen(2, 'w', buffering=1, closefd=False)
+
+        os.chdir(cwd)
+        os.environ.clear()
+        os.environ.update(env)
+        sys.argv = [script] + args
+        sys.path[0] = os.path.dirname(os.path.abspath(script))
+        # Un __main__ nuevo y exec directo: runpy.run_path tarda ~20 ms más
+        # en cada hijo por la maquinaria de importación que pone en marcha
+        main = types.ModuleType('__main__')
+        main.__file__ = script
+        main.__builtins__ = builtins
+        sys.modules['__main__'] = main
+        with open(script, 'rb') as source:
+            program = compile(source.read(), script, 'exec')
+        exec(program, main.__dict__)
+        code = 0
+    except SystemExit as e:
+        if e.code is None:
+            code = 0
+        elif isinstance(e.code, int):
+            code = e.code
+        else:
+            sys.stderr.write('%s\n' % e.code)
+    except KeyboardInterrupt:
+        # Como Python: muere por SIGINT para que el lanzador vea 130
+        sys.stdout.flush()
+        signal.signal(signal.SIGINT, signal.SIG_DFL)
+        os.kill(os.getpid(), signal.SIGINT)
+    except BaseException:
+        traceback.print_exc()
+    finally:
+        try:
+            sys.stdout.flush()
+            sys.stderr.flush()
+        finally:
+            os._exit(code & 0xff)
+
+
+def exit_code(status):
+    if os.WIFSIGNALED(status):
+        return 128 + os.WTERMSIG(status)
+    return os.WEXITSTATUS(status)
+
+
+def send(conn, text):
+    try:
+        conn.sendall(text.encode('utf-8'))
+        return True
+    except (OSError, socket.timeout):
+        return False
+
+
+def serve(path):
+    if not os.environ.get('XDG_RUNTIME_DIR') and path == default_socket():
+        private_directory(os.path.dirname(path))
+
+    # Un zigoto anterior que no borró el socket: se sustituye si no responde
+    if os.path.exists(path):
+        probe = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        try:
+            probe.connect(path)
+            sys.exit('Ya hay un zigoto escuchando en %s' % path)
+        except socket.error:
+            os.unlink(path)
+        finally:
+            probe.close()
+
+    listener = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    old_umask = os.umask(0o077)
+    listener.bind(path)
+    os.umask(old_umask)
+    listener.listen(64)
+
+    # SIGCHLD despierta el select a través de la tubería
+    wake_read, wake_write = os.pipe()
+    os.set_blocking(wake_read, False)
+    os.set_blocking(wake_write, False)
+    signal.set_wakeup_fd(wake_write)
+    signal.signal(signal.SIGCHLD, lambda signum, frame: None)
+    signal.signal(signal.SIGTERM, lambda signum, frame: sys.exit(0))
+
+    children = {}  # pid -> conexión con su lanzador
+    pids = {}      # fd de la conexión -> pid
+    try:
+        while True:
+            readable = select.select([listener, wake_read] + [c for c in children.values() if c], [], [])[0]
+            for ready in readable:
+                if ready is wake_read:
+                    try:
+                        while os.read(wake_read, 64):
+                            pass
+                    except OSError:
+                        pass
+                    while children:
+                        try:
+                            pid, status = os.waitpid(-1, os.WNOHANG)
+                        except ChildProcessError:
+                            break
+                        if pid == 0:
+                            break
+                        conn = children.pop(pid, None)
+                        if conn:
+                            pids.pop(conn.fileno(), None)
+                            send(conn, 'exit %d\n' % exit_code(status))
+                            conn.close()
+                elif ready is listener:
+                    conn, _ = listener.accept()
+                    if not same_user(conn):
+                        send(conn, 'error el zigoto es de otro usuario\n')
+                        conn.close()
+                        continue
+                    try:
+                        cwd, script, args, env, fds = receive_request(conn)
+                    except Exception as e:
+                        send(conn, 'error %s\n' % e)
+                        conn.close()
+                        continue
+                    sys.stdout.flush()
+                    sys.stderr.flush()
+                    pid = os.fork()
+                    if pid == 0:
+                        signal.set_wakeup_fd(-1)
+                        for signum in (signal.SIGCHLD, signal.SIGTERM):
+                            signal.signal(signum, signal.SIG_DFL)
+                        signal.signal(signal.SIGINT, signal.default_int_handler)
+                        for fd in [listener.fileno(), conn.fileno(), wake_read, wake_write] + list(pids):
+                            os.close(fd)
+                        run_child(cwd, script, args, env, fds)
+                    for fd in fds:
+                        os.close(fd)
+                    conn.settimeout(None)
+                    if send(conn, 'pid %d\n' % pid):
+                        children[pid] = conn
+                        pids[conn.fileno()] = pid
+                    else:
+                        os.kill(pid, signal.SIGTERM)
+                        children[pid] = None
+                        conn.close()
+                else:
+                    # El lanzador solo escribe la petición: si la conexión
+                    # se puede leer es que se ha cerrado
+                    pid = pids.pop(ready.fileno(), None)
+                    if pid is None:
+                        continue  # ya cerrada al recoger a su hijo
+                    children[pid] = None
+                    ready.close()
+                    try:
+                        os.kill(pid, signal.SIGTERM)
+                    except OSError:
+                        pass
+    finally:
+        listener.close()
+        os.unlink(path)
+
+
+def main():
+    path = default_socket()
+    preload = PRELOAD
+    argv = sys.argv[1:]
+    while argv:
+        option = argv.pop(0)
+        if option == '--socket' and argv:
+            path = argv.pop(0)
+        elif option == '--preload' and argv:
+            preload = [name for name in argv.pop(0).split(',') if name]
+        else:
+            sys.exit('uso: zygote.py [--socket RUTA] [--preload mod1,mod2]')
+
+    for name in preload:
+        try:
+            importlib.import_module(name)
+        except ImportError as e:
+            sys.stderr.write('Aviso: no se ha podido precargar %s: %s\n' % (name, e))
+
+    # Lo importado no se vuelve a recorrer en las recolecciones, así las
+    # páginas siguen compartidas con los hijos tras el fork
+    gc.collect()
+    if hasattr(gc, 'freeze'):
+        gc.freeze()
+
+    sys.stderr.write('Zigoto escuchando en %s\n' % path)
+    serve(path)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,238 @@
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include "turtle_unida/command_log.h"
+#include "turtle_unida/transport.h"
+
+using namespace turtle_unida;
+
+namespace
+{
+
+std::string tempLog(const std::string& name)
+{
+    return ::testing::TempDir() + "turtle_unida_test_" + std::to_string(::getpid()) + "_" + name + ".log";
+}
+
+void copyFile(const std::string& from, const std::string& to)
+{
+    std::ifstream in(from.c_str(), std::ios::binary);
+    std::ofstream out(to.c_str(), std::ios::binary);
+    out << in.rdbuf();
+}
+
+// Comprueba que seek(t) devuelve el primer registro con time >= t
+void expectSeek(const CommandLogReader& reader, std::uint64_t time)
+{
+    const std::uint64_t found = reader.seek(time);
+    if (found < reader.size())
+    {
+        EXPECT_GE(reader.record(found).time, time) << "t=" << time;
+    }
+    if (found > 0)
+    {
+        EXPECT_LT(reader.record(found - 1).time, time) << "t=" << time;
+    }
+}
+
+// Varios bloques del índice y uno incompleto al final
+const std::uint64_t RECORDS = 3 * CommandLogWriter::INDEX_STRIDE + 17;
+
+void writeRecords(CommandLogWriter& writer, std::uint32_t twist_topic, std::uint32_t pose_topic)
+{
+    for (std::uint64_t i = 0; i < RECORDS; ++i)
+    {
+        if (i % 5 == 4)
+        {
+            Pose pose = Pose();
+            pose.x = static_cast<double>(i);
+            pose.theta = -1.0;
+            writer.append(LOG_POSE, pose_topic, pose);
+        }
+        else
+        {
+            writer.append(LOG_TWIST, twist_topic, makeTwist(static_cast<double>(i), 0.5));
+        }
+    }
+}
+
+} // namespace
+
+TEST(CommandLog, RoundTripWithIndex)
+{
+    const std::string path = tempLog("index");
+    {
+        CommandLogWriter writer(path, 4);
+        const std::uint32_t cmd_vel = writer.addTopic("/turtle1/cmd_vel");
+        const std::uint32_t pose = writer.addTopic("/turtle1/pose");
+        writeRecords(writer, cmd_vel, pose);
+        EXPECT_EQ(RECORDS, writer.records());
+    }
+
+    CommandLogReader reader(path);
+    ASSERT_TRUE(reader.indexed());
+    ASSERT_EQ(RECORDS, reader.size());
+    ASSERT_EQ(2u, reader.topicCount());
+    EXPECT_EQ("/turtle1/cmd_vel", reader.topic(0));
+    EXPECT_EQ("/turtle1/pose", reader.topic(1));
+    EXPECT_GT(reader.startTime(), 0u);
+
+    for (std::uint64_t i = 0; i < reader.size(); ++i)
+    {
+        const LogRecord& record = reader.record(i);
+        if (i > 0)
+        {
+            ASSERT_GE(record.time, reader.record(i - 1).time);
+        }
+        if (i % 5 == 4)
+        {
+            ASSERT_EQ(static_cast<std::uint32_t>(LOG_POSE), record.kind);
+            ASSERT_EQ(1u, record.topic);
+            ASSERT_DOUBLE_EQ(static_cast<double>(i), poseFromLog(record).x);
+            ASSERT_DOUBLE_EQ(-1.0, poseFromLog(record).theta);
+        }
+        else
+        {
+            ASSERT_EQ(static_cast<std::uint32_t>(LOG_TWIST), record.kind);
+            ASSERT_EQ(0u, record.topic);
+            ASSERT_DOUBLE_EQ(static_cast<double>(i), twistFromLog(record).linear.x);
+            ASSERT_DOUBLE_EQ(0.5, twistFromLog(record).angular.z);
+        }
+    }
+    EXPECT_EQ(reader.record(RECORDS - 1).time, reader.duration());
+
+    // Alrededor de cada frontera de bloque del índice y en los extremos
+    EXPECT_EQ(0u, reader.seek(0));
+    EXPECT_EQ(RECORDS, reader.seek(reader.duration() + 1));
+    for (std::uint64_t block = 0; block * CommandLogWriter::INDEX_STRIDE < RECORDS; ++block)
+    {
+        const std::uint64_t first = block * CommandLogWriter::INDEX_STRIDE;
+        for (std::uint64_t i = first > 0 ? first - 1 : 0; i < first + 2 && i < RECORDS; ++i)
+        {
+            expectSeek(reader, reader.record(i).time);
+            expectSeek(reader, reader.record(i).time + 1);
+        }
+    }
+    for (std::uint64_t i = 0; i < RECORDS; i += 997)
+    {
+        expectSeek(reader, reader.record(i).time);
+    }
+    std::remove(path.c_str());
+}
+
+// Una grabación cortada antes de close() se sigue pudiendo leer y buscar sin índice
+TEST(CommandLog, UnclosedLogIsReadable)
+{
+    const std::string path = tempLog("open");
+    const std::string copy = tempLog("cut");
+    {
+        CommandLogWriter writer(path, 4);
+        const std::uint32_t cmd_vel = writer.addTopic("/turtle1/cmd_vel");
+        const std::uint32_t pose = writer.addTopic("/turtle1/pose");
+        writeRecords(writer, cmd_vel, pose);
+        copyFile(path, copy);
+    }
+
+    CommandLogReader reader(copy);
+    EXPECT_FALSE(reader.indexed());
+    ASSERT_EQ(RECORDS, reader.size());
+    EXPECT_DOUBLE_EQ(static_cast<double>(RECORDS - 1), twistFromLog(reader.record(RECORDS - 1)).linear.x);
+    for (std::uint64_t i = 0; i < RECORDS; i += 1001)
+    {
+        expectSeek(reader, reader.record(i).time);
+    }
+    std::remove(path.c_str());
+    std::remove(copy.c_str());
+}
+
+TEST(CommandLog, TopicTableIsBounded)
+{
+    const std::string path = tempLog("topics");
+    {
+        CommandLogWriter writer(path, 2);
+        writer.addTopic("/a");
+        writer.addTopic("/b");
+        EXPECT_THROW(writer.addTopic("/c"), std::length_error);
+    }
+    std::remove(path.c_str());
+}
+
+// La tabla de topics dice qué tipos de registro lleva cada topic
+TEST(CommandLog, TopicKinds)
+{
+    const std::string path = tempLog("kinds");
+    const std::string long_name = "/" + std::string(62, 'x');  // ocupa todo el nombre de la entrada
+    {
+        CommandLogWriter writer(path, 4);
+        const std::uint32_t cmd_vel = writer.addTopic("/turtle1/cmd_vel");
+        const std::uint32_t pose = writer.addTopic("/turtle1/pose");
+        writer.addTopic("/turtle2/cmd_vel");
+        const std::uint32_t both = writer.addTopic(long_name);
+        writeRecords(writer, cmd_vel, pose);
+        writer.append(LOG_TWIST, both, makeTwist(1.0, 0.0));
+        writer.append(LOG_POSE, both, Pose());
+    }
+
+    CommandLogReader reader(path);
+    ASSERT_TRUE(reader.topicKindsKnown());
+    ASSERT_EQ(4u, reader.topicCount());
+    EXPECT_TRUE(reader.topicHasKind(0, LOG_TWIST));
+    EXPECT_FALSE(reader.topicHasKind(0, LOG_POSE));
+    EXPECT_FALSE(reader.topicHasKind(1, LOG_TWIST));
+    EXPECT_TRUE(reader.topicHasKind(1, LOG_POSE));
+    EXPECT_FALSE(reader.topicHasKind(2, LOG_TWIST));
+    EXPECT_FALSE(reader.topicHasKind(2, LOG_POSE));
+    EXPECT_TRUE(reader.topicHasKind(3, LOG_TWIST));
+    EXPECT_TRUE(reader.topicHasKind(3, LOG_POSE));
+    EXPECT_EQ(long_name, reader.topic(3));
+    std::remove(path.c_str());
+}
+
+TEST(CommandLog, RejectsInvalidFile)
+{
+    const std::string path = tempLog("garbage");
+    {
+        std::ofstream out(path.c_str(), std::ios::binary);
+        out << "no es un log";
+    }
+    EXPECT_THROW(CommandLogReader reader(path), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+// RecordingTransport graba lo publicado y lo recibido sin cambiarlo
+TEST(CommandLog, RecordingTransport)
+{
+    const std::string path = tempLog("transport");
+    MemoryTransport memory;
+    {
+        CommandLogWriter writer(path, 8);
+        RecordingTransport transport(memory, writer);
+        const Transport::Channel channel = transport.advertise("/turtle1/cmd_vel");
+        int poses = 0;
+        transport.subscribe("/turtle1/pose", [&poses](const Pose&) { ++poses; });
+
+        transport.publish(channel, makeTwist(1.0, 2.0));
+        Pose pose = Pose();
+        pose.x = 3.0;
+        memory.deliver("/turtle1/pose", pose);
+        EXPECT_EQ(1, poses);
+        EXPECT_EQ(1u, memory.count(channel));
+        EXPECT_DOUBLE_EQ(1.0, memory.last(channel).linear.x);
+    }
+
+    CommandLogReader reader(path);
+    ASSERT_EQ(2u, reader.size());
+    EXPECT_EQ(static_cast<std::uint32_t>(LOG_TWIST), reader.record(0).kind);
+    EXPECT_EQ("/turtle1/cmd_vel", reader.topic(reader.record(0).topic));
+    EXPECT_DOUBLE_EQ(2.0, twistFromLog(reader.record(0)).angular.z);
+    EXPECT_EQ(static_cast<std::uint32_t>(LOG_POSE), reader.record(1).kind);
+    EXPECT_EQ("/turtle1/pose", reader.topic(reader.record(1).topic));
+    EXPECT_DOUBLE_EQ(3.0, poseFromLog(reader.record(1)).x);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,142 @@
+#include <cmath>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "turtle_unida/commander.h"
+#include "turtle_unida/latency.h"
+#include "turtle_unida/scheduler.h"
+#include "turtle_unida/sim_transport.h"
+#include "turtle_unida/simulator.h"
+#include "turtle_unida/transport.h"
+
+using namespace turtle_unida;
+
+// Por defecto el commander publica el círculo de mover.py en /turtle1/cmd_vel
+TEST(Commander, StepPublishesTrajectory)
+{
+    MemoryTransport transport;
+    Commander commander(transport, CommanderConfig());
+    ASSERT_EQ(1u, transport.channels());
+    EXPECT_EQ("/turtle1/cmd_vel", transport.topic(0));
+
+    for (int i = 0; i < 5; ++i)
+    {
+        commander.step(0.001 * i);
+    }
+    EXPECT_EQ(5u, transport.count(0));
+    EXPECT_EQ(5u, commander.stats().ticks);
+    EXPECT_DOUBLE_EQ(2.0, transport.last(0).linear.x);
+    EXPECT_DOUBLE_EQ(1.5, transport.last(0).angular.z);
+    EXPECT_FALSE(isStamped(transport.last(0)));
+}
+
+TEST(Commander, StampMarksGeneration)
+{
+    MemoryTransport transport;
+    CommanderConfig config;
+    config.stamp = true;
+    Commander commander(transport, config);
+
+    commander.step(0.0);
+    CommandStamp stamp;
+    ASSERT_TRUE(readStamp(transport.last(0), stamp));
+    EXPECT_GT(stamp.generated, 0u);
+    EXPECT_LE(stamp.generated, monotonicNanos());
+    // Sin cola ni transporte real nadie marca la entrada en la cola ni el envío
+    EXPECT_EQ(0u, stamp.enqueued);
+    EXPECT_EQ(0u, stamp.sent);
+}
+
+TEST(Commander, SetTrajectoryKeepsPreviousOnError)
+{
+    MemoryTransport transport;
+    Commander commander(transport, CommanderConfig());
+
+    TrajectoryParams params;
+    params.linear = 0.5;
+    params.angular = -1.0;
+    commander.setTrajectory(params);
+    EXPECT_EQ(1u, commander.reloads());
+    commander.step(0.0);
+    EXPECT_DOUBLE_EQ(0.5, transport.last(0).linear.x);
+    EXPECT_DOUBLE_EQ(-1.0, transport.last(0).angular.z);
+
+    TrajectoryParams unknown;
+    unknown.type = "hexagon";
+    EXPECT_THROW(commander.setTrajectory(unknown), std::invalid_argument);
+    EXPECT_EQ(1u, commander.reloads());
+    commander.step(0.1);
+    EXPECT_DOUBLE_EQ(0.5, transport.last(0).linear.x);
+}
+
+TEST(Commander, InvalidTrajectoryThrows)
+{
+    MemoryTransport transport;
+    CommanderConfig config;
+    config.trajectory.type = "hexagon";
+    EXPECT_THROW(Commander(transport, config), std::invalid_argument);
+}
+
+// Con el simulador en el mismo proceso la tortuga sigue el círculo
+TEST(Commander, DrivesSimulatedTurtle)
+{
+    Simulator simulator;
+    SimTransport transport(simulator);
+    const std::size_t turtle = transport.spawn("turtle1", 5.5, 5.5, 0.0);
+    Commander commander(transport, CommanderConfig());
+
+    Pose last;
+    int poses = 0;
+    transport.subscribe("/turtle1/pose", [&last, &poses](const Pose& pose) {
+        last = pose;
+        ++poses;
+    });
+
+    // Un cuarto de vuelta: 2π/1.5/4 segundos
+    const double dt = simulator.config().dt;
+    const int steps = static_cast<int>(std::round(M_PI / 1.5 / 2.0 / dt));
+    for (int i = 0; i < steps; ++i)
+    {
+        commander.step(i * dt);
+        transport.step();
+    }
+    EXPECT_EQ(steps, poses);
+    EXPECT_DOUBLE_EQ(2.0, last.linear_velocity);
+    EXPECT_DOUBLE_EQ(1.5, last.angular_velocity);
+
+    // Radio 2.0 / 1.5 alrededor de (5.5, 5.5 + r)
+    const double radius = 2.0 / 1.5;
+    const Pose pose = simulator.pose(turtle);
+    EXPECT_NEAR(std::hypot(pose.x - 5.5, pose.y - 5.5 - radius), radius, 0.05);
+    EXPECT_NEAR(M_PI / 2.0, pose.theta, 0.05);
+}
+
+TEST(Commander, PipelinePublishesLatestSetpoint)
+{
+    MemoryTransport transport;
+    CommanderConfig config;
+    config.pipeline = true;
+    config.stamp = true;
+    Commander commander(transport, config);
+
+    SchedulerConfig loop;
+    loop.rate = 500.0;
+    PeriodicScheduler scheduler(loop);
+    int cycles = 0;
+    commander.run(scheduler, [&cycles]() { return cycles++ < 100; });
+
+    // Solo se puede quedar sin publicar algún ciclo del principio, antes de
+    // la primera consigna
+    const CommanderStats& stats = commander.stats();
+    EXPECT_EQ(transport.count(0), stats.ticks);
+    EXPECT_GT(stats.ticks, 0u);
+    EXPECT_LE(stats.ticks, 100u);
+    EXPECT_GE(stats.planned, stats.dropped);
+
+    // La consigna pasa por el buzón del modo pipeline
+    CommandStamp stamp;
+    ASSERT_TRUE(readStamp(transport.last(0), stamp));
+    EXPECT_GE(stamp.enqueued, stamp.generated);
+    EXPECT_DOUBLE_EQ(2.0, transport.last(0).linear.x);
+}
@@ -0,0 +1,59 @@
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include "turtle_unida/config_file.h"
+#include "turtle_unida/trajectory.h"
+
+using namespace turtle_unida;
+
+namespace
+{
+
+std::string writeTemp(const std::string& name, const std::string& contents)
+{
+    const std::string path = ::testing::TempDir() + "turtle_unida_test_" + std::to_string(::getpid()) + "_" + name;
+    std::ofstream out(path.c_str());
+    out << contents;
+    return path;
+}
+
+} // namespace
+
+TEST(ConfigFile, ReadsKnownKeys)
+{
+    const std::string path = writeTemp("good.yaml",
+        "# trayectoria de prueba\n"
+        "trajectory: piecewise\n"
+        "linear_x: 0.5\n"
+        "segments: [1.0, 2.0, 0.0, 2.0, 0.0, 1.5]\n");
+    TrajectoryParams params;
+    params.angular = 0.25;
+    readTrajectoryFile(path, params);
+    EXPECT_EQ("piecewise", params.type);
+    EXPECT_DOUBLE_EQ(0.5, params.linear);
+    EXPECT_DOUBLE_EQ(0.25, params.angular);  // no aparece: se conserva
+    ASSERT_EQ(6u, params.segments.size());
+    EXPECT_DOUBLE_EQ(1.5, params.segments[5]);
+    std::remove(path.c_str());
+}
+
+// Una errata en una clave no se ignora en silencio
+TEST(ConfigFile, RejectsUnknownKey)
+{
+    const std::string path = writeTemp("typo.yaml", "linear: 0.5\n");
+    TrajectoryParams params;
+    EXPECT_THROW(readTrajectoryFile(path, params), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(ConfigFile, RejectsMissingFile)
+{
+    TrajectoryParams params;
+    EXPECT_THROW(readTrajectoryFile(::testing::TempDir() + "turtle_unida_test_no_existe.yaml", params),
+        std::runtime_error);
+}
@@ -0,0 +1,210 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "turtle_unida/drawing.h"
+#include "turtle_unida/simulator.h"
+
+using namespace turtle_unida;
+
+namespace
+{
+
+// Imagen en blanco
+Bitmap blankBitmap(int width, int height)
+{
+    Bitmap bitmap;
+    bitmap.width = width;
+    bitmap.height = height;
+    bitmap.pixels.assign(static_cast<std::size_t>(width) * height, 255);
+    return bitmap;
+}
+
+// Pinta el rectángulo [x0, x1) x [y0, y1) del color dado (negro por defecto)
+void fillRect(Bitmap& bitmap, int x0, int y0, int x1, int y1, std::uint8_t value = 0)
+{
+    for (int y = y0; y < y1; ++y)
+    {
+        for (int x = x0; x < x1; ++x)
+        {
+            bitmap.pixels[static_cast<std::size_t>(y) * bitmap.width + x] = value;
+        }
+    }
+}
+
+// Puntos del trazo sin orden, para comparar contornos que empiezan en otro punto
+std::vector<std::pair<double, double> > sortedPoints(const Stroke& stroke)
+{
+    std::vector<std::pair<double, double> > points;
+    for (std::size_t i = 0; i < stroke.size(); ++i)
+    {
+        points.push_back(std::make_pair(stroke.points[2 * i], stroke.points[2 * i + 1]));
+    }
+    std::sort(points.begin(), points.end());
+    return points;
+}
+
+} // namespace
+
+// Un cuadrado relleno es un único contorno cerrado, con o sin bandas
+TEST(Drawing, FilledSquareIsOneClosedContour)
+{
+    Bitmap bitmap = blankBitmap(40, 40);
+    fillRect(bitmap, 10, 10, 30, 30);
+
+    const std::vector<Stroke> single = extractContours(bitmap, 128, 1);
+    ASSERT_EQ(1u, single.size());
+    EXPECT_TRUE(single[0].closed);
+
+    // Las fronteras de las bandas cortan el cuadrado: los tramos se tienen que volver a unir
+    for (int tiles = 2; tiles <= 8; ++tiles)
+    {
+        const std::vector<Stroke> split = extractContours(bitmap, 128, tiles);
+        ASSERT_EQ(1u, split.size()) << "tiles=" << tiles;
+        EXPECT_TRUE(split[0].closed) << "tiles=" << tiles;
+        EXPECT_EQ(sortedPoints(single[0]), sortedPoints(split[0])) << "tiles=" << tiles;
+    }
+}
+
+// El contorno de un cuadrado se queda en sus cuatro esquinas, aunque el
+// lazo empiece en medio de un lado
+TEST(Drawing, SimplifySquareToCorners)
+{
+    Stroke square;
+    square.closed = true;
+    for (int i = 5; i < 10; ++i)
+    {
+        square.points.push_back(0.0);
+        square.points.push_back(static_cast<double>(i));
+    }
+    for (int i = 0; i < 10; ++i)
+    {
+        square.points.push_back(static_cast<double>(i));
+        square.points.push_back(10.0);
+    }
+    for (int i = 10; i > 0; --i)
+    {
+        square.points.push_back(10.0);
+        square.points.push_back(static_cast<double>(i));
+    }
+    for (int i = 10; i > 0; --i)
+    {
+        square.points.push_back(static_cast<double>(i));
+        square.points.push_back(0.0);
+    }
+    for (int i = 0; i < 5; ++i)
+    {
+        square.points.push_back(0.0);
+        square.points.push_back(static_cast<double>(i));
+    }
+
+    const Stroke simplified = simplifyStroke(square, 0.5);
+    EXPECT_TRUE(simplified.closed);
+    ASSERT_EQ(4u, simplified.size());
+    std::vector<std::pair<double, double> > corners;
+    corners.push_back(std::make_pair(0.0, 0.0));
+    corners.push_back(std::make_pair(0.0, 10.0));
+    corners.push_back(std::make_pair(10.0, 0.0));
+    corners.push_back(std::make_pair(10.0, 10.0));
+    EXPECT_EQ(corners, sortedPoints(simplified));
+
+    // Lo mismo con el contorno que sale de la imagen (esquinas achaflanadas medio píxel)
+    Bitmap bitmap = blankBitmap(40, 40);
+    fillRect(bitmap, 10, 10, 30, 30);
+    const std::vector<Stroke> contours = extractContours(bitmap, 128, 4);
+    ASSERT_EQ(1u, contours.size());
+    EXPECT_EQ(4u, simplifyStroke(contours[0], 1.0).size());
+}
+
+TEST(Drawing, OrderNeverIncreasesTravel)
+{
+    std::mt19937 random(7);
+    std::uniform_real_distribution<double> coordinate(0.0, 100.0);
+    for (int round = 0; round < 20; ++round)
+    {
+        std::vector<Stroke> strokes(5 + round * 3);
+        for (std::size_t i = 0; i < strokes.size(); ++i)
+        {
+            strokes[i].closed = i % 2 == 0;
+            for (int k = 0; k < 4; ++k)
+            {
+                strokes[i].points.push_back(coordinate(random));
+                strokes[i].points.push_back(coordinate(random));
+            }
+        }
+
+        const double before = penUpTravel(strokes);
+        const std::size_t count = strokes.size();
+        const double after = orderStrokes(strokes, round % 4 == 0 ? 0 : 8);
+        EXPECT_EQ(count, strokes.size());
+        EXPECT_LE(after, before + 1e-9) << "round=" << round;
+        EXPECT_NEAR(penUpTravel(strokes), after, 1e-9) << "round=" << round;
+
+        // Un orden ya bueno no empeora al volver a ordenarlo
+        EXPECT_LE(orderStrokes(strokes, 8), after + 1e-9) << "round=" << round;
+    }
+
+    // Partiendo del mejor orden de pocos trazos, el vecino más próximo desde
+    // (0, 0) suele ser peor: tiene que quedarse con el recibido
+    for (int round = 0; round < 50; ++round)
+    {
+        std::vector<Stroke> strokes(4);
+        for (std::size_t i = 0; i < strokes.size(); ++i)
+        {
+            for (int k = 0; k < 2; ++k)
+            {
+                strokes[i].points.push_back(coordinate(random));
+                strokes[i].points.push_back(coordinate(random));
+            }
+        }
+        std::vector<std::size_t> order;
+        for (std::size_t i = 0; i < strokes.size(); ++i)
+        {
+            order.push_back(i);
+        }
+        std::vector<Stroke> best;
+        double best_travel = 0.0;
+        do
+        {
+            std::vector<Stroke> permuted;
+            for (std::size_t i = 0; i < order.size(); ++i)
+            {
+                permuted.push_back(strokes[order[i]]);
+            }
+            const double travel = penUpTravel(permuted);
+            if (best.empty() || travel < best_travel)
+            {
+                best.swap(permuted);
+                best_travel = travel;
+            }
+        } while (std::next_permutation(order.begin(), order.end()));
+        EXPECT_LE(orderStrokes(best, 8), best_travel + 1e-9) << "round=" << round;
+    }
+}
+
+// Las órdenes llevan la tortuga del simulador exactamente a los puntos previstos
+TEST(Drawing, SimulatorFollowsPlan)
+{
+    Bitmap bitmap = blankBitmap(64, 48);
+    fillRect(bitmap, 5, 5, 25, 20);
+    fillRect(bitmap, 35, 25, 55, 40);
+    fillRect(bitmap, 40, 30, 50, 35, 255);  // hueco dentro del segundo rectángulo
+
+    DrawingConfig config;
+    config.tiles = 2;
+    const DrawingPlan plan = planDrawing(bitmap, config);
+    EXPECT_EQ(3u, plan.strokes.size());
+    ASSERT_FALSE(plan.commands.empty());
+
+    SimulatorConfig sim_config;
+    sim_config.dt = config.dt;
+    Simulator simulator(sim_config);
+    const std::size_t turtle = simulator.spawn(0.5 * sim_config.world_size, 0.5 * sim_config.world_size, 0.0);
+    EXPECT_LT(drawInSimulator(plan.commands, simulator, turtle), 1e-6);
+    EXPECT_EQ(0u, simulator.wallHits());
+}
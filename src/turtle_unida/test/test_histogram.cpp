@@ -0,0 +1,96 @@
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "turtle_unida/histogram.h"
+
+using namespace turtle_unida;
+
+TEST(Histogram, EmptyIsZero)
+{
+    Histogram histogram;
+    EXPECT_EQ(0u, histogram.count());
+    EXPECT_EQ(0u, histogram.min());
+    EXPECT_EQ(0u, histogram.max());
+    EXPECT_EQ(0u, histogram.percentile(0.5));
+    EXPECT_DOUBLE_EQ(0.0, histogram.mean());
+}
+
+// Por debajo de SUB_BUCKETS cada valor tiene su propio cubo
+TEST(Histogram, SmallValuesAreExact)
+{
+    Histogram histogram;
+    for (std::uint64_t value = 0; value < Histogram::SUB_BUCKETS; ++value)
+    {
+        histogram.record(value);
+    }
+    EXPECT_EQ(0u, histogram.percentile(0.0));
+    EXPECT_EQ(15u, histogram.percentile(0.5));
+    EXPECT_EQ(31u, histogram.percentile(1.0));
+    EXPECT_EQ(0u, histogram.min());
+    EXPECT_EQ(31u, histogram.max());
+}
+
+// En todo el rango el percentil queda a menos de un 3 % del exacto y nunca por debajo
+TEST(Histogram, PercentilesWithinRelativeError)
+{
+    Histogram histogram;
+    const std::uint64_t n = 100000;
+    for (std::uint64_t value = 1; value <= n; ++value)
+    {
+        histogram.record(value * 1000);
+    }
+    const double quantiles[] = {0.01, 0.5, 0.9, 0.99, 0.999};
+    for (double q : quantiles)
+    {
+        const double exact = q * n * 1000;
+        const double estimate = static_cast<double>(histogram.percentile(q));
+        EXPECT_GE(estimate, exact) << "q=" << q;
+        EXPECT_LE(estimate, exact * 1.03) << "q=" << q;
+    }
+    EXPECT_EQ(n * 1000, histogram.percentile(1.0));
+    EXPECT_EQ(n * 1000, histogram.max());
+    EXPECT_DOUBLE_EQ((n + 1) * 500.0, histogram.mean());
+}
+
+// El percentil nunca supera el máximo registrado aunque el cubo sea más ancho
+TEST(Histogram, PercentileClampedToMax)
+{
+    Histogram histogram;
+    histogram.record(1000001);
+    EXPECT_EQ(1000001u, histogram.percentile(0.5));
+    EXPECT_EQ(1000001u, histogram.percentile(1.0));
+}
+
+TEST(Histogram, MergeMatchesSingleHistogram)
+{
+    Histogram all;
+    Histogram even;
+    Histogram odd;
+    for (std::uint64_t value = 1; value <= 5000; ++value)
+    {
+        all.record(value * 37);
+        (value % 2 ? odd : even).record(value * 37);
+    }
+    even.merge(odd);
+    EXPECT_EQ(all.count(), even.count());
+    EXPECT_EQ(all.min(), even.min());
+    EXPECT_EQ(all.max(), even.max());
+    EXPECT_DOUBLE_EQ(all.mean(), even.mean());
+    EXPECT_EQ(all.percentile(0.5), even.percentile(0.5));
+    EXPECT_EQ(all.percentile(0.99), even.percentile(0.99));
+}
+
+TEST(Histogram, SecondsAndReset)
+{
+    Histogram histogram;
+    histogram.recordSeconds(-1.0);
+    histogram.recordSeconds(2e-6);
+    EXPECT_EQ(2u, histogram.count());
+    EXPECT_EQ(0u, histogram.min());
+    EXPECT_EQ(2000u, histogram.max());
+
+    histogram.reset();
+    EXPECT_EQ(0u, histogram.count());
+    EXPECT_EQ(0u, histogram.percentile(0.99));
+}
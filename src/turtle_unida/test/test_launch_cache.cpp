@@ -0,0 +1,140 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "turtle_unida/launch_cache.h"
+
+using namespace turtle_unida;
+
+namespace
+{
+
+std::string tempPath(const std::string& name)
+{
+    return ::testing::TempDir() + "turtle_unida_test_" + std::to_string(::getpid()) + "_" + name;
+}
+
+std::string writeScript(const std::string& name, const std::string& contents)
+{
+    const std::string path = tempPath(name);
+    {
+        std::ofstream out(path.c_str());
+        out << contents;
+    }
+    ::chmod(path.c_str(), 0755);
+    return path;
+}
+
+} // namespace
+
+TEST(LaunchCache, HitAfterFirstResolve)
+{
+    const std::string script = writeScript("hit.py", "#!/bin/sh -e\nexit 0\n");
+    LaunchCache cache;
+
+    bool cached = true;
+    const std::vector<std::string> first = cache.interpreter(script, cached);
+    EXPECT_FALSE(cached);
+    ASSERT_FALSE(first.empty());
+    EXPECT_EQ("/bin/sh", first[0]);
+
+    const std::vector<std::string> second = cache.interpreter(script, cached);
+    EXPECT_TRUE(cached);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(1, cache.stats().hits);
+    EXPECT_EQ(1, cache.stats().misses);
+    EXPECT_EQ(1u, cache.size());
+    std::remove(script.c_str());
+}
+
+// Un script modificado (otro tamaño y otra fecha) se vuelve a leer
+TEST(LaunchCache, MissAfterScriptChanges)
+{
+    const std::string script = writeScript("changed.py", "#!/bin/sh -e\nexit 0\n");
+    LaunchCache cache;
+
+    bool cached = true;
+    const std::vector<std::string> before = cache.interpreter(script, cached);
+    EXPECT_FALSE(cached);
+
+    writeScript("changed.py", "#!/bin/sh\nexit 0\n");
+    struct timespec times[2];
+    times[0].tv_sec = 1000000000;
+    times[0].tv_nsec = 0;
+    times[1] = times[0];
+    ASSERT_EQ(0, ::utimensat(AT_FDCWD, script.c_str(), times, 0));
+
+    const std::vector<std::string> after = cache.interpreter(script, cached);
+    EXPECT_FALSE(cached);
+    EXPECT_NE(before, after);
+    EXPECT_EQ(2, cache.stats().misses);
+
+    cache.interpreter(script, cached);
+    EXPECT_TRUE(cached);
+    std::remove(script.c_str());
+}
+
+TEST(LaunchCache, SaveAndLoad)
+{
+    const std::string file = tempPath("launch_cache_roundtrip");
+    const std::string script = writeScript("saved.py", "#!/bin/sh -e\nexit 0\n");
+    std::vector<std::string> command;
+    {
+        LaunchCache cache(file);
+        EXPECT_EQ(0, cache.stats().loaded);
+        bool cached = true;
+        command = cache.interpreter(script, cached);
+        EXPECT_FALSE(cached);
+        ASSERT_TRUE(cache.save());
+    }
+
+    LaunchCache cache(file);
+    EXPECT_EQ(1, cache.stats().loaded);
+    bool cached = false;
+    EXPECT_EQ(command, cache.interpreter(script, cached));
+    EXPECT_TRUE(cached);
+    EXPECT_EQ(0, cache.stats().misses);
+    std::remove(script.c_str());
+    std::remove(file.c_str());
+}
+
+// Una entrada invalidada no vuelve al guardar (save() mezcla lo que hay en el
+// fichero) ni al cargarlo otra vez
+TEST(LaunchCache, InvalidateSurvivesSave)
+{
+    const std::string file = tempPath("launch_cache_invalidate");
+    const std::string stale = writeScript("stale.py", "#!/bin/sh -e\nexit 0\n");
+    const std::string kept = writeScript("kept.py", "#!/bin/sh\nexit 0\n");
+    bool cached = false;
+    {
+        LaunchCache cache(file);
+        cache.interpreter(stale, cached);
+        cache.interpreter(kept, cached);
+        ASSERT_TRUE(cache.save());
+    }
+    {
+        LaunchCache cache(file);
+        EXPECT_EQ(2, cache.stats().loaded);
+        cache.invalidate(stale);
+        EXPECT_EQ(1, cache.stats().invalidated);
+        EXPECT_EQ(1u, cache.size());
+        ASSERT_TRUE(cache.save());
+        EXPECT_EQ(1u, cache.size());
+    }
+
+    LaunchCache cache(file);
+    EXPECT_EQ(1, cache.stats().loaded);
+    cache.interpreter(kept, cached);
+    EXPECT_TRUE(cached);
+    cache.interpreter(stale, cached);
+    EXPECT_FALSE(cached);
+    std::remove(stale.c_str());
+    std::remove(kept.c_str());
+    std::remove(file.c_str());
+}
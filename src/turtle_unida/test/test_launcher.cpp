@@ -0,0 +1,69 @@
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "turtle_unida/launcher.h"
+
+using namespace turtle_unida;
+
+namespace
+{
+
+std::string writeScript(const std::string& name, const std::string& contents)
+{
+    const std::string path = ::testing::TempDir() + "turtle_unida_test_" + std::to_string(::getpid()) + "_" + name;
+    {
+        std::ofstream out(path.c_str());
+        out << contents;
+    }
+    ::chmod(path.c_str(), 0755);
+    return path;
+}
+
+} // namespace
+
+// Todos los campos empiezan a cero: json() no puede leer nada sin inicializar
+TEST(LaunchTiming, DefaultsAreZero)
+{
+    const LaunchTiming timing;
+    EXPECT_FALSE(timing.cached);
+    EXPECT_FALSE(timing.zygote);
+    EXPECT_FALSE(timing.exec);
+    EXPECT_EQ(0, timing.pid);
+    EXPECT_EQ(0, timing.exit_code);
+    EXPECT_EQ("{\"launch\":\"x\",\"pid\":0,\"exit\":0,\"cached\":false,\"zygote\":false,\"exec\":false,"
+              "\"executable_us\":0.0,\"script_us\":0.0,\"interpreter_us\":0.0,\"spawn_us\":0.0,\"run_s\":0.000}",
+        LaunchTiming().json("x"));
+}
+
+TEST(Launcher, FindPythonScript)
+{
+    EXPECT_EQ("/ruta/mover.py", findPythonScript("/ruta/mover"));
+}
+
+TEST(Launcher, ReadsShebang)
+{
+    const std::string path = writeScript("shebang.sh", "#!/bin/sh -e\nexit 0\n");
+    const std::vector<std::string> interpreter = getPythonExecutable(path);
+    ASSERT_EQ(2u, interpreter.size());
+    EXPECT_EQ("/bin/sh", interpreter[0]);
+    EXPECT_EQ("-e", interpreter[1]);
+    ::unlink(path.c_str());
+}
+
+// El código de salida del script llega tal cual a quien lo lanza
+TEST(Launcher, LaunchScriptReturnsExitCode)
+{
+    const std::string path = writeScript("exit.sh", "#!/bin/sh\nexit \"$1\"\n");
+    LaunchTiming timing;
+    EXPECT_EQ(3, launchScript("launcher", path, std::vector<std::string>(1, "3"), timing));
+    EXPECT_EQ(3, timing.exit_code);
+    EXPECT_GT(timing.pid, 0);
+    EXPECT_FALSE(timing.zygote);
+    EXPECT_FALSE(timing.exec);
+    ::unlink(path.c_str());
+}
@@ -0,0 +1,94 @@
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "turtle_unida/rcu.h"
+
+using namespace turtle_unida;
+
+namespace
+{
+
+// Cuenta los objetos vivos para comprobar cuándo se liberan
+struct Tracked
+{
+    explicit Tracked(int value, std::atomic<int>& alive) : value(value), alive(alive) { ++alive; }
+    ~Tracked() { --alive; }
+
+    int value;
+    std::atomic<int>& alive;
+};
+
+} // namespace
+
+TEST(RcuCell, PublishReplacesValue)
+{
+    RcuCell<int> cell(std::unique_ptr<int>(new int(1)));
+    EXPECT_EQ(1, cell.read());
+    EXPECT_EQ(0u, cell.version());
+
+    cell.publish(std::unique_ptr<int>(new int(2)));
+    EXPECT_EQ(2, cell.read());
+    EXPECT_EQ(1u, cell.version());
+}
+
+// El anterior solo se libera cuando el lector ha pasado por quiescent()
+TEST(RcuCell, ReclaimsAfterQuiescentState)
+{
+    std::atomic<int> alive(0);
+    {
+        RcuCell<Tracked> cell(std::unique_ptr<Tracked>(new Tracked(1, alive)));
+        const Tracked& old = cell.read();
+
+        cell.publish(std::unique_ptr<Tracked>(new Tracked(2, alive)));
+        EXPECT_EQ(2, alive.load());
+        EXPECT_EQ(1u, cell.retired());
+        EXPECT_EQ(1, old.value);  // el lector aún puede usarlo
+
+        cell.quiescent();
+        cell.publish(std::unique_ptr<Tracked>(new Tracked(3, alive)));
+        // El primero ya se ha liberado; el segundo espera al siguiente quiescent()
+        EXPECT_EQ(2, alive.load());
+        EXPECT_EQ(1u, cell.retired());
+        EXPECT_EQ(3, cell.read().value);
+    }
+    EXPECT_EQ(0, alive.load());
+}
+
+// Un lector que recorre el objeto mientras otro hilo publica siempre ve uno
+// completo y vivo
+TEST(RcuCell, ConcurrentReaderSeesConsistentObjects)
+{
+    struct Pair
+    {
+        long a;
+        long b;
+    };
+    RcuCell<Pair> cell(std::unique_ptr<Pair>(new Pair{0, 0}));
+    std::atomic<bool> done(false);
+    const long n = 20000;
+
+    std::thread writer([&cell, &done, n]() {
+        for (long i = 1; i <= n; ++i)
+        {
+            cell.publish(std::unique_ptr<Pair>(new Pair{i, -i}));
+        }
+        done.store(true);
+    });
+
+    long last = 0;
+    while (!done.load())
+    {
+        const Pair& pair = cell.read();
+        ASSERT_EQ(-pair.a, pair.b);
+        ASSERT_GE(pair.a, last);
+        last = pair.a;
+        cell.quiescent();
+    }
+    writer.join();
+    EXPECT_EQ(n, cell.read().a);
+    EXPECT_EQ(static_cast<std::uint64_t>(n), cell.version());
+}
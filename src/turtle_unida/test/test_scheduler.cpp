@@ -0,0 +1,39 @@
+#include <limits>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "turtle_unida/scheduler.h"
+
+using namespace turtle_unida;
+
+TEST(PeriodicScheduler, RejectsInvalidConfig)
+{
+    const double rates[] = {0.0, -10.0, std::numeric_limits<double>::infinity(),
+        std::numeric_limits<double>::quiet_NaN(), 1e12};
+    for (double rate : rates)
+    {
+        SchedulerConfig config;
+        config.rate = rate;
+        EXPECT_THROW(validateSchedulerConfig(config), std::invalid_argument) << "rate=" << rate;
+        EXPECT_THROW(PeriodicScheduler scheduler(config), std::invalid_argument) << "rate=" << rate;
+    }
+
+    SchedulerConfig config;
+    config.spin_margin = -1e-4;
+    EXPECT_THROW(PeriodicScheduler scheduler(config), std::invalid_argument);
+}
+
+TEST(PeriodicScheduler, KeepsPeriod)
+{
+    SchedulerConfig config;
+    config.rate = 1000.0;
+    PeriodicScheduler scheduler(config);
+    for (int i = 0; i < 50; ++i)
+    {
+        scheduler.wait();
+    }
+    EXPECT_EQ(50u, scheduler.stats().ticks);
+    // Instante 0 más 49 periodos, salvo los ciclos saltados por ir tarde
+    EXPECT_GE(scheduler.time(), 0.049 - 1e-9);
+}
@@ -0,0 +1,190 @@
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "turtle_unida/shm_ring.h"
+
+// La memoria compartida solo existe en Linux; en el resto no hay nada que probar
+#if defined(__linux__)
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace turtle_unida;
+
+namespace
+{
+
+// Nombre propio de cada prueba y proceso para no chocar con nodos en marcha
+std::string testSegment(const std::string& test)
+{
+    return ShmRing::segmentName("/turtle_unida_test." + std::to_string(::getpid()), "/" + test);
+}
+
+ShmRing::Record makeRecord(double value)
+{
+    ShmRing::Record record = ShmRing::Record();
+    for (std::size_t i = 0; i < ShmRing::VALUES; ++i)
+    {
+        record.values[i] = value + i;
+    }
+    return record;
+}
+
+} // namespace
+
+TEST(ShmRing, SegmentName)
+{
+    EXPECT_EQ("/turtle_unida.1f2e.turtle1.cmd_vel", ShmRing::segmentName("/turtle_unida.1f2e", "/turtle1/cmd_vel"));
+}
+
+TEST(ShmRing, OpenWithoutWriter)
+{
+    EXPECT_FALSE(ShmRing::open(testSegment("missing")));
+}
+
+// El lector solo ve lo escrito después de conectarse, en orden
+TEST(ShmRing, ReaderSeesNewRecords)
+{
+    const std::string name = testSegment("new");
+    std::unique_ptr<ShmRing> writer = ShmRing::create(name, 8);
+    writer->write(makeRecord(100.0));
+
+    std::unique_ptr<ShmRing> reader = ShmRing::open(name);
+    ASSERT_TRUE(reader);
+    EXPECT_TRUE(reader->writerAlive());
+    ShmRing::Record record;
+    EXPECT_FALSE(reader->next(record));
+
+    writer->write(makeRecord(1.0));
+    writer->write(makeRecord(2.0));
+    ASSERT_TRUE(reader->next(record));
+    EXPECT_DOUBLE_EQ(1.0, record.values[0]);
+    EXPECT_DOUBLE_EQ(7.0, record.values[ShmRing::VALUES - 1]);
+    ASSERT_TRUE(reader->next(record));
+    EXPECT_DOUBLE_EQ(2.0, record.values[0]);
+    EXPECT_FALSE(reader->next(record));
+    EXPECT_EQ(0u, reader->dropped());
+}
+
+// Muchas vueltas a un anillo pequeño sin perder ni desordenar registros
+TEST(ShmRing, WrapsAroundInOrder)
+{
+    const std::string name = testSegment("wrap");
+    std::unique_ptr<ShmRing> writer = ShmRing::create(name, 4);
+    std::unique_ptr<ShmRing> reader = ShmRing::open(name);
+    ASSERT_TRUE(reader);
+
+    int written = 0;
+    int read = 0;
+    for (int round = 0; round < 500; ++round)
+    {
+        const int burst = 1 + round % 4;
+        for (int i = 0; i < burst; ++i)
+        {
+            writer->write(makeRecord(written++));
+        }
+        ShmRing::Record record;
+        while (reader->next(record))
+        {
+            ASSERT_DOUBLE_EQ(read++, record.values[0]);
+        }
+    }
+    EXPECT_EQ(written, read);
+    EXPECT_EQ(0u, reader->dropped());
+}
+
+// Un lector que se queda atrás pierde los más antiguos y lo cuenta
+TEST(ShmRing, SlowReaderDropsOldest)
+{
+    const std::string name = testSegment("slow");
+    std::unique_ptr<ShmRing> writer = ShmRing::create(name, 4);
+    std::unique_ptr<ShmRing> reader = ShmRing::open(name);
+    ASSERT_TRUE(reader);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        writer->write(makeRecord(i));
+    }
+    ShmRing::Record record;
+    ASSERT_TRUE(reader->next(record));
+    EXPECT_DOUBLE_EQ(6.0, record.values[0]);
+    EXPECT_EQ(6u, reader->dropped());
+    for (int i = 7; i < 10; ++i)
+    {
+        ASSERT_TRUE(reader->next(record));
+        EXPECT_DOUBLE_EQ(i, record.values[0]);
+    }
+    EXPECT_FALSE(reader->next(record));
+}
+
+TEST(ShmRing, WaitTimesOutWithoutRecords)
+{
+    const std::string name = testSegment("wait");
+    std::unique_ptr<ShmRing> writer = ShmRing::create(name, 4);
+    std::unique_ptr<ShmRing> reader = ShmRing::open(name);
+    ASSERT_TRUE(reader);
+
+    EXPECT_FALSE(reader->wait(0.01));
+    writer->write(makeRecord(1.0));
+    EXPECT_TRUE(reader->wait(0.01));
+}
+
+// Un segundo escritor no le quita el nombre a uno que sigue vivo
+TEST(ShmRing, CreateRefusesLiveWriter)
+{
+    const std::string name = testSegment("owner");
+    std::unique_ptr<ShmRing> writer = ShmRing::create(name, 4, "/commander");
+    EXPECT_THROW(ShmRing::create(name, 4, "/otro"), std::runtime_error);
+
+    std::unique_ptr<ShmRing> reader = ShmRing::open(name);
+    ASSERT_TRUE(reader);
+    EXPECT_EQ("/commander", reader->owner());
+    writer->write(makeRecord(5.0));
+    ShmRing::Record record;
+    ASSERT_TRUE(reader->next(record));
+    EXPECT_DOUBLE_EQ(5.0, record.values[0]);
+
+    // Terminado el primero, el nombre se puede volver a crear
+    writer.reset();
+    writer = ShmRing::create(name, 4, "/otro");
+    EXPECT_EQ("/otro", ShmRing::open(name)->owner());
+}
+
+// El segmento de un escritor que murió sin borrarlo se sustituye
+TEST(ShmRing, CreateReplacesDeadWriter)
+{
+    const std::string name = testSegment("dead");
+    const pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0)
+    {
+        ShmRing::create(name, 4, "/muerto").release();
+        ::_exit(0);
+    }
+    int status = 0;
+    ASSERT_EQ(child, ::waitpid(child, &status, 0));
+
+    std::unique_ptr<ShmRing> writer = ShmRing::create(name, 4, "/vivo");
+    EXPECT_EQ("/vivo", ShmRing::open(name)->owner());
+}
+
+// Al destruir el escritor el nombre desaparece; el lector conserva su mapeo
+TEST(ShmRing, WriterUnlinksOnDestruction)
+{
+    const std::string name = testSegment("unlink");
+    std::unique_ptr<ShmRing> writer = ShmRing::create(name, 4);
+    std::unique_ptr<ShmRing> reader = ShmRing::open(name);
+    ASSERT_TRUE(reader);
+    writer->write(makeRecord(3.0));
+    writer.reset();
+
+    EXPECT_FALSE(ShmRing::open(name));
+    ShmRing::Record record;
+    ASSERT_TRUE(reader->next(record));
+    EXPECT_DOUBLE_EQ(3.0, record.values[0]);
+}
+
+#endif
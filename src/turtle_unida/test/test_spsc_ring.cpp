@@ -0,0 +1,156 @@
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "turtle_unida/latest_slot.h"
+#include "turtle_unida/spsc_ring.h"
+
+using namespace turtle_unida;
+
+TEST(SpscRing, CapacityRoundsToPowerOfTwo)
+{
+    EXPECT_THROW(SpscRing<int>(0), std::invalid_argument);
+    EXPECT_EQ(1u, SpscRing<int>(1).capacity());
+    EXPECT_EQ(4u, SpscRing<int>(3).capacity());
+    EXPECT_EQ(64u, SpscRing<int>(64).capacity());
+}
+
+TEST(SpscRing, FullAndEmpty)
+{
+    SpscRing<int> ring(4);
+    int value = 0;
+    EXPECT_FALSE(ring.tryPop(value));
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(ring.tryPush(i));
+    }
+    EXPECT_FALSE(ring.tryPush(4));
+    EXPECT_EQ(4u, ring.size());
+
+    ASSERT_TRUE(ring.tryPop(value));
+    EXPECT_EQ(0, value);
+    EXPECT_TRUE(ring.tryPush(4));
+    EXPECT_FALSE(ring.tryPush(5));
+}
+
+// Los índices crecen sin límite y se enmascaran: muchas vueltas mantienen el orden
+TEST(SpscRing, WrapsAroundInOrder)
+{
+    SpscRing<int> ring(4);
+    int next_push = 0;
+    int next_pop = 0;
+    for (int round = 0; round < 1000; ++round)
+    {
+        // Llenados parciales para que el principio de la cola recorra todos los huecos
+        const int burst = 1 + round % 4;
+        for (int i = 0; i < burst; ++i)
+        {
+            ASSERT_TRUE(ring.tryPush(next_push++));
+        }
+        int value = -1;
+        while (ring.tryPop(value))
+        {
+            ASSERT_EQ(next_pop++, value);
+        }
+        ASSERT_EQ(0u, ring.size());
+    }
+    EXPECT_EQ(next_push, next_pop);
+}
+
+TEST(SpscRing, TwoThreadsKeepOrder)
+{
+    SpscRing<long> ring(8);
+    const long n = 200000;
+    std::thread producer([&ring, n]() {
+        for (long i = 0; i < n; ++i)
+        {
+            while (!ring.tryPush(i))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    long expected = 0;
+    long value = 0;
+    while (expected < n)
+    {
+        if (ring.tryPop(value))
+        {
+            ASSERT_EQ(expected, value);
+            ++expected;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_FALSE(ring.tryPop(value));
+}
+
+TEST(LatestSlot, NewestWins)
+{
+    LatestSlot<int> slot;
+    int value = 0;
+    EXPECT_FALSE(slot.take(value));
+
+    EXPECT_FALSE(slot.publish(1));
+    ASSERT_TRUE(slot.take(value));
+    EXPECT_EQ(1, value);
+    EXPECT_FALSE(slot.take(value));
+
+    // Sin leer, cada valor sustituye al anterior y se cuenta como descartado
+    EXPECT_FALSE(slot.publish(2));
+    EXPECT_TRUE(slot.publish(3));
+    EXPECT_TRUE(slot.publish(4));
+    ASSERT_TRUE(slot.take(value));
+    EXPECT_EQ(4, value);
+    EXPECT_FALSE(slot.take(value));
+}
+
+// El consumidor ve valores cada vez más nuevos, nunca uno a medio escribir,
+// y cada valor se lee o se cuenta como descartado exactamente una vez
+TEST(LatestSlot, TwoThreadsSeeIncreasingValues)
+{
+    struct Pair
+    {
+        long a;
+        long b;
+    };
+    LatestSlot<Pair> slot;
+    const long n = 200000;
+    long dropped = 0;
+    std::thread producer([&slot, &dropped, n]() {
+        for (long i = 1; i <= n; ++i)
+        {
+            const Pair pair = {i, -i};
+            if (slot.publish(pair))
+            {
+                ++dropped;
+            }
+        }
+    });
+
+    long last = 0;
+    long taken = 0;
+    Pair pair;
+    while (last < n)
+    {
+        if (slot.take(pair))
+        {
+            ASSERT_GT(pair.a, last);
+            ASSERT_EQ(-pair.a, pair.b);
+            last = pair.a;
+            ++taken;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_EQ(n, taken + dropped);
+}
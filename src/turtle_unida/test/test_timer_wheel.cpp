@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "turtle_unida/timer_wheel.h"
+
+using namespace turtle_unida;
+
+// Con resolución 1 los instantes son directamente pasos de la rueda
+TEST(TimerWheel, OneShotsFireInOrder)
+{
+    TimerWheel wheel(1.0);
+    std::vector<std::pair<int, double> > fired;
+    for (int deadline : {3, 1, 2})
+    {
+        wheel.add(deadline, 0.0, [&wheel, &fired, deadline]() { fired.push_back(std::make_pair(deadline, wheel.now())); });
+    }
+    EXPECT_EQ(3u, wheel.size());
+    EXPECT_DOUBLE_EQ(1.0, wheel.nextExpiry());
+
+    wheel.advance(0.5);
+    EXPECT_TRUE(fired.empty());
+    wheel.advance(5.0);
+    ASSERT_EQ(3u, fired.size());
+    for (int i = 0; i < 3; ++i)
+    {
+        EXPECT_EQ(i + 1, fired[i].first);
+        EXPECT_DOUBLE_EQ(i + 1, fired[i].second);
+    }
+    EXPECT_EQ(0u, wheel.size());
+    EXPECT_TRUE(std::isinf(wheel.nextExpiry()));
+    EXPECT_EQ(3u, wheel.stats().expired);
+}
+
+// Los vencimientos ya pasados vencen en el siguiente paso, nunca antes
+TEST(TimerWheel, PastDeadlineFiresOnNextStep)
+{
+    TimerWheel wheel(1.0);
+    wheel.advance(10.0);
+    double fired_at = -1.0;
+    wheel.add(2.0, 0.0, [&wheel, &fired_at]() { fired_at = wheel.now(); });
+    wheel.advance(10.0);
+    EXPECT_LT(fired_at, 0.0);
+    wheel.advance(11.0);
+    EXPECT_DOUBLE_EQ(11.0, fired_at);
+}
+
+TEST(TimerWheel, PeriodicUntilCancelled)
+{
+    TimerWheel wheel(1.0);
+    std::vector<double> fired;
+    const TimerId id = wheel.add(2.0, 3.0, [&wheel, &fired]() { fired.push_back(wheel.now()); });
+    wheel.advance(11.0);
+    EXPECT_EQ((std::vector<double>{2.0, 5.0, 8.0, 11.0}), fired);
+    EXPECT_DOUBLE_EQ(14.0, wheel.nextExpiry());
+
+    EXPECT_TRUE(wheel.cancel(id));
+    EXPECT_FALSE(wheel.cancel(id));
+    wheel.advance(100.0);
+    EXPECT_EQ(4u, fired.size());
+    EXPECT_EQ(0u, wheel.size());
+}
+
+TEST(TimerWheel, CancelBeforeExpiry)
+{
+    TimerWheel wheel(1.0);
+    int fired = 0;
+    const TimerId id = wheel.add(5.0, 0.0, [&fired]() { ++fired; });
+    EXPECT_TRUE(wheel.cancel(id));
+    EXPECT_EQ(0u, wheel.size());
+    wheel.advance(10.0);
+    EXPECT_EQ(0, fired);
+    EXPECT_EQ(1u, wheel.stats().cancelled);
+}
+
+// Un identificador viejo no cancela al temporizador que reutiliza su hueco
+TEST(TimerWheel, StaleIdDoesNotCancelReusedSlot)
+{
+    TimerWheel wheel(1.0);
+    int fired = 0;
+    const TimerId old_id = wheel.add(1.0, 0.0, []() {});
+    wheel.advance(1.0);
+    EXPECT_FALSE(wheel.cancel(old_id));
+
+    const TimerId new_id = wheel.add(5.0, 0.0, [&fired]() { ++fired; });
+    EXPECT_NE(old_id, new_id);
+    EXPECT_FALSE(wheel.cancel(old_id));
+    wheel.advance(5.0);
+    EXPECT_EQ(1, fired);
+    EXPECT_FALSE(wheel.cancel(0));
+}
+
+TEST(TimerWheel, CallbacksCanCancelAndAdd)
+{
+    TimerWheel wheel(1.0);
+    int self = 0;
+    TimerId id = 0;
+    id = wheel.add(1.0, 1.0, [&wheel, &self, &id]() {
+        ++self;
+        EXPECT_TRUE(wheel.cancel(id));
+    });
+
+    std::vector<double> chained;
+    wheel.add(2.0, 0.0, [&wheel, &chained]() {
+        chained.push_back(wheel.now());
+        wheel.add(wheel.now() + 3.0, 0.0, [&wheel, &chained]() { chained.push_back(wheel.now()); });
+    });
+
+    wheel.advance(10.0);
+    EXPECT_EQ(1, self);
+    EXPECT_EQ((std::vector<double>{2.0, 5.0}), chained);
+    EXPECT_EQ(0u, wheel.size());
+}
+
+// Vencimientos en todos los niveles y en la lista de desbordamiento: bajan
+// de nivel y vencen exactamente en su paso aunque se avance a saltos
+TEST(TimerWheel, CascadeKeepsExactDeadlines)
+{
+    TimerWheel wheel(1.0);
+    std::vector<std::uint64_t> deadlines = {1, 255, 256, 257, 65535, 65536, 70000, 16777216, 16777217,
+        4294967295ull, 4294967296ull, 8589934593ull};
+    std::uint64_t seed = 12345;
+    for (int i = 0; i < 2000; ++i)
+    {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        deadlines.push_back(1 + (seed >> 38));  // hasta 2^26
+    }
+
+    std::vector<std::pair<std::uint64_t, double> > fired;
+    for (std::uint64_t deadline : deadlines)
+    {
+        wheel.add(static_cast<double>(deadline), 0.0,
+            [&wheel, &fired, deadline]() { fired.push_back(std::make_pair(deadline, wheel.now())); });
+    }
+
+    // A saltos de tamaño variable; en la mitad, justo hasta el paso anterior
+    // al siguiente vencimiento
+    std::uint64_t jump = 1;
+    while (wheel.size() > 0)
+    {
+        jump = jump * 3 % 1000003 + 1;
+        double target = wheel.now() + static_cast<double>(jump);
+        const double next = wheel.nextExpiry();
+        if (jump % 2 == 0 && next - 1.0 > wheel.now())
+        {
+            target = std::min(target, next - 1.0);
+        }
+        wheel.advance(target);
+    }
+
+    ASSERT_EQ(deadlines.size(), fired.size());
+    for (std::size_t i = 0; i < fired.size(); ++i)
+    {
+        EXPECT_DOUBLE_EQ(static_cast<double>(fired[i].first), fired[i].second);
+        if (i > 0)
+        {
+            EXPECT_LE(fired[i - 1].first, fired[i].first);
+        }
+    }
+    EXPECT_GT(wheel.stats().cascaded, 0u);
+}
+
+TEST(TimerWheel, InvalidArguments)
+{
+    EXPECT_THROW(TimerWheel(0.0), std::invalid_argument);
+    TimerWheel wheel(1.0);
+    EXPECT_THROW(wheel.add(1.0, 0.0, TimerWheel::Callback()), std::invalid_argument);
+    EXPECT_THROW(wheel.add(1.0, -1.0, []() {}), std::invalid_argument);
+}
+
+TEST(TimerService, FiresAndCancels)
+{
+    TimerService service;
+    std::atomic<int> once(0);
+    std::atomic<int> cancelled(0);
+    service.after(0.005, [&once]() { ++once; });
+    const TimerId id = service.after(0.5, [&cancelled]() { ++cancelled; });
+    EXPECT_TRUE(service.cancel(id));
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (once.load() == 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(1, once.load());
+    EXPECT_EQ(0, cancelled.load());
+    EXPECT_EQ(0u, service.size());
+}
@@ -0,0 +1,55 @@
+#include <cmath>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "turtle_unida/trajectory.h"
+
+using namespace turtle_unida;
+
+namespace
+{
+
+TrajectoryParams spiral(double size, double growth, double duration)
+{
+    TrajectoryParams params;
+    params.type = "spiral";
+    params.size = size;
+    params.growth = growth;
+    params.duration = duration;
+    return params;
+}
+
+} // namespace
+
+// Con velocidad lineal constante la velocidad angular es v / r(t)
+TEST(Trajectory, SpiralFollowsRadius)
+{
+    const Trajectory trajectory = makeTrajectory(spiral(2.0, 0.1, 20.0));
+    for (double t = 0.0; t < 20.0; t += 0.5)
+    {
+        const Twist twist = trajectory.sample(t);
+        EXPECT_NEAR(2.0, twist.linear.x, 1e-6);
+        EXPECT_NEAR(2.0 / (2.0 + 0.1 * t), twist.angular.z, 1e-3);
+    }
+}
+
+// Una espiral que se cierra sigue siendo válida mientras el radio no llegue a cero
+TEST(Trajectory, ShrinkingSpiralStaysFinite)
+{
+    const Trajectory trajectory = makeTrajectory(spiral(2.0, -0.05, 20.0));
+    for (double t = 0.0; t <= 20.0; t += 0.25)
+    {
+        const Twist twist = trajectory.sample(t);
+        ASSERT_TRUE(std::isfinite(twist.linear.x));
+        ASSERT_TRUE(std::isfinite(twist.angular.z));
+    }
+    EXPECT_NEAR(2.0, trajectory.sample(19.9).angular.z, 0.05);
+}
+
+TEST(Trajectory, SpiralCollapsingToAPointThrows)
+{
+    EXPECT_THROW(makeTrajectory(spiral(2.0, -0.1, 20.0)), std::invalid_argument);
+    EXPECT_THROW(makeTrajectory(spiral(2.0, -0.2, 20.0)), std::invalid_argument);
+    EXPECT_THROW(makeTrajectory(spiral(0.0, 0.1, 20.0)), std::invalid_argument);
+}